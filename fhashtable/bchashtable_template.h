@@ -0,0 +1,824 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file bchashtable_template.h
+ * @brief Fixed-size bucketized cuckoo hashtable
+ *
+ * Each key has two candidate buckets of 4 slots, so a lookup touches at most
+ * two buckets regardless of the load factor. Each slot has an 8-bit tag taken
+ * from the key hash, which is compared before the key. The second bucket is
+ * derived from the first bucket and the tag (partial-key cuckoo hashing), so
+ * keys can be moved to their other bucket without being hashed again.
+ *
+ * Inserting into two full buckets searches breadth-first for a short path of
+ * keys to move to their other bucket, ending at a bucket with a free slot.
+ *
+ * The hashtable can fill up before every slot is used: inserting fails when
+ * no such path is found, which is typical at load factors around 95%.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * The following macros must be defined in the implementation:
+ *      @li `KEY_IS_EQUAL(a,b)`
+ *      @li `HASH_FUNCTION(key)`
+ *
+ * Source(s) used:
+ *  @li https://www.cs.cmu.edu/~dga/papers/cuckoo-eurosys14.pdf
+ *  @li https://www.cs.cmu.edu/~binfan/papers/conext14_cuckoofilter.pdf
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @brief Macro to check if a number is a power of two.
+ *
+ * @param[in] X             The number at hand.
+ *
+ * @return                  A boolean value indicating whether the number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def BCHASHTABLE_BUCKET_SIZE
+ * @brief Number of slots in a bucket.
+ */
+#ifndef BCHASHTABLE_BUCKET_SIZE
+#define BCHASHTABLE_BUCKET_SIZE (4)
+#endif
+
+/**
+ * @def BCHASHTABLE_EMPTY_TAG
+ * @brief Tag constant used to flag empty slots. Keys never have this tag.
+ */
+#ifndef BCHASHTABLE_EMPTY_TAG
+#define BCHASHTABLE_EMPTY_TAG (0)
+#endif
+
+/**
+ * @def BCHASHTABLE_MAX_SEARCHED_BUCKETS
+ * @brief Maximum number of buckets visited by the breadth-first search for a
+ *        free slot, when inserting into two full buckets.
+ */
+#ifndef BCHASHTABLE_MAX_SEARCHED_BUCKETS
+#define BCHASHTABLE_MAX_SEARCHED_BUCKETS (512)
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#ifndef BCHASHTABLE_SLOT_FIELD
+#define BCHASHTABLE_SLOT_FIELD(self, index, field) \
+    ((self)->buckets[(index) / BCHASHTABLE_BUCKET_SIZE].field[(index) % BCHASHTABLE_BUCKET_SIZE])
+#endif
+/// @endcond
+
+/**
+ * @def BCHASHTABLE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots in the hashtable in arbitary order.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef BCHASHTABLE_FOR_EACH
+#define BCHASHTABLE_FOR_EACH(self, index, key_, value_)                        \
+    for ((index) = 0; (index) < (self)->capacity; (index)++)                   \
+        if (BCHASHTABLE_SLOT_FIELD(self, index, tags) != BCHASHTABLE_EMPTY_TAG \
+            && ((key_) = BCHASHTABLE_SLOT_FIELD(self, index, keys),            \
+                (value_) = BCHASHTABLE_SLOT_FIELD(self, index, values), true))
+#endif
+
+/**
+ * @def BCHASHTABLE_CALC_SIZEOF(bchashtable_name, capacity)
+ *
+ * @brief Calculate the size of the hashtable struct. No overflow checks.
+ *
+ * @param[in] bchashtable_name  Defined hashtable NAME.
+ * @param[in] capacity          Capacity input. A multiple of `BCHASHTABLE_BUCKET_SIZE`.
+ *
+ * @return                      The equivalent size.
+ */
+#ifndef BCHASHTABLE_CALC_SIZEOF
+#define BCHASHTABLE_CALC_SIZEOF(bchashtable_name, capacity) \
+    (uint32_t)(offsetof(struct bchashtable_name, buckets)   \
+               + (capacity) / BCHASHTABLE_BUCKET_SIZE * sizeof(((struct bchashtable_name *)0)->buckets[0]))
+#endif
+
+/**
+ * @def BCHASHTABLE_CALC_SIZEOF_OVERFLOWS(bchashtable_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the hashtable struct overflows.
+ *
+ * @param[in] bchashtable_name  Defined hashtable NAME.
+ * @param[in] capacity          Capacity input. A multiple of `BCHASHTABLE_BUCKET_SIZE`.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#ifndef BCHASHTABLE_CALC_SIZEOF_OVERFLOWS
+#define BCHASHTABLE_CALC_SIZEOF_OVERFLOWS(bchashtable_name, capacity) \
+    ((capacity) / BCHASHTABLE_BUCKET_SIZE                             \
+     > (UINT32_MAX - offsetof(struct bchashtable_name, buckets))      \
+           / sizeof(((struct bchashtable_name *)0)->buckets[0]))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define BCHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define BCHASHTABLE_TYPE        struct BCHASHTABLE_NAME
+#define BCHASHTABLE_BUCKET_TYPE struct JOIN(BCHASHTABLE_NAME, bucket)
+#define BCHASHTABLE_INIT        JOIN(BCHASHTABLE_NAME, init)
+#define BCHASHTABLE_FIND        JOIN(internal, JOIN(BCHASHTABLE_NAME, find))
+#define BCHASHTABLE_TAG_OF      JOIN(internal, JOIN(BCHASHTABLE_NAME, tag_of))
+#define BCHASHTABLE_OTHER       JOIN(internal, JOIN(BCHASHTABLE_NAME, other_bucket))
+#define BCHASHTABLE_FREE_SLOT   JOIN(internal, JOIN(BCHASHTABLE_NAME, free_slot))
+#define BCHASHTABLE_INSERT_HASH JOIN(internal, JOIN(BCHASHTABLE_NAME, insert_hash))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(BCHASHTABLE_NAME, bucket);
+struct BCHASHTABLE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated hashtable bucket struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct JOIN(BCHASHTABLE_NAME, bucket) {
+    uint8_t tags[BCHASHTABLE_BUCKET_SIZE];      ///< Tags of the slots, or `BCHASHTABLE_EMPTY_TAG`.
+    KEY_TYPE keys[BCHASHTABLE_BUCKET_SIZE];     ///< Keys of the slots.
+    VALUE_TYPE values[BCHASHTABLE_BUCKET_SIZE]; ///< Values of the slots.
+};
+
+/**
+ * @brief Generated hashtable struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct BCHASHTABLE_NAME {
+    uint32_t count;                    ///< Number of non-empty slots.
+    uint32_t capacity;                 ///< Number of slots.
+    BCHASHTABLE_BUCKET_TYPE buckets[]; ///< Array of `capacity / BCHASHTABLE_BUCKET_SIZE` buckets.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Initialize a hashtable struct, given a (power-of-2) capacity.
+ *
+ * @param[in] self              Hashtable pointer
+ * @param[in] pow2_capacity     Power of 2 capacity. At least `BCHASHTABLE_BUCKET_SIZE`.
+ */
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *JOIN(BCHASHTABLE_NAME, init)(BCHASHTABLE_TYPE *self, const uint32_t pow2_capacity);
+
+/**
+ * @brief Create an hashtable with a given capacity with a custom allocator.
+ *
+ * The capacity is rounded up to a power of 2, and to at least
+ * `BCHASHTABLE_BUCKET_SIZE`.
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent
+ *                              size overflows.
+ */
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *
+    JOIN(BCHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                          void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
+
+/**
+ * @brief Create an hashtable with a given capacity with malloc().
+ *
+ * The capacity is rounded up to a power of 2, and to at least
+ * `BCHASHTABLE_BUCKET_SIZE`.
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent
+ *                              size overflows.
+ */
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *JOIN(BCHASHTABLE_NAME, create)(const uint32_t min_capacity);
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        a custom allocator.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, destroy_custom)(BCHASHTABLE_TYPE *self, void *context_ptr,
+                                                             void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, destroy)(BCHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether the hashtable is empty.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, is_empty)(const BCHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether every slot of the hashtable is used.
+ *
+ * @note Inserting may fail before the hashtable is full.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, is_full)(const BCHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, contains_key)(const BCHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the pointer to the corresponding value in the
+ *        hashtable.
+ *
+ * @note The returned pointer is **not** garanteed to point to the same value if
+ *       the hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding key.
+ *  @retval NULL                If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(BCHASHTABLE_NAME, get_value_mut)(BCHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the copy of the corresponding value in the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding key.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE JOIN(BCHASHTABLE_NAME, get_value)(const BCHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                              VALUE_TYPE default_value);
+
+/**
+ * @brief Insert a non-duplicate key and it's corresponding value inside the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      A boolean indicating whether the key was inserted.
+ * @retval false                If no free slot was found for the key. The hashtable is left unchanged.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, insert)(BCHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Update a key's corresponding value inside the hashtable. Allows
+ *        duplicates.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      A boolean indicating whether the key is in the hashtable with the value.
+ * @retval false                If the key was not contained and no free slot was found for it.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, update)(BCHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Delete a key and it's corresponding value from the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashtable.
+ */
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, delete)(BCHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashtable and flag all slots as empty.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ */
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, clear)(BCHASHTABLE_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "round_up_pow2_32.h" // round_up_pow2_32
+
+/**
+ * @def KEY_IS_EQUAL(a, b)
+ * @brief Used to compare two keys This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @attention
+ *   @li If comparing two scalar values, set this macro to ((a) == (b)).
+ *   @li If comparing two strings, set this macro to strcmp() or strncmp()
+ *       appropiately.
+ *   @li If comparing two structs, set this macro to a function that does
+ *       element-wise comparison between the structs.
+ *
+ * @retval true If the two keys are equal. Equivalent to a non-zero int.
+ * @retval false If the two key are not equal. Equivalent to the int 0.
+ */
+#ifndef KEY_IS_EQUAL
+#error "Must define KEY_IS_EQUAL."
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute indicies of keys. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key.
+ * @return The hash of the key as `uint32_t`. The low bits select the first
+ *         bucket, and the top 8 bits are the tag.
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *JOIN(BCHASHTABLE_NAME, init)(BCHASHTABLE_TYPE *self, const uint32_t pow2_capacity)
+{
+    assert(self);
+    assert(IS_POW2(pow2_capacity));
+    assert(pow2_capacity >= BCHASHTABLE_BUCKET_SIZE);
+
+    self->count = 0;
+    self->capacity = pow2_capacity;
+
+    for (uint32_t b = 0; b < self->capacity / BCHASHTABLE_BUCKET_SIZE; b++) {
+        memset(self->buckets[b].tags, BCHASHTABLE_EMPTY_TAG, sizeof(self->buckets[b].tags));
+    }
+
+    return self;
+}
+
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *
+    JOIN(BCHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                          void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    uint32_t capacity = round_up_pow2_32(min_capacity);
+
+    if (capacity < BCHASHTABLE_BUCKET_SIZE) {
+        capacity = BCHASHTABLE_BUCKET_SIZE;
+    }
+
+    if (BCHASHTABLE_CALC_SIZEOF_OVERFLOWS(BCHASHTABLE_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = BCHASHTABLE_CALC_SIZEOF(BCHASHTABLE_NAME, capacity);
+
+    BCHASHTABLE_TYPE *self = (BCHASHTABLE_TYPE *)allocate(context_ptr, alignof(BCHASHTABLE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    memset(self, 0, size);
+    BCHASHTABLE_INIT(self, capacity);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(BCHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+/// @endcond
+
+FUNCTION_LINKAGE BCHASHTABLE_TYPE *JOIN(BCHASHTABLE_NAME, create)(const uint32_t capacity)
+{
+    return JOIN(BCHASHTABLE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(BCHASHTABLE_NAME, allocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, destroy_custom)(BCHASHTABLE_TYPE *self, void *context_ptr,
+                                                             void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(BCHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, destroy)(BCHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(BCHASHTABLE_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(BCHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, is_empty)(const BCHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, is_full)(const BCHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline uint8_t JOIN(internal, JOIN(BCHASHTABLE_NAME, tag_of))(const uint32_t key_hash)
+{
+    const uint8_t tag = (uint8_t)(key_hash >> 24);
+
+    return tag == BCHASHTABLE_EMPTY_TAG ? 1 : tag;
+}
+
+// The other bucket of a key in a given bucket. Applying it twice gives the bucket back.
+static inline uint32_t JOIN(internal, JOIN(BCHASHTABLE_NAME, other_bucket))(const uint32_t bucket_mask,
+                                                                             const uint32_t bucket, const uint8_t tag)
+{
+    return (bucket ^ (tag * UINT32_C(0x5bd1e995))) & bucket_mask;
+}
+
+// Find the bucket and slot of a key. Returns false if it's not contained.
+static inline bool JOIN(internal, JOIN(BCHASHTABLE_NAME, find))(const BCHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                                 uint32_t *bucket_ptr, uint32_t *slot_ptr)
+{
+    const uint32_t key_hash = HASH_FUNCTION(key);
+    const uint32_t bucket_mask = self->capacity / BCHASHTABLE_BUCKET_SIZE - 1;
+    const uint8_t tag = BCHASHTABLE_TAG_OF(key_hash);
+
+    const uint32_t buckets[2] = {key_hash & bucket_mask, BCHASHTABLE_OTHER(bucket_mask, key_hash & bucket_mask, tag)};
+
+    for (uint32_t i = 0; i < 2; i++) {
+        const BCHASHTABLE_BUCKET_TYPE *bucket_ptr_ = &self->buckets[buckets[i]];
+
+        for (uint32_t s = 0; s < BCHASHTABLE_BUCKET_SIZE; s++) {
+            if (bucket_ptr_->tags[s] == tag && KEY_IS_EQUAL(bucket_ptr_->keys[s], key)) {
+                *bucket_ptr = buckets[i];
+                *slot_ptr = s;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Get a free slot of a bucket, or BCHASHTABLE_BUCKET_SIZE if there is none.
+static inline uint32_t JOIN(internal, JOIN(BCHASHTABLE_NAME, free_slot))(const BCHASHTABLE_TYPE *self,
+                                                                          const uint32_t bucket)
+{
+    for (uint32_t s = 0; s < BCHASHTABLE_BUCKET_SIZE; s++) {
+        if (self->buckets[bucket].tags[s] == BCHASHTABLE_EMPTY_TAG) {
+            return s;
+        }
+    }
+    return BCHASHTABLE_BUCKET_SIZE;
+}
+
+static inline bool JOIN(internal, JOIN(BCHASHTABLE_NAME, insert_hash))(BCHASHTABLE_TYPE *self,
+                                                                        const uint32_t key_hash, KEY_TYPE key,
+                                                                        VALUE_TYPE value)
+{
+    const uint32_t bucket_mask = self->capacity / BCHASHTABLE_BUCKET_SIZE - 1;
+    const uint8_t tag = BCHASHTABLE_TAG_OF(key_hash);
+
+    // breadth-first search from both buckets. each visited bucket is reached by moving the key in a slot of the
+    // previous bucket on the path to it:
+    struct {
+        uint32_t bucket;
+        int32_t prev;
+        uint32_t prev_slot;
+    } visited[BCHASHTABLE_MAX_SEARCHED_BUCKETS];
+
+    visited[0].bucket = key_hash & bucket_mask;
+    visited[0].prev = -1;
+    visited[0].prev_slot = 0;
+    visited[1].bucket = BCHASHTABLE_OTHER(bucket_mask, visited[0].bucket, tag);
+    visited[1].prev = -1;
+    visited[1].prev_slot = 0;
+
+    int32_t n_visited = 2;
+    int32_t found = -1;
+    uint32_t free_slot = BCHASHTABLE_BUCKET_SIZE;
+
+    for (int32_t i = 0; i < n_visited; i++) {
+        free_slot = BCHASHTABLE_FREE_SLOT(self, visited[i].bucket);
+
+        if (free_slot != BCHASHTABLE_BUCKET_SIZE) {
+            found = i;
+            break;
+        }
+        for (uint32_t s = 0; s < BCHASHTABLE_BUCKET_SIZE && n_visited < BCHASHTABLE_MAX_SEARCHED_BUCKETS; s++) {
+            const uint32_t next_bucket =
+                BCHASHTABLE_OTHER(bucket_mask, visited[i].bucket, self->buckets[visited[i].bucket].tags[s]);
+
+            // a bucket may be on a path once, so the keys moved are the keys that were searched:
+            bool is_on_path = false;
+            for (int32_t j = i; j != -1; j = visited[j].prev) {
+                is_on_path |= visited[j].bucket == next_bucket;
+            }
+            if (is_on_path) {
+                continue;
+            }
+
+            visited[n_visited].bucket = next_bucket;
+            visited[n_visited].prev = i;
+            visited[n_visited].prev_slot = s;
+            n_visited++;
+        }
+    }
+
+    if (found == -1) {
+        return false;
+    }
+
+    // move the keys along the path, starting from the free slot:
+    int32_t i = found;
+    for (; visited[i].prev != -1; i = visited[i].prev) {
+        BCHASHTABLE_BUCKET_TYPE *dest_ptr = &self->buckets[visited[i].bucket];
+        const BCHASHTABLE_BUCKET_TYPE *src_ptr = &self->buckets[visited[visited[i].prev].bucket];
+        const uint32_t src_slot = visited[i].prev_slot;
+
+        dest_ptr->tags[free_slot] = src_ptr->tags[src_slot];
+        dest_ptr->keys[free_slot] = src_ptr->keys[src_slot];
+        dest_ptr->values[free_slot] = src_ptr->values[src_slot];
+        free_slot = src_slot;
+    }
+
+    BCHASHTABLE_BUCKET_TYPE *bucket_ptr = &self->buckets[visited[i].bucket];
+    bucket_ptr->tags[free_slot] = tag;
+    bucket_ptr->keys[free_slot] = key;
+    bucket_ptr->values[free_slot] = value;
+    self->count++;
+
+    return true;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, contains_key)(const BCHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t bucket, slot;
+
+    return BCHASHTABLE_FIND(self, key, &bucket, &slot);
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(BCHASHTABLE_NAME, get_value_mut)(BCHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t bucket, slot;
+
+    return BCHASHTABLE_FIND(self, key, &bucket, &slot) ? &self->buckets[bucket].values[slot] : NULL;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE JOIN(BCHASHTABLE_NAME, get_value)(const BCHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                              VALUE_TYPE default_value)
+{
+    assert(self != NULL);
+
+    uint32_t bucket, slot;
+
+    return BCHASHTABLE_FIND(self, key, &bucket, &slot) ? self->buckets[bucket].values[slot] : default_value;
+}
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, insert)(BCHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+    assert(!JOIN(BCHASHTABLE_NAME, contains_key)(self, key));
+
+    return BCHASHTABLE_INSERT_HASH(self, HASH_FUNCTION(key), key, value);
+}
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, update)(BCHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    uint32_t bucket, slot;
+
+    if (BCHASHTABLE_FIND(self, key, &bucket, &slot)) {
+        self->buckets[bucket].values[slot] = value;
+        return true;
+    }
+    return BCHASHTABLE_INSERT_HASH(self, HASH_FUNCTION(key), key, value);
+}
+
+FUNCTION_LINKAGE bool JOIN(BCHASHTABLE_NAME, delete)(BCHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t bucket, slot;
+
+    if (!BCHASHTABLE_FIND(self, key, &bucket, &slot)) {
+        return false;
+    }
+    self->buckets[bucket].tags[slot] = BCHASHTABLE_EMPTY_TAG;
+    self->count--;
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(BCHASHTABLE_NAME, clear)(BCHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    for (uint32_t b = 0; b < self->capacity / BCHASHTABLE_BUCKET_SIZE; b++) {
+        memset(self->buckets[b].tags, BCHASHTABLE_EMPTY_TAG, sizeof(self->buckets[b].tags));
+    }
+    self->count = 0;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef KEY_IS_EQUAL
+#undef HASH_FUNCTION
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef BCHASHTABLE_NAME
+#undef BCHASHTABLE_TYPE
+#undef BCHASHTABLE_BUCKET_TYPE
+#undef BCHASHTABLE_INIT
+#undef BCHASHTABLE_FIND
+#undef BCHASHTABLE_TAG_OF
+#undef BCHASHTABLE_OTHER
+#undef BCHASHTABLE_FREE_SLOT
+#undef BCHASHTABLE_INSERT_HASH
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,741 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file chashtable_template.h
+ * @brief Lock-striped concurrent hashtable (built on fhashtable)
+ *
+ * Keys are spread over a power-of-two number of shards by the upper bits of
+ * their hash. Each shard is an instance of an `fhashtable_template.h`
+ * instantiation behind it's own readers-writer lock, which sits on it's own
+ * cache line. Lookups take the lock shared, so readers of a shard only block
+ * on writers of the same shard. Threads working on different shards do not
+ * touch the same cache lines.
+ *
+ * A shard doubles it's capacity once it's load exceeds 75%, by copying it's
+ * table into a new one under the write lock.
+ *
+ * Every shard counts it's lock acquisitions, and how many of them had to wait
+ * for another thread. See `get_shard_stats()`.
+ *
+ * The underlying `fhashtable_template.h` instantiation must be defined
+ * beforehand with the same `KEY_TYPE` and `VALUE_TYPE`. `HASH_FUNCTION` must
+ * be the hash function given to it. Only the lower 32 bits of the hash are
+ * used for sharding. They are multiplied by a constant before the upper bits
+ * are taken, so the shard does not fix the bits used by the tables for
+ * indexing, control bytes or fingerprints.
+ *
+ * Creation, destruction and the allocator are not thread-safe. All other
+ * operations may be called concurrently.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `TABLE_NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *      @li `HASH_FUNCTION`
+ *
+ * Source(s) used:
+ *  @li https://en.wikipedia.org/wiki/Lock_(computer_science)#Granularity
+ *  @li https://en.wikipedia.org/wiki/Hash_function#Fibonacci_hashing
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def IS_POW2(X)
+ * @brief Check if a number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def CHASHTABLE_CACHE_LINE_SIZE
+ * @brief Alignment of each shard, so no two shard locks share a cache line.
+ */
+#ifndef CHASHTABLE_CACHE_LINE_SIZE
+#define CHASHTABLE_CACHE_LINE_SIZE (64)
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define CHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def TABLE_NAME
+ * @brief Name of the `fhashtable_template.h` instantiation used for the
+ *        shards. This must be manually defined before including this header
+ *        file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef TABLE_NAME
+#error "Must define TABLE_NAME."
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define CHASHTABLE_TYPE        struct CHASHTABLE_NAME
+#define CHASHTABLE_SHARD_TYPE  struct JOIN(CHASHTABLE_NAME, shard)
+#define CHASHTABLE_STATS_TYPE  struct JOIN(CHASHTABLE_NAME, shard_stats)
+#define CHASHTABLE_TABLE_TYPE  struct TABLE_NAME
+#define CHASHTABLE_SHARD_OF    JOIN(internal, JOIN(CHASHTABLE_NAME, shard_of))
+#define CHASHTABLE_READ_LOCK   JOIN(internal, JOIN(CHASHTABLE_NAME, read_lock))
+#define CHASHTABLE_WRITE_LOCK  JOIN(internal, JOIN(CHASHTABLE_NAME, write_lock))
+#define CHASHTABLE_UNLOCK      JOIN(internal, JOIN(CHASHTABLE_NAME, unlock))
+#define CHASHTABLE_RESERVE     JOIN(internal, JOIN(CHASHTABLE_NAME, reserve))
+#define CHASHTABLE_HASH_FACTOR (UINT32_C(0x9E3779B9))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct CHASHTABLE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Snapshot of the counters of a shard.
+ */
+struct JOIN(CHASHTABLE_NAME, shard_stats) {
+    uint32_t count;              ///< Number of keys in the shard.
+    uint32_t capacity;           ///< Capacity of the shard table.
+    uint64_t n_reads;            ///< Number of shared lock acquisitions.
+    uint64_t n_writes;           ///< Number of exclusive lock acquisitions.
+    uint64_t n_contended_reads;  ///< Number of shared lock acquisitions that had to wait.
+    uint64_t n_contended_writes; ///< Number of exclusive lock acquisitions that had to wait.
+    uint64_t n_grows;            ///< Number of times the shard table was doubled.
+};
+
+/**
+ * @brief Generated shard struct type. Padded to a multiple of
+ *        `CHASHTABLE_CACHE_LINE_SIZE`.
+ */
+struct JOIN(CHASHTABLE_NAME, shard) {
+    alignas(CHASHTABLE_CACHE_LINE_SIZE) pthread_rwlock_t lock; ///< Lock guarding the table.
+    CHASHTABLE_TABLE_TYPE *table_ptr;                           ///< Table of the shard.
+
+    _Atomic uint64_t n_reads;            ///< Number of shared lock acquisitions.
+    _Atomic uint64_t n_writes;           ///< Number of exclusive lock acquisitions.
+    _Atomic uint64_t n_contended_reads;  ///< Number of shared lock acquisitions that had to wait.
+    _Atomic uint64_t n_contended_writes; ///< Number of exclusive lock acquisitions that had to wait.
+    _Atomic uint64_t n_grows;            ///< Number of times the table was doubled.
+};
+
+/**
+ * @brief Generated concurrent hashtable struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct CHASHTABLE_NAME {
+    uint32_t n_shards;    ///< Number of shards. A power of two.
+    uint32_t shard_shift; ///< Right shift of the multiplied hash giving the shard index.
+
+    void *context_ptr;                                                   ///< Allocator context.
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size); ///< Allocate function.
+    void (*deallocate)(void *context_ptr, void *mem);                    ///< Deallocate function.
+
+    CHASHTABLE_SHARD_TYPE shards[]; ///< Shards.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Create a concurrent hashtable with a given number of shards and
+ *        initial capacity with a custom allocator.
+ *
+ * The allocate function must honor the alignment given to it, as the shards
+ * are aligned to `CHASHTABLE_CACHE_LINE_SIZE`.
+ *
+ * @param[in] n_shards          Number of shards. Must be a power of two.
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ * @param[in] deallocate        Deallocate function.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If a shard table or lock could not be created.
+ */
+FUNCTION_LINKAGE CHASHTABLE_TYPE *JOIN(CHASHTABLE_NAME, create_custom)(
+    const uint32_t n_shards, const uint32_t min_capacity, void *context_ptr,
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Create a concurrent hashtable with a given number of shards and
+ *        initial capacity with aligned_alloc() and free().
+ *
+ * @param[in] n_shards          Number of shards. Must be a power of two.
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If aligned_alloc fails.
+ *   @li                        If a shard table or lock could not be created.
+ */
+FUNCTION_LINKAGE CHASHTABLE_TYPE *JOIN(CHASHTABLE_NAME, create)(const uint32_t n_shards, const uint32_t min_capacity);
+
+/**
+ * @brief Destroy a hashtable and free the underlying memory with the
+ *        deallocate function given on creation.
+ *
+ * @warning May not be called twice in a row on the same object, nor while
+ *          other threads use the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(CHASHTABLE_NAME, destroy)(CHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return the number of keys in the hashtable.
+ *
+ * @note The shards are counted one at a time, so the result is only exact
+ *       while no other thread modifies the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      The number of keys.
+ */
+FUNCTION_LINKAGE uint32_t JOIN(CHASHTABLE_NAME, count)(CHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, contains_key)(CHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the copy of the corresponding value in the
+ *        hashtable.
+ *
+ * No pointer access is provided, as the value may be modified by another
+ * thread as soon as the lock of the shard is released.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding value.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE JOIN(CHASHTABLE_NAME, get_value)(CHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value);
+
+/**
+ * @brief Insert a non-duplicate key and it's corresponding value inside the
+ *        hashtable. Grows the shard if needed.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the key was inserted.
+ * @retval false                If the shard is full and growing it failed to allocate.
+ */
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, insert)(CHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Update a key's corresponding value inside the hashtable. Allows
+ *        duplicates. Grows the shard if needed.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the key was inserted or updated.
+ * @retval false                If the shard is full and growing it failed to allocate.
+ */
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, update)(CHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Delete a key and it's corresponding value from the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashtable.
+ */
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, delete)(CHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashtable. Keeps the current shard capacities.
+ *
+ * @note The shards are cleared one at a time.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ */
+FUNCTION_LINKAGE void JOIN(CHASHTABLE_NAME, clear)(CHASHTABLE_TYPE *self);
+
+/**
+ * @brief Get a snapshot of the counters of a shard.
+ *
+ * Taking the snapshot is not counted as a read.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] shard_index       Index of the shard. Must be less than `n_shards`.
+ *
+ * @return                      The counters of the shard.
+ */
+FUNCTION_LINKAGE CHASHTABLE_STATS_TYPE JOIN(CHASHTABLE_NAME, get_shard_stats)(CHASHTABLE_TYPE *self,
+                                                                              const uint32_t shard_index);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdlib.h>
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute indicies of keys. This must be manually defined
+ *        before including this header file.
+ *
+ * Must be the `HASH_FUNCTION` of the `TABLE_NAME` instantiation.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key.
+ * @return The hash of the key.
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+FUNCTION_LINKAGE CHASHTABLE_TYPE *JOIN(CHASHTABLE_NAME, create_custom)(
+    const uint32_t n_shards, const uint32_t min_capacity, void *context_ptr,
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(IS_POW2(n_shards));
+
+    const uint32_t shard_capacity = min_capacity / n_shards + (min_capacity % n_shards != 0);
+
+    if (shard_capacity == 0) {
+        return NULL;
+    }
+
+    const size_t size = offsetof(CHASHTABLE_TYPE, shards) + sizeof(CHASHTABLE_SHARD_TYPE) * n_shards;
+
+    CHASHTABLE_TYPE *self = (CHASHTABLE_TYPE *)allocate(context_ptr, alignof(CHASHTABLE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->n_shards = n_shards;
+    self->shard_shift = 32;
+    for (uint32_t n = n_shards; n > 1; n /= 2) {
+        self->shard_shift--;
+    }
+    self->context_ptr = context_ptr;
+    self->allocate = allocate;
+    self->deallocate = deallocate;
+
+    for (uint32_t i = 0; i < n_shards; i++) {
+        CHASHTABLE_SHARD_TYPE *shard_ptr = &self->shards[i];
+
+        shard_ptr->table_ptr = JOIN(TABLE_NAME, create_custom)(shard_capacity, context_ptr, allocate);
+
+        if (shard_ptr->table_ptr && pthread_rwlock_init(&shard_ptr->lock, NULL) != 0) {
+            JOIN(TABLE_NAME, destroy_custom)(shard_ptr->table_ptr, context_ptr, deallocate);
+            shard_ptr->table_ptr = NULL;
+        }
+
+        if (!shard_ptr->table_ptr) {
+            while (i-- > 0) {
+                pthread_rwlock_destroy(&self->shards[i].lock);
+                JOIN(TABLE_NAME, destroy_custom)(self->shards[i].table_ptr, context_ptr, deallocate);
+            }
+            deallocate(context_ptr, self);
+            return NULL;
+        }
+
+        atomic_init(&shard_ptr->n_reads, 0);
+        atomic_init(&shard_ptr->n_writes, 0);
+        atomic_init(&shard_ptr->n_contended_reads, 0);
+        atomic_init(&shard_ptr->n_contended_writes, 0);
+        atomic_init(&shard_ptr->n_grows, 0);
+    }
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(CHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    // aligned_alloc requires the size to be a multiple of the alignment:
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static inline void JOIN(internal, JOIN(CHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE CHASHTABLE_TYPE *JOIN(CHASHTABLE_NAME, create)(const uint32_t n_shards, const uint32_t min_capacity)
+{
+    return JOIN(CHASHTABLE_NAME, create_custom)(n_shards, min_capacity, NULL,
+                                                JOIN(internal, JOIN(CHASHTABLE_NAME, allocate)),
+                                                JOIN(internal, JOIN(CHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(CHASHTABLE_NAME, destroy)(CHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    for (uint32_t i = 0; i < self->n_shards; i++) {
+        pthread_rwlock_destroy(&self->shards[i].lock);
+        JOIN(TABLE_NAME, destroy_custom)(self->shards[i].table_ptr, self->context_ptr, self->deallocate);
+    }
+
+    self->deallocate(self->context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline CHASHTABLE_SHARD_TYPE *JOIN(internal, JOIN(CHASHTABLE_NAME, shard_of))(CHASHTABLE_TYPE *self,
+                                                                                      const KEY_TYPE key)
+{
+    const uint32_t hash = (uint32_t)HASH_FUNCTION(key) * CHASHTABLE_HASH_FACTOR;
+
+    // widened, as the shift is 32 with a single shard:
+    return &self->shards[(uint64_t)hash >> self->shard_shift];
+}
+
+// Take the lock shared. A failed try means another thread holds it exclusively.
+static inline void JOIN(internal, JOIN(CHASHTABLE_NAME, read_lock))(CHASHTABLE_SHARD_TYPE *shard_ptr)
+{
+    if (pthread_rwlock_tryrdlock(&shard_ptr->lock) != 0) {
+        atomic_fetch_add_explicit(&shard_ptr->n_contended_reads, 1, memory_order_relaxed);
+
+        const int ret = pthread_rwlock_rdlock(&shard_ptr->lock);
+        assert(ret == 0);
+        (void)ret;
+    }
+    atomic_fetch_add_explicit(&shard_ptr->n_reads, 1, memory_order_relaxed);
+}
+
+static inline void JOIN(internal, JOIN(CHASHTABLE_NAME, write_lock))(CHASHTABLE_SHARD_TYPE *shard_ptr)
+{
+    if (pthread_rwlock_trywrlock(&shard_ptr->lock) != 0) {
+        atomic_fetch_add_explicit(&shard_ptr->n_contended_writes, 1, memory_order_relaxed);
+
+        const int ret = pthread_rwlock_wrlock(&shard_ptr->lock);
+        assert(ret == 0);
+        (void)ret;
+    }
+    atomic_fetch_add_explicit(&shard_ptr->n_writes, 1, memory_order_relaxed);
+}
+
+static inline void JOIN(internal, JOIN(CHASHTABLE_NAME, unlock))(CHASHTABLE_SHARD_TYPE *shard_ptr)
+{
+    const int ret = pthread_rwlock_unlock(&shard_ptr->lock);
+    assert(ret == 0);
+    (void)ret;
+}
+
+// Make room for one more key in a write-locked shard. Returns false if the shard is full and could not grow.
+static inline bool JOIN(internal, JOIN(CHASHTABLE_NAME, reserve))(CHASHTABLE_TYPE *self,
+                                                                  CHASHTABLE_SHARD_TYPE *shard_ptr)
+{
+    CHASHTABLE_TABLE_TYPE *table_ptr = shard_ptr->table_ptr;
+    const uint32_t capacity = (uint32_t)table_ptr->capacity;
+
+    if (table_ptr->count < capacity - capacity / 4) {
+        return true;
+    }
+
+    CHASHTABLE_TABLE_TYPE *next_ptr = NULL;
+
+    if (capacity <= UINT32_MAX / 4) {
+        next_ptr = JOIN(TABLE_NAME, create_custom)(capacity * 2, self->context_ptr, self->allocate);
+    }
+
+    if (!next_ptr) {
+        return !JOIN(TABLE_NAME, is_full)(table_ptr);
+    }
+
+    JOIN(TABLE_NAME, copy)(next_ptr, table_ptr);
+    JOIN(TABLE_NAME, destroy_custom)(table_ptr, self->context_ptr, self->deallocate);
+    shard_ptr->table_ptr = next_ptr;
+
+    atomic_fetch_add_explicit(&shard_ptr->n_grows, 1, memory_order_relaxed);
+
+    return true;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE uint32_t JOIN(CHASHTABLE_NAME, count)(CHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < self->n_shards; i++) {
+        pthread_rwlock_rdlock(&self->shards[i].lock);
+        count += (uint32_t)self->shards[i].table_ptr->count;
+        CHASHTABLE_UNLOCK(&self->shards[i]);
+    }
+    return count;
+}
+
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, contains_key)(CHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = CHASHTABLE_SHARD_OF(self, key);
+
+    CHASHTABLE_READ_LOCK(shard_ptr);
+    const bool res = JOIN(TABLE_NAME, contains_key)(shard_ptr->table_ptr, key);
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    return res;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE JOIN(CHASHTABLE_NAME, get_value)(CHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value)
+{
+    assert(self != NULL);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = CHASHTABLE_SHARD_OF(self, key);
+
+    CHASHTABLE_READ_LOCK(shard_ptr);
+    const VALUE_TYPE value = JOIN(TABLE_NAME, get_value)(shard_ptr->table_ptr, key, default_value);
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    return value;
+}
+
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, insert)(CHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = CHASHTABLE_SHARD_OF(self, key);
+
+    CHASHTABLE_WRITE_LOCK(shard_ptr);
+    assert(JOIN(TABLE_NAME, contains_key)(shard_ptr->table_ptr, key) == false);
+
+    const bool has_room = CHASHTABLE_RESERVE(self, shard_ptr);
+
+    if (has_room) {
+        JOIN(TABLE_NAME, insert)(shard_ptr->table_ptr, key, value);
+    }
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    return has_room;
+}
+
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, update)(CHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = CHASHTABLE_SHARD_OF(self, key);
+
+    CHASHTABLE_WRITE_LOCK(shard_ptr);
+
+    VALUE_TYPE *value_ptr = JOIN(TABLE_NAME, get_value_mut)(shard_ptr->table_ptr, key);
+    bool res = true;
+
+    if (value_ptr != NULL) {
+        *value_ptr = value;
+    }
+    else if ((res = CHASHTABLE_RESERVE(self, shard_ptr))) {
+        JOIN(TABLE_NAME, insert)(shard_ptr->table_ptr, key, value);
+    }
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    return res;
+}
+
+FUNCTION_LINKAGE bool JOIN(CHASHTABLE_NAME, delete)(CHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = CHASHTABLE_SHARD_OF(self, key);
+
+    CHASHTABLE_WRITE_LOCK(shard_ptr);
+    const bool has_deleted = JOIN(TABLE_NAME, delete)(shard_ptr->table_ptr, key);
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    return has_deleted;
+}
+
+FUNCTION_LINKAGE void JOIN(CHASHTABLE_NAME, clear)(CHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    for (uint32_t i = 0; i < self->n_shards; i++) {
+        CHASHTABLE_WRITE_LOCK(&self->shards[i]);
+        JOIN(TABLE_NAME, clear)(self->shards[i].table_ptr);
+        CHASHTABLE_UNLOCK(&self->shards[i]);
+    }
+}
+
+FUNCTION_LINKAGE CHASHTABLE_STATS_TYPE JOIN(CHASHTABLE_NAME, get_shard_stats)(CHASHTABLE_TYPE *self,
+                                                                              const uint32_t shard_index)
+{
+    assert(self != NULL);
+    assert(shard_index < self->n_shards);
+
+    CHASHTABLE_SHARD_TYPE *shard_ptr = &self->shards[shard_index];
+    CHASHTABLE_STATS_TYPE stats;
+
+    pthread_rwlock_rdlock(&shard_ptr->lock);
+    stats.count = (uint32_t)shard_ptr->table_ptr->count;
+    stats.capacity = (uint32_t)shard_ptr->table_ptr->capacity;
+    CHASHTABLE_UNLOCK(shard_ptr);
+
+    stats.n_reads = atomic_load_explicit(&shard_ptr->n_reads, memory_order_relaxed);
+    stats.n_writes = atomic_load_explicit(&shard_ptr->n_writes, memory_order_relaxed);
+    stats.n_contended_reads = atomic_load_explicit(&shard_ptr->n_contended_reads, memory_order_relaxed);
+    stats.n_contended_writes = atomic_load_explicit(&shard_ptr->n_contended_writes, memory_order_relaxed);
+    stats.n_grows = atomic_load_explicit(&shard_ptr->n_grows, memory_order_relaxed);
+
+    return stats;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef TABLE_NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef HASH_FUNCTION
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef CHASHTABLE_NAME
+#undef CHASHTABLE_TYPE
+#undef CHASHTABLE_SHARD_TYPE
+#undef CHASHTABLE_STATS_TYPE
+#undef CHASHTABLE_TABLE_TYPE
+#undef CHASHTABLE_SHARD_OF
+#undef CHASHTABLE_READ_LOCK
+#undef CHASHTABLE_WRITE_LOCK
+#undef CHASHTABLE_UNLOCK
+#undef CHASHTABLE_RESERVE
+#undef CHASHTABLE_HASH_FACTOR
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,166 @@
+/**
+ * @file control_group.h
+ * @brief Match a group of 1-byte control tags at once
+ *
+ * A group is `CONTROL_GROUP_WIDTH` consecutive control bytes. Each byte is
+ * either `CONTROL_GROUP_EMPTY` or a 7-bit tag derived from a hash. Matching a
+ * group yields a bitmask, whose set bits can be visited from the lowest
+ * position upwards.
+ *
+ * AVX2 (32 bytes) and SSE2 (16 bytes) are used when available. Otherwise a
+ * portable 8-byte SWAR fallback is used, which may report false positive tag
+ * matches after a true match. Those are harmless as candidates are verified
+ * by a full key comparison anyway. Empty matches are always exact.
+ *
+ * Sources used:
+ *  @li https://abseil.io/about/design/swisstables
+ *  @li https://graphics.stanford.edu/~seander/bithacks.html#ZeroInWord
+ */
+
+#pragma once
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @def CONTROL_GROUP_EMPTY
+ * @brief Control byte used to flag empty slots.
+ */
+#define CONTROL_GROUP_EMPTY ((uint8_t)0x80)
+
+/**
+ * @def CONTROL_GROUP_TAG(hash)
+ * @brief Get the 7-bit tag of a 32-bit hash. Uses the upper bits, as the lower
+ *        bits are used for indexing.
+ */
+#define CONTROL_GROUP_TAG(hash) ((uint8_t)((uint32_t)(hash) >> 25))
+
+/**
+ * @def CONTROL_GROUP_WIDTH
+ * @brief Number of control bytes matched at once.
+ */
+
+/**
+ * @def CONTROL_GROUP_MASK_STRIDE
+ * @brief Number of mask bits per control byte.
+ */
+
+#if defined(__AVX2__)
+#define CONTROL_GROUP_WIDTH       32
+#define CONTROL_GROUP_MASK_STRIDE 1
+#elif defined(__SSE2__)
+#define CONTROL_GROUP_WIDTH       16
+#define CONTROL_GROUP_MASK_STRIDE 1
+#else
+#define CONTROL_GROUP_WIDTH       8
+#define CONTROL_GROUP_MASK_STRIDE 8
+#endif
+
+/**
+ * @brief Get a mask of the control bytes in a group equal to a given tag.
+ *
+ * @param[in] group_ptr         Pointer to `CONTROL_GROUP_WIDTH` control bytes.
+ * @param[in] tag               The tag.
+ *
+ * @return                      Mask of matching positions.
+ */
+static inline uint64_t control_group_match(const uint8_t *group_ptr, const uint8_t tag)
+{
+#if defined(__AVX2__)
+    const __m256i group = _mm256_loadu_si256((const __m256i *)group_ptr);
+    const __m256i cmp = _mm256_cmpeq_epi8(group, _mm256_set1_epi8((char)tag));
+    return (uint32_t)_mm256_movemask_epi8(cmp);
+#elif defined(__SSE2__)
+    const __m128i group = _mm_loadu_si128((const __m128i *)group_ptr);
+    const __m128i cmp = _mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag));
+    return (uint16_t)_mm_movemask_epi8(cmp);
+#else
+    uint64_t group;
+    memcpy(&group, group_ptr, sizeof(uint64_t));
+    const uint64_t lsbs = UINT64_C(0x0101010101010101);
+    const uint64_t msbs = UINT64_C(0x8080808080808080);
+    const uint64_t x = group ^ (lsbs * tag);
+    return (x - lsbs) & ~x & msbs;
+#endif
+}
+
+/**
+ * @brief Get a mask of the empty control bytes in a group.
+ *
+ * @param[in] group_ptr         Pointer to `CONTROL_GROUP_WIDTH` control bytes.
+ *
+ * @return                      Mask of empty positions.
+ */
+static inline uint64_t control_group_match_empty(const uint8_t *group_ptr)
+{
+#if defined(__AVX2__) || defined(__SSE2__)
+    return control_group_match(group_ptr, CONTROL_GROUP_EMPTY);
+#else
+    // tags never have the high bit set, so only empty bytes do:
+    uint64_t group;
+    memcpy(&group, group_ptr, sizeof(uint64_t));
+    return group & UINT64_C(0x8080808080808080);
+#endif
+}
+
+/**
+ * @brief Keep only the mask positions before the lowest position of another
+ *        mask.
+ *
+ * @param[in] mask              The mask to filter.
+ * @param[in] limit_mask        Non-zero mask whose lowest position is the limit.
+ *
+ * @return                      The filtered mask.
+ */
+static inline uint64_t control_group_mask_before(const uint64_t mask, const uint64_t limit_mask)
+{
+    return mask & ((limit_mask & (~limit_mask + 1)) - 1);
+}
+
+/**
+ * @brief Get the lowest position in a non-zero mask.
+ *
+ * @param[in] mask              The mask.
+ *
+ * @return                      The position as index into the group.
+ */
+static inline uint32_t control_group_mask_lowest(const uint64_t mask)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctzll(mask) / CONTROL_GROUP_MASK_STRIDE;
+#else
+    uint32_t n = 0;
+    while (!((mask >> n) & 1)) {
+        n++;
+    }
+    return n / CONTROL_GROUP_MASK_STRIDE;
+#endif
+}
+
+/**
+ * @brief Clear the lowest position in a non-zero mask.
+ *
+ * @param[in] mask              The mask.
+ *
+ * @return                      The mask without it's lowest position.
+ */
+static inline uint64_t control_group_mask_clear_lowest(const uint64_t mask)
+{
+    return mask & (mask - 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c
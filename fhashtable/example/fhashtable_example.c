@@ -73,6 +73,58 @@ void str_int_ht_test_alt(void)
     strint_ht_destroy_custom(ht, &arena, arena_deallocate);
 }
 
+#define NAME       strpool
+#define ARENA_NAME arena
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "strpool_template.h"
+
+#define NAME               symbol_ht
+#define KEY_TYPE           struct strpool_str
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) STRPOOL_STR_IS_EQUAL(a, b)
+#define HASH_FUNCTION(key) STRPOOL_STR_HASH(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+void interned_str_int_ht_test(void)
+{
+    struct arena arena;
+    arena_init(&arena, sizeof(buf), buf);
+
+    // the strings are copied once into the arena, and the table keys are handles to them:
+    struct strpool *pool = strpool_create(4, &arena);
+    struct symbol_ht *ht = symbol_ht_create(4);
+    if (!pool || !ht) {
+        assert(false);
+    }
+
+    struct strpool_str egg, milk;
+    if (!strpool_intern_cstr(pool, "egg", &egg) || !strpool_intern_cstr(pool, "milk", &milk)) {
+        assert(false);
+    }
+    symbol_ht_insert(ht, egg, 1);
+    symbol_ht_insert(ht, milk, 2);
+
+    // interning a string again gives the same handle:
+    struct strpool_str str;
+    if (!strpool_intern(pool, "milk", 4, &str)) {
+        assert(false);
+    }
+    assert(symbol_ht_get_value(ht, str, -1) == 2);
+    assert(strcmp(strpool_chars(pool, str), "milk") == 0);
+
+    // strings not in the pool are not in the table either:
+    assert(!strpool_find(pool, "chocolate", 9, &str));
+
+    symbol_ht_destroy(ht);
+    strpool_destroy(pool);
+    arena_deallocate_all(&arena);
+}
+
 #include "murmurhash.h"
 
 #define NAME               int_to_int_hashtable
@@ -144,6 +196,7 @@ void int_to_int_hashtable_test(void)
 int main(void)
 {
     str_int_ht_test_alt();
+    interned_str_int_ht_test();
     int_to_int_hashtable_test();
     return 0;
 }
@@ -5,5 +5,6 @@
 #define VALUE_TYPE         int
 #define KEY_IS_EQUAL(a, b) (strcmp((a), (b)) == 0)
 #define HASH_FUNCTION(key) (fnvhash_32_str(key))
+#define FHASHTABLE_FINGERPRINT
 #define FUNCTION_DEFINITIONS
 #include "fhashtable_template.h"
@@ -0,0 +1,812 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file fhashset_template.h
+ * @brief Fixed-size open-adressing hashset (robin hood hashing)
+ *
+ * The key-only counterpart of `fhashtable_template.h`. The slots hold an
+ * offset and a key, and no value. With `uint64_t` keys a slot takes 16 bytes
+ * instead of the 24 bytes of a hashtable slot with an unused 8-byte value, so
+ * a third less memory is touched when deduplicating keys.
+ *
+ * Ensure the capacity rounded up to the power of 2 is 75% of the expected
+ * numbers of keys to be stored to keep load factor low and the hash set
+ * performant.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `KEY_TYPE`
+ *
+ * The following macros must be defined in the implementation:
+ *      @li `KEY_IS_EQUAL(a,b)`
+ *      @li `HASH_FUNCTION(key)`
+ *
+ * The following macros can be defined to change the layout:
+ *      @li `FHASHSET_LARGE_CAPACITY`
+ *
+ * Source(s) used:
+ *  @li https://thenumb.at/Hashtables/#robin-hood-linear-probing
+ *  @li https://www.sebastiansylvan.com/post/robin-hood-hashing-should-be-your-default-hash-table-implementation/
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @brief Macro to check if a number is a power of two.
+ *
+ * @param[in] X             The number at hand.
+ *
+ * @return                  A boolean value indicating whether the number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def FHASHSET_EMPTY_SLOT_OFFSET
+ * @brief Offset constant used to flag empty slots.
+ */
+#ifndef FHASHSET_EMPTY_SLOT_OFFSET
+#define FHASHSET_EMPTY_SLOT_OFFSET (UINT32_MAX)
+#endif
+
+/**
+ * @def FHASHSET_FOR_EACH(self, index, key_)
+ *
+ * @brief Iterate over the non-empty slots in the hashset in arbitary order.
+ *
+ * @warning Modifying the hashset under the iteration may result in errors.
+ *
+ * @param[in] self              Hashset pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHSET_LARGE_CAPACITY`).
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ */
+#ifndef FHASHSET_FOR_EACH
+#define FHASHSET_FOR_EACH(self, index, key_)                            \
+    for ((index) = 0; (index) < (self)->capacity; (index)++)            \
+        if ((self)->slots[(index)].offset != FHASHSET_EMPTY_SLOT_OFFSET \
+            && ((key_) = (self)->slots[(index)].key, true))
+#endif
+
+/**
+ * @def FHASHSET_LARGE_CAPACITY
+ * @brief Use `size_t` for the count, capacity and indices instead of
+ *        `uint32_t`.
+ *
+ * Lifts the limit of `UINT32_MAX / 2 + 1` slots and the limit on the size of
+ * the hashset struct in bytes. The key hashes are then `size_t` as well. The
+ * slot offsets stay `uint32_t`.
+ *
+ * This must be defined alongside both `TYPE_DEFINITIONS` and
+ * `FUNCTION_DEFINITIONS`.
+ */
+#ifdef FHASHSET_LARGE_CAPACITY
+#endif
+
+/**
+ * @def FHASHSET_CALC_SIZEOF(fhashset_name, capacity)
+ *
+ * @brief Calculate the size of the hashset struct. No overflow checks.
+ *
+ * @param[in] fhashset_name     Defined hashset NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#ifndef FHASHSET_CALC_SIZEOF
+#define FHASHSET_CALC_SIZEOF(fhashset_name, capacity)          \
+    (FHASHSET_SIZE_TYPE)(offsetof(struct fhashset_name, slots) \
+                         + capacity * sizeof(((struct fhashset_name *)0)->slots[0]))
+#endif
+
+/**
+ * @def FHASHSET_CALC_SIZEOF_OVERFLOWS(fhashset_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the hashset struct overflows.
+ *
+ * @param[in] fhashset_name     Defined hashset NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#ifndef FHASHSET_CALC_SIZEOF_OVERFLOWS
+#define FHASHSET_CALC_SIZEOF_OVERFLOWS(fhashset_name, capacity) \
+    (capacity                                                   \
+     > (FHASHSET_SIZE_MAX - offsetof(struct fhashset_name, slots)) / sizeof(((struct fhashset_name *)0)->slots[0]))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to hashset types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define FHASHSET_NAME NAME
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define FHASHSET_TYPE      struct FHASHSET_NAME
+#define FHASHSET_SLOT_TYPE struct JOIN(FHASHSET_NAME, slot)
+#define FHASHSET_INIT      JOIN(FHASHSET_NAME, init)
+#define FHASHSET_CONTAINS  JOIN(FHASHSET_NAME, contains)
+#define FHASHSET_PROBE     JOIN(internal, JOIN(FHASHSET_NAME, probe))
+#define FHASHSET_PLACE     JOIN(internal, JOIN(FHASHSET_NAME, place))
+#define FHASHSET_BACKSHIFT JOIN(internal, JOIN(FHASHSET_NAME, backshift))
+
+#ifdef FHASHSET_LARGE_CAPACITY
+#define FHASHSET_SIZE_TYPE        size_t
+#define FHASHSET_SIZE_MAX         SIZE_MAX
+#define FHASHSET_ROUND_UP_POW2(x) ((size_t)round_up_pow2_64(x))
+#else
+#define FHASHSET_SIZE_TYPE        uint32_t
+#define FHASHSET_SIZE_MAX         UINT32_MAX
+#define FHASHSET_ROUND_UP_POW2(x) round_up_pow2_32(x)
+#endif
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(FHASHSET_NAME, slot);
+struct FHASHSET_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated hashset slot struct type for a given `KEY_TYPE`.
+ */
+struct JOIN(FHASHSET_NAME, slot) {
+    uint32_t offset; ///< Offset from the ideal slot index.
+    KEY_TYPE key;    ///< The key in this slot
+};
+
+/**
+ * @brief Generated hashset struct type for a given `KEY_TYPE`.
+ */
+struct FHASHSET_NAME {
+    FHASHSET_SIZE_TYPE count;    ///< Number of non-empty slots.
+    FHASHSET_SIZE_TYPE capacity; ///< Number of slots.
+    FHASHSET_SLOT_TYPE slots[];  ///< Array of slots.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Initialize a hashset struct, given a (power-of-2) capacity.
+ *
+ * @param[in] self              Hashset pointer
+ * @param[in] pow2_capacity     Power of 2 capacity.
+ */
+FUNCTION_LINKAGE FHASHSET_TYPE *JOIN(FHASHSET_NAME, init)(FHASHSET_TYPE *self, const FHASHSET_SIZE_TYPE pow2_capacity);
+
+/**
+ * @brief Create an hashset with a given capacity with a custom allocator.
+ *
+ * @param[in] min_capacity      Maximum number of keys to be stored.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ *
+ * @return                      A pointer to the hashset.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FHASHSET_LARGE_CAPACITY`) or the equivalent size overflows.
+ */
+FUNCTION_LINKAGE FHASHSET_TYPE *
+    JOIN(FHASHSET_NAME, create_custom)(const FHASHSET_SIZE_TYPE min_capacity, void *context_ptr,
+                                       void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
+
+/**
+ * @brief Create an hashset with a given capacity with malloc().
+ *
+ * @param[in] min_capacity      Maximum number of keys to be stored.
+ *
+ * @return                      A pointer to the hashset.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FHASHSET_LARGE_CAPACITY`) or the equivalent size overflows.
+ */
+FUNCTION_LINKAGE FHASHSET_TYPE *JOIN(FHASHSET_NAME, create)(const FHASHSET_SIZE_TYPE min_capacity);
+
+/**
+ * @brief Destroy an hashset struct and free the underlying memory with
+ *        a custom allocator.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashset pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, destroy_custom)(FHASHSET_TYPE *self, void *context_ptr,
+                                                          void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy an hashset struct and free the underlying memory with
+ *        free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashset pointer.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, destroy)(FHASHSET_TYPE *self);
+
+/**
+ * @brief Return whether the hashset is empty.
+ *
+ * @param[in] self              The hashset pointer.
+ *
+ * @return                      Whether the hashset is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, is_empty)(const FHASHSET_TYPE *self);
+
+/**
+ * @brief Return whether the hashset is full.
+ *
+ * @param[in] self              The hashset pointer.
+ *
+ * @return                      Whether the hashset is full.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, is_full)(const FHASHSET_TYPE *self);
+
+/**
+ * @brief Check if hashset contains a key.
+ *
+ * @param[in] self              The hashset pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashset contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, contains)(const FHASHSET_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Insert a key inside the hashset, if it's not already contained.
+ *
+ * The slots are probed once, and the key is placed where the lookup stopped.
+ * The hashset must not be full, unless it contains the key.
+ *
+ * @param[in] self              The hashset pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the key was inserted, i.e. was not contained before.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, insert)(FHASHSET_TYPE *self, KEY_TYPE key);
+
+/**
+ * @brief Delete a key from the hashset.
+ *
+ * @param[in] self              The hashset pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashset.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, delete)(FHASHSET_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashset and flag all slots as empty.
+ *
+ * @param[in] self              The pointer of the hashset to clear.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, clear)(FHASHSET_TYPE *self);
+
+/**
+ * @brief Copy the keys from a source hashset to a destination hashset.
+ *
+ * @param[out] dest_ptr         The destination hashset. Must be empty.
+ * @param[in] src_ptr           The source hashset.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, copy)(FHASHSET_TYPE *restrict dest_ptr,
+                                                const FHASHSET_TYPE *restrict src_ptr);
+
+/**
+ * @brief Count the keys contained in both hashsets.
+ *
+ * The keys of the smaller hashset are looked up in the larger one.
+ *
+ * @param[in] a_ptr             The first hashset.
+ * @param[in] b_ptr             The second hashset.
+ *
+ * @return                      The size of the intersection.
+ */
+FUNCTION_LINKAGE FHASHSET_SIZE_TYPE JOIN(FHASHSET_NAME, intersect_count)(const FHASHSET_TYPE *a_ptr,
+                                                                         const FHASHSET_TYPE *b_ptr);
+
+/**
+ * @brief Insert the keys of a source hashset into a destination hashset,
+ *        skipping the keys it already contains.
+ *
+ * @param[in] dest_ptr          The destination hashset.
+ * @param[in] src_ptr           The source hashset.
+ *
+ * @return                      A boolean indicating whether all keys fit.
+ * @retval false                If the destination got full with keys of the source left to insert. The keys
+ *                              inserted until then are kept.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, union_into)(FHASHSET_TYPE *restrict dest_ptr,
+                                                      const FHASHSET_TYPE *restrict src_ptr);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef FHASHSET_LARGE_CAPACITY
+#include "round_up_pow2_64.h" // round_up_pow2_64
+#else
+#include "round_up_pow2_32.h" // round_up_pow2_32
+#endif
+
+/**
+ * @def KEY_IS_EQUAL(a, b)
+ * @brief Used to compare two keys This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @attention
+ *   @li If comparing two scalar values, set this macro to ((a) == (b)).
+ *   @li If comparing two strings, set this macro to strcmp() or strncmp()
+ *       appropiately.
+ *   @li If comparing two structs, set this macro to a function that does
+ *       element-wise comparison between the structs.
+ *
+ * @retval true If the two keys are equal. Equivalent to a non-zero int.
+ * @retval false If the two key are not equal. Equivalent to the int 0.
+ */
+#ifndef KEY_IS_EQUAL
+#error "Must define KEY_IS_EQUAL."
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute indicies of keys. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key.
+ * @return The hash of the key as `uint32_t` (or `size_t` with
+ *         `FHASHSET_LARGE_CAPACITY`).
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+FUNCTION_LINKAGE FHASHSET_TYPE *JOIN(FHASHSET_NAME, init)(FHASHSET_TYPE *self, const FHASHSET_SIZE_TYPE pow2_capacity)
+{
+    assert(self);
+    assert(IS_POW2(pow2_capacity));
+
+    self->count = 0;
+    self->capacity = pow2_capacity;
+
+    for (FHASHSET_SIZE_TYPE i = 0; i < self->capacity; i++) {
+        self->slots[i].offset = FHASHSET_EMPTY_SLOT_OFFSET;
+    }
+
+    return self;
+}
+
+FUNCTION_LINKAGE FHASHSET_TYPE *
+    JOIN(FHASHSET_NAME, create_custom)(const FHASHSET_SIZE_TYPE min_capacity, void *context_ptr,
+                                       void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
+{
+    if (min_capacity == 0 || min_capacity > FHASHSET_SIZE_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    const FHASHSET_SIZE_TYPE capacity = FHASHSET_ROUND_UP_POW2(min_capacity);
+
+    if (FHASHSET_CALC_SIZEOF_OVERFLOWS(FHASHSET_NAME, capacity)) {
+        return NULL;
+    }
+
+    const FHASHSET_SIZE_TYPE size = FHASHSET_CALC_SIZEOF(FHASHSET_NAME, capacity);
+
+    FHASHSET_TYPE *self = (FHASHSET_TYPE *)allocate(context_ptr, alignof(FHASHSET_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    memset(self, 0, size);
+    FHASHSET_INIT(self, capacity);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(FHASHSET_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+/// @endcond
+
+FUNCTION_LINKAGE FHASHSET_TYPE *JOIN(FHASHSET_NAME, create)(const FHASHSET_SIZE_TYPE capacity)
+{
+    return JOIN(FHASHSET_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(FHASHSET_NAME, allocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, destroy_custom)(FHASHSET_TYPE *self, void *context_ptr,
+                                                          void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(FHASHSET_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, destroy)(FHASHSET_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(FHASHSET_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(FHASHSET_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, is_empty)(const FHASHSET_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, is_full)(const FHASHSET_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+// Look up a key. If it's not contained, index and offset are set to where the key would be placed: an empty slot or
+// the first slot closer to it's ideal index than the key would be.
+static inline bool JOIN(internal, JOIN(FHASHSET_NAME, probe))(const FHASHSET_TYPE *self, const KEY_TYPE key,
+                                                               FHASHSET_SIZE_TYPE *index_ptr, uint32_t *offset_ptr)
+{
+    const FHASHSET_SIZE_TYPE key_hash = HASH_FUNCTION(key);
+    const FHASHSET_SIZE_TYPE index_mask = self->capacity - 1;
+
+    FHASHSET_SIZE_TYPE index = key_hash & index_mask;
+    uint32_t max_possible_offset = 0;
+
+    while (true) {
+        const bool not_empty = self->slots[index].offset != FHASHSET_EMPTY_SLOT_OFFSET;
+
+        const bool below_max = max_possible_offset <= self->slots[index].offset;
+
+        if (!(not_empty && below_max)) {
+            break;
+        }
+
+        if (KEY_IS_EQUAL(self->slots[index].key, key)) {
+            *index_ptr = index;
+            return true;
+        }
+
+        index++;
+        index &= index_mask;
+        max_possible_offset++;
+    }
+    *index_ptr = index;
+    *offset_ptr = max_possible_offset;
+    return false;
+}
+
+// Place a slot at an index, which is empty or holds a slot closer to it's ideal index than the given slot. The
+// following slots are displaced as needed.
+static inline void JOIN(internal, JOIN(FHASHSET_NAME, place))(FHASHSET_TYPE *self, FHASHSET_SIZE_TYPE index,
+                                                               FHASHSET_SLOT_TYPE current_slot)
+{
+    const FHASHSET_SIZE_TYPE index_mask = self->capacity - 1;
+
+    while (self->slots[index].offset != FHASHSET_EMPTY_SLOT_OFFSET) {
+        if (current_slot.offset > self->slots[index].offset) {
+            const FHASHSET_SLOT_TYPE temp = self->slots[index];
+            self->slots[index] = current_slot;
+            current_slot = temp;
+        }
+        index++;
+        index &= index_mask;
+        current_slot.offset++;
+    }
+    self->slots[index] = current_slot;
+    self->count++;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, contains)(const FHASHSET_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    FHASHSET_SIZE_TYPE index;
+    uint32_t offset;
+
+    return FHASHSET_PROBE(self, key, &index, &offset);
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, insert)(FHASHSET_TYPE *self, KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    FHASHSET_SIZE_TYPE index;
+    uint32_t offset;
+
+    if (FHASHSET_PROBE(self, key, &index, &offset)) {
+        return false;
+    }
+    assert(self->count < self->capacity);
+
+    const FHASHSET_SLOT_TYPE slot = {.offset = offset, .key = key};
+    FHASHSET_PLACE(self, index, slot);
+
+    return true;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(FHASHSET_NAME, backshift))(FHASHSET_TYPE *self,
+                                                                   const FHASHSET_SIZE_TYPE index_mask,
+                                                                   FHASHSET_SIZE_TYPE index)
+{
+    assert(self);
+
+    FHASHSET_SIZE_TYPE next_index = (index + 1) & index_mask;
+
+    while (true) {
+        const bool not_empty = self->slots[next_index].offset != FHASHSET_EMPTY_SLOT_OFFSET;
+
+        const bool offset_is_non_zero = self->slots[next_index].offset > 0;
+
+        if (!(not_empty && offset_is_non_zero)) {
+            break;
+        }
+
+        self->slots[index] = self->slots[next_index];
+        self->slots[index].offset--;
+
+        self->slots[next_index].offset = FHASHSET_EMPTY_SLOT_OFFSET;
+
+        index = next_index;
+        next_index = (index + 1) & index_mask;
+    }
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, delete)(FHASHSET_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    FHASHSET_SIZE_TYPE index;
+    uint32_t offset;
+
+    if (!FHASHSET_PROBE(self, key, &index, &offset)) {
+        return false;
+    }
+
+    self->slots[index].offset = FHASHSET_EMPTY_SLOT_OFFSET;
+    self->count--;
+
+    FHASHSET_BACKSHIFT(self, self->capacity - 1, index);
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, clear)(FHASHSET_TYPE *self)
+{
+    assert(self != NULL);
+
+    for (FHASHSET_SIZE_TYPE i = 0; i < self->capacity; i++) {
+        self->slots[i].offset = FHASHSET_EMPTY_SLOT_OFFSET;
+    }
+    self->count = 0;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHSET_NAME, copy)(FHASHSET_TYPE *restrict dest_ptr,
+                                                const FHASHSET_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(src_ptr->capacity <= dest_ptr->capacity);
+    assert(dest_ptr->count == 0);
+
+    if (dest_ptr->capacity == src_ptr->capacity) {
+        memcpy(dest_ptr->slots, src_ptr->slots, src_ptr->capacity * sizeof(FHASHSET_SLOT_TYPE));
+        dest_ptr->count = src_ptr->count;
+        return;
+    }
+
+    // the keys are distinct, so they are placed without looking them up first:
+    const FHASHSET_SIZE_TYPE index_mask = dest_ptr->capacity - 1;
+
+    FHASHSET_SIZE_TYPE index;
+    KEY_TYPE key;
+    FHASHSET_FOR_EACH(src_ptr, index, key)
+    {
+        const FHASHSET_SLOT_TYPE slot = {.offset = 0, .key = key};
+
+        FHASHSET_PLACE(dest_ptr, HASH_FUNCTION(key) & index_mask, slot);
+    }
+}
+
+FUNCTION_LINKAGE FHASHSET_SIZE_TYPE JOIN(FHASHSET_NAME, intersect_count)(const FHASHSET_TYPE *a_ptr,
+                                                                         const FHASHSET_TYPE *b_ptr)
+{
+    assert(a_ptr != NULL);
+    assert(b_ptr != NULL);
+
+    if (a_ptr->count > b_ptr->count) {
+        const FHASHSET_TYPE *temp = a_ptr;
+        a_ptr = b_ptr;
+        b_ptr = temp;
+    }
+
+    FHASHSET_SIZE_TYPE count = 0;
+
+    FHASHSET_SIZE_TYPE index;
+    KEY_TYPE key;
+    FHASHSET_FOR_EACH(a_ptr, index, key)
+    {
+        count += FHASHSET_CONTAINS(b_ptr, key);
+    }
+    return count;
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHSET_NAME, union_into)(FHASHSET_TYPE *restrict dest_ptr,
+                                                      const FHASHSET_TYPE *restrict src_ptr)
+{
+    assert(dest_ptr != NULL);
+    assert(src_ptr != NULL);
+
+    FHASHSET_SIZE_TYPE index;
+    KEY_TYPE key;
+    FHASHSET_FOR_EACH(src_ptr, index, key)
+    {
+        FHASHSET_SIZE_TYPE dest_index;
+        uint32_t offset;
+
+        if (FHASHSET_PROBE(dest_ptr, key, &dest_index, &offset)) {
+            continue;
+        }
+        if (dest_ptr->count == dest_ptr->capacity) {
+            return false;
+        }
+
+        const FHASHSET_SLOT_TYPE slot = {.offset = offset, .key = key};
+        FHASHSET_PLACE(dest_ptr, dest_index, slot);
+    }
+    return true;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef KEY_TYPE
+#undef KEY_IS_EQUAL
+#undef HASH_FUNCTION
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef FHASHSET_LARGE_CAPACITY
+
+#undef FHASHSET_NAME
+#undef FHASHSET_TYPE
+#undef FHASHSET_SLOT_TYPE
+#undef FHASHSET_INIT
+#undef FHASHSET_CONTAINS
+#undef FHASHSET_PROBE
+#undef FHASHSET_PLACE
+#undef FHASHSET_BACKSHIFT
+#undef FHASHSET_SIZE_TYPE
+#undef FHASHSET_SIZE_MAX
+#undef FHASHSET_ROUND_UP_POW2
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -27,6 +27,20 @@
  *      @li `KEY_IS_EQUAL(a,b)`
  *      @li `HASH_FUNCTION(key)`
  *
+ * The following macros can be defined to generate additional operations:
+ *      @li `COMBINE_VALUES(old_value, value)`
+ *      @li `FHASHTABLE_PERSIST`
+ *      @li `FHASHTABLE_STATS`
+ *      @li `FHASHTABLE_PARALLEL`
+ *      @li `FHASHTABLE_MULTIMAP`
+ *
+ * The following macros can be defined to change the layout:
+ *      @li `FHASHTABLE_CONTROL_BYTES`
+ *      @li `FHASHTABLE_FINGERPRINT`
+ *      @li `FHASHTABLE_LAYOUT_SOA`
+ *      @li `FHASHTABLE_LARGE_CAPACITY`
+ *      @li `FHASHTABLE_OCCUPANCY_BITMAP`
+ *
  * Source(s) used:
  *  @li https://thenumb.at/Hashtables/#robin-hood-linear-probing
  *  @li https://www.sebastiansylvan.com/post/robin-hood-hashing-should-be-your-default-hash-table-implementation/
@@ -50,6 +64,14 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef FHASHTABLE_CONTROL_BYTES
+#include "control_group.h" // CONTROL_GROUP_WIDTH, control_group_match, ...
+#endif
+
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#include "occupancy_bitmap.h" // OCCUPANCY_BITMAP_N_WORDS, occupancy_bitmap_next, ...
+#endif
+
 // macro definitions: {{{
 
 /**
@@ -103,7 +125,8 @@ extern "C" {
  * @warning Modifying the hashtable under the iteration may result in errors.
  *
  * @param[in] self              Hashtable pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
  * @param[out] key_             Current key. Should be `KEY_TYPE`.
  * @param[out] value_           Current value. Should be `VALUE_TYPE`.
  */
@@ -114,6 +137,431 @@ extern "C" {
             && ((key_) = (self)->slots[(index)].key, (value_) = (self)->slots[(index)].value, true))
 #endif
 
+/**
+ * @def FHASHTABLE_SOA_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots in a hashtable defined with
+ *        `FHASHTABLE_LAYOUT_SOA` in arbitary order.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_SOA_FOR_EACH
+#define FHASHTABLE_SOA_FOR_EACH(self, index, key_, value_)           \
+    for ((index) = 0; (index) < (self)->capacity; (index)++)         \
+        if ((self)->offsets[(index)] != FHASHTABLE_EMPTY_SLOT_OFFSET \
+            && ((key_) = (self)->keys[(index)], (value_) = (self)->values[(index)], true))
+#endif
+
+/**
+ * @def FHASHTABLE_FOR_EACH_RANGE(self, index, begin, end, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots with indicies in `[begin, end)`.
+ *        Meant for the callback of `parallel_for_each_range`.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[in] begin             First slot index.
+ * @param[in] end               One past the last slot index. At most the capacity.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_FOR_EACH_RANGE
+#define FHASHTABLE_FOR_EACH_RANGE(self, index, begin, end, key_, value_)  \
+    for ((index) = (begin); (index) < (end); (index)++)                   \
+        if ((self)->slots[(index)].offset != FHASHTABLE_EMPTY_SLOT_OFFSET \
+            && ((key_) = (self)->slots[(index)].key, (value_) = (self)->slots[(index)].value, true))
+#endif
+
+/**
+ * @def FHASHTABLE_SOA_FOR_EACH_RANGE(self, index, begin, end, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots with indicies in `[begin, end)` in a
+ *        hashtable defined with `FHASHTABLE_LAYOUT_SOA`. Meant for the callback
+ *        of `parallel_for_each_range`.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[in] begin             First slot index.
+ * @param[in] end               One past the last slot index. At most the capacity.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_SOA_FOR_EACH_RANGE
+#define FHASHTABLE_SOA_FOR_EACH_RANGE(self, index, begin, end, key_, value_) \
+    for ((index) = (begin); (index) < (end); (index)++)                      \
+        if ((self)->offsets[(index)] != FHASHTABLE_EMPTY_SLOT_OFFSET         \
+            && ((key_) = (self)->keys[(index)], (value_) = (self)->values[(index)], true))
+#endif
+
+/**
+ * @def FHASHTABLE_BITMAP_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots in a hashtable defined with
+ *        `FHASHTABLE_OCCUPANCY_BITMAP` in arbitary order, skipping from one
+ *        occupied slot to the next.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_BITMAP_FOR_EACH
+#define FHASHTABLE_BITMAP_FOR_EACH(self, index, key_, value_)                              \
+    for ((index) = OCCUPANCY_BITMAP_NEXT((self)->occupied, (self)->capacity, 0 * (index)); \
+         (index) < (self)->capacity;                                                       \
+         (index) = OCCUPANCY_BITMAP_NEXT((self)->occupied, (self)->capacity, (index) + 1)) \
+        if (((key_) = (self)->slots[(index)].key, (value_) = (self)->slots[(index)].value, true))
+#endif
+
+/**
+ * @def FHASHTABLE_SOA_BITMAP_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots in a hashtable defined with
+ *        `FHASHTABLE_OCCUPANCY_BITMAP` and `FHASHTABLE_LAYOUT_SOA` in arbitary
+ *        order, skipping from one occupied slot to the next.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_SOA_BITMAP_FOR_EACH
+#define FHASHTABLE_SOA_BITMAP_FOR_EACH(self, index, key_, value_)                          \
+    for ((index) = OCCUPANCY_BITMAP_NEXT((self)->occupied, (self)->capacity, 0 * (index)); \
+         (index) < (self)->capacity;                                                       \
+         (index) = OCCUPANCY_BITMAP_NEXT((self)->occupied, (self)->capacity, (index) + 1)) \
+        if (((key_) = (self)->keys[(index)], (value_) = (self)->values[(index)], true))
+#endif
+
+/**
+ * @def FHASHTABLE_EQUAL_RANGE_FOR_EACH(self, i, first_index, n, value_)
+ *
+ * @brief Iterate over the values of a key in a hashtable defined with
+ *        `FHASHTABLE_MULTIMAP`, given the range found by `equal_range`.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] i                 Temporary counting variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[in] first_index       First slot index of the range.
+ * @param[in] n                 Number of slots in the range.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_EQUAL_RANGE_FOR_EACH
+#define FHASHTABLE_EQUAL_RANGE_FOR_EACH(self, i, first_index, n, value_)                            \
+    for ((i) = 0;                                                                                   \
+         (i) < (n)                                                                                  \
+         && ((value_) = (self)->slots[((first_index) + (i)) & ((self)->capacity - 1)].value, true); \
+         (i)++)
+#endif
+
+/**
+ * @def FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH(self, i, first_index, n, value_)
+ *
+ * @brief Iterate over the values of a key in a hashtable defined with
+ *        `FHASHTABLE_MULTIMAP` and `FHASHTABLE_LAYOUT_SOA`, given the range
+ *        found by `equal_range`.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] i                 Temporary counting variable. Should be `uint32_t` (`size_t` with
+ *                              `FHASHTABLE_LARGE_CAPACITY`).
+ * @param[in] first_index       First slot index of the range.
+ * @param[in] n                 Number of slots in the range.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH
+#define FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH(self, i, first_index, n, value_)                             \
+    for ((i) = 0;                                                                                        \
+         (i) < (n) && ((value_) = (self)->values[((first_index) + (i)) & ((self)->capacity - 1)], true); \
+         (i)++)
+#endif
+
+/**
+ * @def FHASHTABLE_CONTROL_BYTES
+ * @brief Keep a seperate array of 1-byte control tags after the slots.
+ *
+ * Each control byte holds 7 bits of the key hash or flags the slot as empty.
+ * Lookups scan `CONTROL_GROUP_WIDTH` control bytes at once (with SSE2 / AVX2
+ * if available), and only touch the slots whose tag match. This makes most
+ * lookups settle with a single vector compare and one slot access.
+ *
+ * The slot type and the interface stay the same. `FHASHTABLE_CALC_SIZEOF`
+ * accounts for the additional `capacity + CONTROL_GROUP_WIDTH` bytes.
+ */
+#ifdef FHASHTABLE_CONTROL_BYTES
+#endif
+
+/**
+ * @def FHASHTABLE_FINGERPRINT
+ * @brief Store the upper 16 bits of the key hash in the lower half of the slot
+ *        offset.
+ *
+ * The probe distance is kept in the upper half, so it's limited to 65534 slots,
+ * which is never reached with a reasonable hash function. Keys are only
+ * compared with `KEY_IS_EQUAL` if the fingerprint matches, which saves a
+ * `strcmp` or similar per probed slot. `copy` into a larger hashtable reuses
+ * the stored hashes instead of calling `HASH_FUNCTION` again when the source
+ * has at least 65536 slots.
+ *
+ * The slot type stays the same, so this only needs to be defined alongside
+ * `FUNCTION_DEFINITIONS`. `FHASHTABLE_FOR_EACH` works as before. Can be
+ * combined with `FHASHTABLE_CONTROL_BYTES`.
+ */
+#ifdef FHASHTABLE_FINGERPRINT
+#endif
+
+/**
+ * @def FHASHTABLE_LAYOUT_SOA
+ * @brief Store the offsets, keys and values as three seperate arrays (in the
+ *        same allocation) rather than one array of slots.
+ *
+ * Probing then only touches the offsets and keys, and no padding is needed
+ * between a key and it's value. This pays off for large or oddly aligned
+ * `VALUE_TYPE`s.
+ *
+ * The hashtable struct has `offsets`, `keys` and `values` members instead of
+ * `slots`, so `FHASHTABLE_SOA_FOR_EACH` is used to iterate over it instead of
+ * `FHASHTABLE_FOR_EACH`. This must be defined alongside both
+ * `TYPE_DEFINITIONS` and `FUNCTION_DEFINITIONS`.
+ */
+#ifdef FHASHTABLE_LAYOUT_SOA
+#endif
+
+/**
+ * @def FHASHTABLE_LARGE_CAPACITY
+ * @brief Use `size_t` for the count, capacity and indices instead of
+ *        `uint32_t`.
+ *
+ * Lifts the limit of `UINT32_MAX / 2 + 1` slots and the limit on the size of
+ * the hashtable struct in bytes. The key hashes are then `size_t` as well, and
+ * `HASH_FUNCTION` needs to return a 64-bit hash for the keys to be spread over
+ * more than 2^32 slots. The control tags and fingerprints are still taken from
+ * the lower 32 bits of the hash. The slot offsets stay `uint32_t`.
+ *
+ * This must be defined alongside both `TYPE_DEFINITIONS` and
+ * `FUNCTION_DEFINITIONS`. Can be combined with the other modes.
+ */
+#ifdef FHASHTABLE_LARGE_CAPACITY
+#endif
+
+/**
+ * @def FHASHTABLE_OCCUPANCY_BITMAP
+ * @brief Keep a bitmap of the non-empty slots after the slots.
+ *
+ * `FHASHTABLE_BITMAP_FOR_EACH` (`FHASHTABLE_SOA_BITMAP_FOR_EACH`) then skips
+ * 64 empty slots per bitmap word, and `clear` only resets the non-empty slots.
+ * Iterating over and clearing a sparse hashtable then takes time proportional
+ * to the count (plus the capacity / 64 bitmap words), rather than the
+ * capacity. Costs one bit per slot, and a bit update per insert and delete.
+ *
+ * The hashtable struct has an `occupied` member pointing to the bitmap. This
+ * must be defined alongside both `TYPE_DEFINITIONS` and
+ * `FUNCTION_DEFINITIONS`. Can be combined with the other modes.
+ */
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#endif
+
+/**
+ * @def FHASHTABLE_PERSIST
+ * @brief Generate `save_to_fd`, `map_from_file` and `unmap`, to save a
+ *        hashtable to a file and map it back into memory as is.
+ *
+ * The hashtable is one flat allocation, so it is written out byte by byte
+ * after a `struct fhashtable_file_header`, and mapped back with `mmap` without
+ * re-inserting any key. The header records the layout, the key and value
+ * sizes and `FHASHTABLE_HASH_ID`, and a file not matching the instantiation is
+ * rejected. The keys and values must not contain pointers.
+ *
+ * Requires POSIX. This only needs to be defined alongside
+ * `FUNCTION_DEFINITIONS`. Can be combined with the other modes.
+ */
+#ifdef FHASHTABLE_PERSIST
+#endif
+
+/**
+ * @def FHASHTABLE_STATS
+ * @brief Count the probes per lookup, the robin hood swaps per insert and the
+ *        slots moved back per delete, and generate `get_stats` and
+ *        `reset_stats`.
+ *
+ * The counters are kept in a `struct fhashtable_stats` member of the
+ * hashtable struct. It also tracks an upper bound of the largest offset of
+ * any key, which is exact after `reset_stats`. With `FHASHTABLE_CONTROL_BYTES`
+ * unsuccessful lookups stop at this bound without loading the slot offset at
+ * the end of each control group.
+ *
+ * The lookups update the counters as well, so a hashtable may not be read
+ * from several threads at once (as `chashtable_template.h` does), and
+ * `map_from_file` only maps a writable hashtable.
+ *
+ * This must be defined alongside both `TYPE_DEFINITIONS` and
+ * `FUNCTION_DEFINITIONS`. Can be combined with the other modes.
+ */
+#ifdef FHASHTABLE_STATS
+#endif
+
+/**
+ * @def FHASHTABLE_STATS_HISTOGRAM_SIZE
+ * @brief Number of buckets in the probe length histogram of
+ *        `struct fhashtable_stats`.
+ */
+#ifndef FHASHTABLE_STATS_HISTOGRAM_SIZE
+#define FHASHTABLE_STATS_HISTOGRAM_SIZE (16)
+
+/**
+ * @brief Probe counters of a hashtable defined with `FHASHTABLE_STATS`.
+ *
+ * A probe is a slot looked at (a control group with
+ * `FHASHTABLE_CONTROL_BYTES`).
+ */
+struct fhashtable_stats {
+    uint64_t n_lookups;       ///< Number of lookups, including those done by insert, update, delete, etc.
+    uint64_t n_lookup_probes; ///< Number of probes of all lookups.
+    uint64_t n_inserts;       ///< Number of keys inserted.
+    uint64_t n_insert_swaps;  ///< Number of slots displaced by inserts.
+    uint64_t n_deletes;       ///< Number of keys deleted.
+    uint64_t n_backshifts;    ///< Number of slots moved back by deletes.
+    uint32_t max_offset;      ///< Upper bound of the offset of any key from it's ideal slot.
+
+    /// Number of lookups with `i + 1` probes. The last bucket also counts the longer lookups.
+    uint64_t probe_length_histogram[FHASHTABLE_STATS_HISTOGRAM_SIZE];
+};
+#endif
+
+/**
+ * @def FHASHTABLE_PARALLEL
+ * @brief Generate `parallel_init`, `parallel_clear`, `parallel_copy` and
+ *        `parallel_for_each_range`, which split the slots into ranges over
+ *        several threads.
+ *
+ * The threads are started with `pthread_create` per call, and the calling
+ * thread works on the first range. Should a thread fail to start, it's range
+ * is done by the calling thread instead.
+ *
+ * A range of slots holds the keys stored in it, so the ranges given to
+ * `parallel_for_each_range` see each key exactly once. `parallel_copy`
+ * instead splits the source by ideal slot index: each thread follows the
+ * cluster past the end of it's range to collect the keys which belong to it,
+ * and skips the keys at the start of it's range which belong to the range
+ * before. Each thread then only writes to the destination slots for it's own
+ * ideal indicies, and the keys pushed past them are inserted afterwards by
+ * the calling thread.
+ *
+ * Requires POSIX threads (`-pthread`). This only needs to be defined
+ * alongside `FUNCTION_DEFINITIONS`. Can be combined with the other modes.
+ */
+#ifdef FHASHTABLE_PARALLEL
+#endif
+
+/**
+ * @def FHASHTABLE_MULTIMAP
+ * @brief Allow a key to be stored several times, and generate
+ *        `insert_multi`, `equal_range`, `count_key` and `delete_all`.
+ *
+ * The slots of equal keys have the same ideal index, and are kept next to
+ * each other: an insert shifts the following slots of the cluster along
+ * rather than swapping it's way past slots of the same ideal index, and
+ * `insert_multi` places a key right after the slots already holding it. The
+ * values of a key are then found with one probe sequence, and read from
+ * consecutive slots (wrapping around the end of the slots) with
+ * `FHASHTABLE_EQUAL_RANGE_FOR_EACH`, without a list allocated per key.
+ * `delete_all` moves the following slots back once, by up to the number of
+ * slots deleted.
+ *
+ * The single-key operations (`get_value`, `update`, `delete`, ...) act on the
+ * first slot of a key. `insert` and `build_from_arrays` still take distinct
+ * keys. This only needs to be defined alongside `FUNCTION_DEFINITIONS`. Can be
+ * combined with the other modes.
+ */
+#ifdef FHASHTABLE_MULTIMAP
+#endif
+
+/**
+ * @def FHASHTABLE_PARALLEL_MAX_THREADS
+ * @brief Upper limit of the number of threads used by the parallel
+ *        operations.
+ */
+#ifndef FHASHTABLE_PARALLEL_MAX_THREADS
+#define FHASHTABLE_PARALLEL_MAX_THREADS (64)
+#endif
+
+/**
+ * @def FHASHTABLE_HASH_ID
+ * @brief Identifies `HASH_FUNCTION` in saved files. Should be changed whenever
+ *        `HASH_FUNCTION` changes, so files saved with the old hash function are
+ *        rejected by `map_from_file` instead of giving wrong lookups.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef FHASHTABLE_HASH_ID
+#define FHASHTABLE_HASH_ID (0)
+#endif
+
+/**
+ * @def FHASHTABLE_FILE_MAGIC
+ * @brief First 8 bytes of a saved hashtable file. Also tells the byte order
+ *        apart.
+ */
+#ifndef FHASHTABLE_FILE_MAGIC
+#define FHASHTABLE_FILE_MAGIC (UINT64_C(0x31454C4241544846))
+
+/**
+ * @def FHASHTABLE_FILE_VERSION
+ * @brief Version of the saved hashtable file format.
+ */
+#define FHASHTABLE_FILE_VERSION (1)
+
+/**
+ * @brief Header of a saved hashtable file. The hashtable struct follows
+ *        directly after it.
+ *
+ * It's size keeps the hashtable struct aligned in a page-aligned mapping.
+ */
+struct fhashtable_file_header {
+    uint64_t magic;       ///< `FHASHTABLE_FILE_MAGIC`.
+    uint32_t version;     ///< `FHASHTABLE_FILE_VERSION`.
+    uint32_t layout;      ///< Layout modes and control group width.
+    uint64_t key_size;    ///< `sizeof(KEY_TYPE)`.
+    uint64_t value_size;  ///< `sizeof(VALUE_TYPE)`.
+    uint64_t hash_id;     ///< `FHASHTABLE_HASH_ID`.
+    uint64_t table_size;  ///< Size of the hashtable struct in bytes.
+    uint64_t reserved[2]; ///< Zero. Pads the header to 64 bytes.
+};
+#endif
+
+/**
+ * @def FHASHTABLE_BATCH_SIZE
+ * @brief Number of keys hashed and prefetched at once by the `_batch`
+ *        lookups.
+ *
+ * Large enough to overlap many cache misses, and small enough for the hashes
+ * and indicies to stay on the stack.
+ */
+#ifndef FHASHTABLE_BATCH_SIZE
+#define FHASHTABLE_BATCH_SIZE (16)
+#endif
+
 /**
  * @def FHASHTABLE_CALC_SIZEOF(fhashtable_name, capacity)
  *
@@ -125,8 +573,26 @@ extern "C" {
  * @return                      The equivalent size.
  */
 #ifndef FHASHTABLE_CALC_SIZEOF
-#define FHASHTABLE_CALC_SIZEOF(fhashtable_name, capacity) \
-    (uint32_t)(offsetof(struct fhashtable_name, slots) + capacity * sizeof(((struct fhashtable_name *)0)->slots[0]))
+#if defined(FHASHTABLE_LAYOUT_SOA)
+#define FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity) \
+    (FHASHTABLE_SIZE_TYPE)(FHASHTABLE_SOA_VALUES_OFFSET(fhashtable_name, capacity) + capacity * sizeof(VALUE_TYPE))
+#elif defined(FHASHTABLE_CONTROL_BYTES)
+#define FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity)                                    \
+    (FHASHTABLE_SIZE_TYPE)(offsetof(struct fhashtable_name, slots)                                 \
+                           + capacity * sizeof(((struct fhashtable_name *)0)->slots[0]) + capacity \
+                           + CONTROL_GROUP_WIDTH)
+#else
+#define FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity)    \
+    (FHASHTABLE_SIZE_TYPE)(offsetof(struct fhashtable_name, slots) \
+                           + capacity * sizeof(((struct fhashtable_name *)0)->slots[0]))
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_CALC_SIZEOF(fhashtable_name, capacity)                      \
+    (FHASHTABLE_SIZE_TYPE)(FHASHTABLE_BITMAP_OFFSET(fhashtable_name, capacity) \
+                           + OCCUPANCY_BITMAP_N_WORDS(capacity) * sizeof(uint64_t))
+#else
+#define FHASHTABLE_CALC_SIZEOF(fhashtable_name, capacity) FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity)
+#endif
 #endif
 
 /**
@@ -140,9 +606,35 @@ extern "C" {
  * @return                      Whether the equivalent size overflows.
  */
 #ifndef FHASHTABLE_CALC_SIZEOF_OVERFLOWS
+#if defined(FHASHTABLE_LAYOUT_SOA) && defined(FHASHTABLE_CONTROL_BYTES)
+#define FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity)                              \
+    (capacity > (FHASHTABLE_SIZE_MAX - offsetof(struct fhashtable_name, offsets) - CONTROL_GROUP_WIDTH \
+                 - alignof(KEY_TYPE) - alignof(VALUE_TYPE))                                            \
+                    / (sizeof(uint32_t) + 1 + sizeof(KEY_TYPE) + sizeof(VALUE_TYPE)))
+#elif defined(FHASHTABLE_LAYOUT_SOA)
+#define FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity)                                          \
+    (capacity                                                                                                      \
+     > (FHASHTABLE_SIZE_MAX - offsetof(struct fhashtable_name, offsets) - alignof(KEY_TYPE) - alignof(VALUE_TYPE)) \
+           / (sizeof(uint32_t) + sizeof(KEY_TYPE) + sizeof(VALUE_TYPE)))
+#elif defined(FHASHTABLE_CONTROL_BYTES)
+#define FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity)                             \
+    (capacity > (FHASHTABLE_SIZE_MAX - offsetof(struct fhashtable_name, slots) - CONTROL_GROUP_WIDTH) \
+                    / (sizeof(((struct fhashtable_name *)0)->slots[0]) + 1))
+#else
+#define FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity) \
+    (capacity                                                             \
+     > (FHASHTABLE_SIZE_MAX - offsetof(struct fhashtable_name, slots))    \
+           / sizeof(((struct fhashtable_name *)0)->slots[0]))
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_CALC_SIZEOF_OVERFLOWS(fhashtable_name, capacity)    \
+    (FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity) \
+     || FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity)        \
+            > FHASHTABLE_SIZE_MAX - alignof(uint64_t) - OCCUPANCY_BITMAP_N_WORDS(capacity) * sizeof(uint64_t))
+#else
 #define FHASHTABLE_CALC_SIZEOF_OVERFLOWS(fhashtable_name, capacity) \
-    (capacity                                                       \
-     > (UINT32_MAX - offsetof(struct fhashtable_name, slots)) / sizeof(((struct fhashtable_name *)0)->slots[0]))
+    FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS(fhashtable_name, capacity)
+#endif
 #endif
 
 /**
@@ -184,6 +676,17 @@ extern "C" {
 #error "Must define VALUE_TYPE."
 #endif
 
+/**
+ * @def COMBINE_VALUES(old_value, value)
+ * @brief Used by `upsert` to combine the value already stored for a key with a
+ *        given value, e.g. `((old_value) + (value))` for counting. Optional.
+ *        `upsert` is only generated if defined.
+ *
+ * Is undefined once header is included.
+ */
+#ifdef COMBINE_VALUES
+#endif
+
 /**
  * @def FUNCTION_LINKAGE
  * @brief Specify function linkage e.g. static inline
@@ -193,14 +696,143 @@ extern "C" {
 #endif
 
 /// @cond DO_NOT_DOCUMENT
-#define FHASHTABLE_TYPE         struct FHASHTABLE_NAME
-#define FHASHTABLE_SLOT_TYPE    struct JOIN(FHASHTABLE_NAME, slot)
-#define FHASHTABLE_SLOT         JOIN(FHASHTABLE_NAME, slot)
-#define FHASHTABLE_INIT         JOIN(FHASHTABLE_NAME, init)
-#define FHASHTABLE_IS_FULL      JOIN(FHASHTABLE_NAME, is_full)
-#define FHASHTABLE_CONTAINS_KEY JOIN(FHASHTABLE_NAME, contains_key)
-#define FHASHTABLE_SWAP_SLOTS   JOIN(internal, JOIN(FHASHTABLE_NAME, swap_slots))
-#define FHASHTABLE_BACKSHIFT    JOIN(internal, JOIN(FHASHTABLE_NAME, backshift))
+#define FHASHTABLE_TYPE          struct FHASHTABLE_NAME
+#define FHASHTABLE_SLOT_TYPE     struct JOIN(FHASHTABLE_NAME, slot)
+#define FHASHTABLE_SLOT          JOIN(FHASHTABLE_NAME, slot)
+#define FHASHTABLE_INIT          JOIN(FHASHTABLE_NAME, init)
+#define FHASHTABLE_IS_FULL       JOIN(FHASHTABLE_NAME, is_full)
+#define FHASHTABLE_CONTAINS_KEY  JOIN(FHASHTABLE_NAME, contains_key)
+#define FHASHTABLE_SWAP_SLOTS    JOIN(internal, JOIN(FHASHTABLE_NAME, swap_slots))
+#define FHASHTABLE_BACKSHIFT     JOIN(internal, JOIN(FHASHTABLE_NAME, backshift))
+#define FHASHTABLE_FIND_INDEX    JOIN(internal, JOIN(FHASHTABLE_NAME, find_index))
+#define FHASHTABLE_FIND_HASHED   JOIN(internal, JOIN(FHASHTABLE_NAME, find_index_hashed))
+#define FHASHTABLE_FIND_BATCH    JOIN(internal, JOIN(FHASHTABLE_NAME, find_index_batch))
+#define FHASHTABLE_INSERT_HASH   JOIN(internal, JOIN(FHASHTABLE_NAME, insert_hash))
+#define FHASHTABLE_PLACE         JOIN(internal, JOIN(FHASHTABLE_NAME, place))
+#define FHASHTABLE_GET_OR_INSERT JOIN(FHASHTABLE_NAME, get_or_insert)
+#define FHASHTABLE_INSERT_MULTI  JOIN(internal, JOIN(FHASHTABLE_NAME, insert_multi_hash))
+#define FHASHTABLE_EQUAL_RANGE   JOIN(FHASHTABLE_NAME, equal_range)
+#define FHASHTABLE_TASK_TYPE     struct JOIN(internal, JOIN(FHASHTABLE_NAME, task))
+#define FHASHTABLE_NO_INDEX      (FHASHTABLE_SIZE_MAX)
+
+#ifdef FHASHTABLE_LARGE_CAPACITY
+#define FHASHTABLE_SIZE_TYPE        size_t
+#define FHASHTABLE_SIZE_MAX         SIZE_MAX
+#define FHASHTABLE_ROUND_UP_POW2(x) ((size_t)round_up_pow2_64(x))
+#else
+#define FHASHTABLE_SIZE_TYPE        uint32_t
+#define FHASHTABLE_SIZE_MAX         UINT32_MAX
+#define FHASHTABLE_ROUND_UP_POW2(x) round_up_pow2_32(x)
+#endif
+
+#ifdef FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_OFFSET_UNIT          ((uint32_t)1 << 16)
+#define FHASHTABLE_FINGERPRINT_MASK     (FHASHTABLE_OFFSET_UNIT - 1)
+#define FHASHTABLE_FINGERPRINT_OF(hash) ((uint32_t)(hash) >> 16)
+#else
+#define FHASHTABLE_OFFSET_UNIT          ((uint32_t)1)
+#define FHASHTABLE_FINGERPRINT_MASK     ((uint32_t)0)
+#define FHASHTABLE_FINGERPRINT_OF(hash) ((uint32_t)0)
+#endif
+#define FHASHTABLE_DISTANCE(offset) ((offset) / FHASHTABLE_OFFSET_UNIT)
+
+#ifdef FHASHTABLE_MULTIMAP
+// a slot is also placed before the slots of the same ideal index, so the following slots are shifted along in order:
+#define FHASHTABLE_DISPLACES(distance, other_distance) ((distance) >= (other_distance))
+// the keys copied over may have been stored several times, and are placed after the slots holding them already:
+#define FHASHTABLE_INSERT_COPY FHASHTABLE_INSERT_MULTI
+#else
+#define FHASHTABLE_DISPLACES(distance, other_distance) ((distance) > (other_distance))
+#define FHASHTABLE_INSERT_COPY                         FHASHTABLE_INSERT_HASH
+#endif
+
+#if defined(__GNUC__)
+#define FHASHTABLE_PREFETCH(ptr) __builtin_prefetch((ptr))
+#else
+#define FHASHTABLE_PREFETCH(ptr) ((void)(ptr))
+#endif
+
+#ifdef FHASHTABLE_STATS
+// lookups only take a const pointer, but still count:
+#define FHASHTABLE_STATS_ADD(self, member, n) ((void)(((FHASHTABLE_TYPE *)(self))->stats.member += (n)))
+#define FHASHTABLE_STATS_LOOKUP(self, n_probes)                                                         \
+    (FHASHTABLE_STATS_ADD(self, n_lookups, 1), FHASHTABLE_STATS_ADD(self, n_lookup_probes, (n_probes)), \
+     FHASHTABLE_STATS_ADD(self,                                                                         \
+                          probe_length_histogram[(n_probes) < FHASHTABLE_STATS_HISTOGRAM_SIZE           \
+                                                     ? (n_probes) - 1                                   \
+                                                     : FHASHTABLE_STATS_HISTOGRAM_SIZE - 1],            \
+                          1))
+#define FHASHTABLE_STATS_OFFSET(self, offset)                                          \
+    ((self)->stats.max_offset = FHASHTABLE_DISTANCE(offset) > (self)->stats.max_offset \
+                                    ? FHASHTABLE_DISTANCE(offset)                      \
+                                    : (self)->stats.max_offset)
+#else
+#define FHASHTABLE_STATS_ADD(self, member, n)   ((void)0)
+#define FHASHTABLE_STATS_LOOKUP(self, n_probes) ((void)0)
+#define FHASHTABLE_STATS_OFFSET(self, offset)   ((void)0)
+#endif
+
+#define FHASHTABLE_LOAD_SLOT     JOIN(internal, JOIN(FHASHTABLE_NAME, load_slot))
+#define FHASHTABLE_STORE_SLOT    JOIN(internal, JOIN(FHASHTABLE_NAME, store_slot))
+
+#define FHASHTABLE_ALIGN_UP(size, alignment) (((size) + (alignment) - 1) / (alignment) * (alignment))
+
+#ifdef FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_OFFSET(self, index)       ((self)->offsets[(index)])
+#define FHASHTABLE_KEY(self, index)          ((self)->keys[(index)])
+#define FHASHTABLE_VALUE(self, index)        ((self)->values[(index)])
+#define FHASHTABLE_SLOTS_OFFSET              offsetof(FHASHTABLE_TYPE, offsets)
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_LAYOUT_FOR_EACH FHASHTABLE_SOA_BITMAP_FOR_EACH
+#else
+#define FHASHTABLE_LAYOUT_FOR_EACH FHASHTABLE_SOA_FOR_EACH
+#endif
+#define FHASHTABLE_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define FHASHTABLE_ALIGNMENT \
+    FHASHTABLE_MAX(alignof(FHASHTABLE_TYPE), FHASHTABLE_MAX(alignof(KEY_TYPE), alignof(VALUE_TYPE)))
+#ifdef FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_SOA_KEYS_OFFSET(fhashtable_name, capacity)                                              \
+    FHASHTABLE_ALIGN_UP(offsetof(struct fhashtable_name, offsets) + capacity * sizeof(uint32_t) + capacity \
+                            + CONTROL_GROUP_WIDTH,                                                         \
+                        alignof(KEY_TYPE))
+#else
+#define FHASHTABLE_SOA_KEYS_OFFSET(fhashtable_name, capacity) \
+    FHASHTABLE_ALIGN_UP(offsetof(struct fhashtable_name, offsets) + capacity * sizeof(uint32_t), alignof(KEY_TYPE))
+#endif
+#define FHASHTABLE_SOA_VALUES_OFFSET(fhashtable_name, capacity)                                              \
+    FHASHTABLE_ALIGN_UP(FHASHTABLE_SOA_KEYS_OFFSET(fhashtable_name, capacity) + capacity * sizeof(KEY_TYPE), \
+                        alignof(VALUE_TYPE))
+#else
+#define FHASHTABLE_OFFSET(self, index) ((self)->slots[(index)].offset)
+#define FHASHTABLE_KEY(self, index)    ((self)->slots[(index)].key)
+#define FHASHTABLE_VALUE(self, index)  ((self)->slots[(index)].value)
+#define FHASHTABLE_SLOTS_OFFSET        offsetof(FHASHTABLE_TYPE, slots)
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_LAYOUT_FOR_EACH FHASHTABLE_BITMAP_FOR_EACH
+#else
+#define FHASHTABLE_LAYOUT_FOR_EACH FHASHTABLE_FOR_EACH
+#endif
+#define FHASHTABLE_ALIGNMENT alignof(FHASHTABLE_TYPE)
+#endif
+
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_BITMAP_OFFSET(fhashtable_name, capacity) \
+    FHASHTABLE_ALIGN_UP((size_t)FHASHTABLE_CALC_SLOTS_SIZEOF(fhashtable_name, capacity), alignof(uint64_t))
+#define FHASHTABLE_SET_OCCUPIED(self, index)   ((self)->occupied[(index) / 64] |= UINT64_C(1) << ((index) % 64))
+#define FHASHTABLE_CLEAR_OCCUPIED(self, index) ((self)->occupied[(index) / 64] &= ~(UINT64_C(1) << ((index) % 64)))
+#else
+#define FHASHTABLE_SET_OCCUPIED(self, index)   ((void)0)
+#define FHASHTABLE_CLEAR_OCCUPIED(self, index) ((void)0)
+#endif
+
+#ifdef FHASHTABLE_CONTROL_BYTES
+#ifdef FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_CTRL_BYTES(self) ((uint8_t *)&(self)->offsets[(self)->capacity])
+#else
+#define FHASHTABLE_CTRL_BYTES(self) ((uint8_t *)&(self)->slots[(self)->capacity])
+#endif
+#define FHASHTABLE_SET_CTRL JOIN(internal, JOIN(FHASHTABLE_NAME, set_ctrl))
+#endif
 /// @endcond
 
 // }}}
@@ -218,10 +850,11 @@ struct FHASHTABLE_NAME;
 
 /**
  * @brief Generated hashtable slot struct type for a given `KEY_TYPE` and
- *        `VALUE_TYPE`.
+ *        `VALUE_TYPE`. With `FHASHTABLE_LAYOUT_SOA` only used to move slots
+ *        around.
  */
 struct JOIN(FHASHTABLE_NAME, slot) {
-    uint32_t offset;  ///< Offset from the ideal slot index.
+    uint32_t offset;  ///< Offset from the ideal slot index (and the key fingerprint, if enabled).
     KEY_TYPE key;     ///< The key in this slot
     VALUE_TYPE value; ///< The value in this slot
 };
@@ -230,11 +863,33 @@ struct JOIN(FHASHTABLE_NAME, slot) {
  * @brief Generated hashtable struct type for a given `KEY_TYPE` and
  *        `VALUE_TYPE`.
  */
+#ifdef FHASHTABLE_LAYOUT_SOA
+struct FHASHTABLE_NAME {
+    FHASHTABLE_SIZE_TYPE count;    ///< Number of non-empty slots.
+    FHASHTABLE_SIZE_TYPE capacity; ///< Number of slots.
+    KEY_TYPE *keys;                ///< Array of keys. Placed after the offsets.
+    VALUE_TYPE *values;            ///< Array of values. Placed after the keys.
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    uint64_t *occupied;            ///< Bitmap of the non-empty slots. Placed after the values.
+#endif
+#ifdef FHASHTABLE_STATS
+    struct fhashtable_stats stats; ///< Probe counters.
+#endif
+    uint32_t offsets[];            ///< Array of slot offsets.
+};
+#else
 struct FHASHTABLE_NAME {
-    uint32_t count;               ///< Number of non-empty slots.
-    uint32_t capacity;            ///< Number of slots.
-    FHASHTABLE_SLOT_TYPE slots[]; ///< Array of slots.
+    FHASHTABLE_SIZE_TYPE count;    ///< Number of non-empty slots.
+    FHASHTABLE_SIZE_TYPE capacity; ///< Number of slots.
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    uint64_t *occupied;            ///< Bitmap of the non-empty slots. Placed after the slots.
+#endif
+#ifdef FHASHTABLE_STATS
+    struct fhashtable_stats stats; ///< Probe counters.
+#endif
+    FHASHTABLE_SLOT_TYPE slots[];  ///< Array of slots.
 };
+#endif
 
 #endif
 
@@ -248,7 +903,8 @@ struct FHASHTABLE_NAME {
  * @param[in] self              Hashtable pointer
  * @param[in] pow2_capacity     Power of 2 capacity.
  */
-FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, init)(FHASHTABLE_TYPE *self, const uint32_t pow2_capacity);
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, init)(FHASHTABLE_TYPE *self,
+                                                              const FHASHTABLE_SIZE_TYPE pow2_capacity);
 
 /**
  * @brief Create an hashtable with a given capacity with a custom allocator.
@@ -260,11 +916,11 @@ FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, init)(FHASHTABLE_TYPE *s
  * @return                      A pointer to the queue.
  * @retval NULL
  *   @li                        If allocate returns NULL.
- *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
- *                              overflows.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FHASHTABLE_LARGE_CAPACITY`) or the equivalent size overflows.
  */
 FUNCTION_LINKAGE FHASHTABLE_TYPE *
-    JOIN(FHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+    JOIN(FHASHTABLE_NAME, create_custom)(const FHASHTABLE_SIZE_TYPE min_capacity, void *context_ptr,
                                          void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
 
 /**
@@ -275,10 +931,10 @@ FUNCTION_LINKAGE FHASHTABLE_TYPE *
  * @return                      A pointer to the queue.
  * @retval NULL
  *   @li                        If malloc fails.
- *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
- *                              overflows.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FHASHTABLE_LARGE_CAPACITY`) or the equivalent size overflows.
  */
-FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, create)(const uint32_t min_capacity);
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, create)(const FHASHTABLE_SIZE_TYPE min_capacity);
 
 /**
  * @brief Destroy an hashtable struct and free the underlying memory with
@@ -376,6 +1032,54 @@ FUNCTION_LINKAGE VALUE_TYPE JOIN(FHASHTABLE_NAME, get_value)(const FHASHTABLE_TY
  */
 FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, search)(FHASHTABLE_TYPE *self, const KEY_TYPE key);
 
+/**
+ * @brief Check if the hashtable contains each key in an array.
+ *
+ * The keys are handled `FHASHTABLE_BATCH_SIZE` at a time: all of them are
+ * hashed and their slots prefetched before any probe is resolved, so the cache
+ * misses overlap instead of happening one after another.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] n_keys            Number of keys.
+ * @param[in] keys              Array of `n_keys` keys.
+ * @param[out] results          Array of `n_keys` booleans indicating whether the
+ *                              hashtable contains the corresponding key.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, contains_key_batch)(const FHASHTABLE_TYPE *self,
+                                                                const FHASHTABLE_SIZE_TYPE n_keys, const KEY_TYPE *keys,
+                                                                bool *results);
+
+/**
+ * @brief From an array of keys, get the pointers to the corresponding values
+ *        in the hashtable. See `contains_key_batch` for how it's done.
+ *
+ * @note The returned pointers are **not** garanteed to point to the same
+ *       values if the hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] n_keys            Number of keys.
+ * @param[in] keys              Array of `n_keys` keys.
+ * @param[out] value_ptrs       Array of `n_keys` pointers to the corresponding
+ *                              values. NULL for keys not in the hashtable.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, get_value_mut_batch)(FHASHTABLE_TYPE *self,
+                                                                 const FHASHTABLE_SIZE_TYPE n_keys,
+                                                                 const KEY_TYPE *keys, VALUE_TYPE **value_ptrs);
+
+/**
+ * @brief From an array of keys, get the copies of the corresponding values in
+ *        the hashtable. See `contains_key_batch` for how it's done.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] n_keys            Number of keys.
+ * @param[in] keys              Array of `n_keys` keys.
+ * @param[in] default_value     The value given for keys not in the hashtable.
+ * @param[out] values           Array of `n_keys` corresponding values.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, get_value_batch)(const FHASHTABLE_TYPE *self,
+                                                             const FHASHTABLE_SIZE_TYPE n_keys, const KEY_TYPE *keys,
+                                                             VALUE_TYPE default_value, VALUE_TYPE *values);
+
 /**
  * @brief Insert a non-duplicate key and it's corresponding value inside the
  *        hashtable.
@@ -390,6 +1094,8 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert)(FHASHTABLE_TYPE *self, KEY_T
  * @brief Update a key's corresponding value inside the hashtable. Allows
  *        duplicates.
  *
+ * @note The hashtable may not be full if it does not contain the key.
+ *
  * @param[in] self              The hashtable pointer.
  * @param[in] key               The key.
  * @param[in] value             The value.
@@ -397,18 +1103,52 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert)(FHASHTABLE_TYPE *self, KEY_T
 FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, update)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
 
 /**
- * @brief Delete a key and it's corresponding value from the hashtable.
+ * @brief Get the pointer to the value of a key, and insert the key with a
+ *        given value first if it's not in the hashtable. Only probes once.
+ *
+ * @note The returned pointer is **not** garanteed to point to the same value if
+ *       the hashtable is modified.
  *
  * @param[in] self              The hashtable pointer.
  * @param[in] key               The key.
+ * @param[in] default_value     The value inserted if the key is not in the hashtable.
+ * @param[out] inserted_ptr     Set to whether the key was inserted.
  *
- * @return A boolean indicating whether the key was previously contained in the
- *         hashtable.
+ * @return                      A pointer to the corresponding value.
+ * @retval NULL                 If the key was not in the hashtable and the hashtable is full.
  */
-FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, delete)(FHASHTABLE_TYPE *self, const KEY_TYPE key);
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, get_or_insert)(FHASHTABLE_TYPE *self, KEY_TYPE key,
+                                                                  VALUE_TYPE default_value, bool *inserted_ptr);
 
+#ifdef COMBINE_VALUES
 /**
- * @brief Clear an existing hashtable and flag all slots as empty.
+ * @brief Insert a key with a given value, or if the key is already in the
+ *        hashtable, set it's value to `COMBINE_VALUES(old_value, value)`. Only
+ *        probes once.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      A pointer to the resulting value.
+ * @retval NULL                 If the key was not in the hashtable and the hashtable is full.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, upsert)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+#endif
+
+/**
+ * @brief Delete a key and it's corresponding value from the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashtable.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, delete)(FHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashtable and flag all slots as empty.
  *
  * @param[in] self              The pointer of the hashtable to clear.
  */
@@ -417,12 +1157,250 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, clear)(FHASHTABLE_TYPE *self);
 /**
  * @brief Copy the values from a source hashtable to a destination hashtable.
  *
+ * With the same capacity, the slots are copied as they are with `memcpy`. With
+ * twice the capacity, each key either keeps it's ideal slot index or moves to
+ * the upper half, so the keys are placed in a single pass over the source
+ * slots without any robin hood swaps. Otherwise the keys are inserted one by
+ * one, but without looking them up first.
+ *
  * @param[out] dest_ptr         The destination hashtable.
  * @param[in] src_ptr           The source hashtable.
  */
 FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest_ptr,
                                                   const FHASHTABLE_TYPE *restrict src_ptr);
 
+/**
+ * @brief Insert the keys and values of two arrays into an empty hashtable in
+ *        bulk, with a custom allocator for the temporary buffer.
+ *
+ * The keys are partitioned by the upper bits of their ideal slot index, and
+ * then counted per ideal slot within each partition. Each key is stored
+ * directly at it's final slot, without the robin hood swaps of `insert`, and
+ * the slots are written one cache-sized window at a time. Only the keys
+ * wrapping around the end of the slots are inserted one by one. Takes
+ * O(n + capacity) time, and a temporary copy of the keys and values.
+ *
+ * @param[in] self              The hashtable pointer. Must be empty.
+ * @param[in] keys              Array of `n` distinct keys.
+ * @param[in] values            Array of `n` values.
+ * @param[in] n                 Number of keys. At most the capacity.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ * @param[in] deallocate        Deallocate function.
+ *
+ * @return                      Whether the keys were inserted.
+ * @retval false                If allocate returns NULL. The hashtable is left empty.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, build_from_arrays_custom)(
+    FHASHTABLE_TYPE *self, KEY_TYPE const *keys, VALUE_TYPE const *values, const FHASHTABLE_SIZE_TYPE n,
+    void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Insert the keys and values of two arrays into an empty hashtable in
+ *        bulk, with malloc() and free() for the temporary buffer.
+ *
+ * @param[in] self              The hashtable pointer. Must be empty.
+ * @param[in] keys              Array of `n` distinct keys.
+ * @param[in] values            Array of `n` values.
+ * @param[in] n                 Number of keys. At most the capacity.
+ *
+ * @return                      Whether the keys were inserted.
+ * @retval false                If malloc fails. The hashtable is left empty.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, build_from_arrays)(FHASHTABLE_TYPE *self, KEY_TYPE const *keys,
+                                                               VALUE_TYPE const *values, const FHASHTABLE_SIZE_TYPE n);
+
+#ifdef FHASHTABLE_MULTIMAP
+/**
+ * @brief Insert a key and a value inside the hashtable, whether or not the
+ *        key is already in it. The key is placed after the slots already
+ *        holding it.
+ *
+ * @param[in] self              The hashtable pointer. Must not be full.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert_multi)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Find the consecutive slots holding a key. The slots wrap around the
+ *        end of the slots, and are iterated over with
+ *        `FHASHTABLE_EQUAL_RANGE_FOR_EACH`.
+ *
+ * @note The range is **not** garanteed to hold the same values if the
+ *       hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[out] first_index_ptr  Set to the first slot index, if the key is in the hashtable.
+ *
+ * @return                      The number of slots holding the key.
+ */
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, equal_range)(const FHASHTABLE_TYPE *self,
+                                                                         const KEY_TYPE key,
+                                                                         FHASHTABLE_SIZE_TYPE *first_index_ptr);
+
+/**
+ * @brief Count the number of times a key is stored in the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      The number of slots holding the key.
+ */
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, count_key)(const FHASHTABLE_TYPE *self,
+                                                                       const KEY_TYPE key);
+
+/**
+ * @brief Delete a key and all of it's values from the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      The number of slots deleted.
+ */
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, delete_all)(FHASHTABLE_TYPE *self, const KEY_TYPE key);
+#endif
+
+#ifdef FHASHTABLE_STATS
+
+/**
+ * @brief Get a copy of the probe counters. Only defined with
+ *        `FHASHTABLE_STATS`.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      The probe counters.
+ */
+FUNCTION_LINKAGE struct fhashtable_stats JOIN(FHASHTABLE_NAME, get_stats)(const FHASHTABLE_TYPE *self);
+
+/**
+ * @brief Zero the probe counters, and recompute the largest offset of any key
+ *        exactly. Only defined with `FHASHTABLE_STATS`.
+ *
+ * Takes O(capacity) time. The largest offset only grows with inserts
+ * otherwise, and this tightens it after deletes.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, reset_stats)(FHASHTABLE_TYPE *self);
+
+#endif
+
+#ifdef FHASHTABLE_PARALLEL
+
+/**
+ * @brief Initialize a hashtable struct with it's slots flagged as empty over
+ *        several threads. Only defined with `FHASHTABLE_PARALLEL`.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] pow2_capacity     The power of 2 capacity. Must match the allocated size.
+ * @param[in] n_threads         Number of threads. At most `FHASHTABLE_PARALLEL_MAX_THREADS` are used.
+ *
+ * @return                      The given hashtable pointer.
+ */
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, parallel_init)(FHASHTABLE_TYPE *self,
+                                                                       const FHASHTABLE_SIZE_TYPE pow2_capacity,
+                                                                       const size_t n_threads);
+
+/**
+ * @brief Clear an existing hashtable over several threads. Only defined with
+ *        `FHASHTABLE_PARALLEL`.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ * @param[in] n_threads         Number of threads. At most `FHASHTABLE_PARALLEL_MAX_THREADS` are used.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_clear)(FHASHTABLE_TYPE *self, const size_t n_threads);
+
+/**
+ * @brief Copy the values from a source hashtable to a destination hashtable
+ *        over several threads. Only defined with `FHASHTABLE_PARALLEL`.
+ *
+ * With equal capacities the slots are copied as is. Otherwise the keys are
+ * rehashed with `HASH_FUNCTION`.
+ *
+ * @param[out] dest_ptr         The destination hashtable. Must be empty.
+ * @param[in] src_ptr           The source hashtable.
+ * @param[in] n_threads         Number of threads. At most `FHASHTABLE_PARALLEL_MAX_THREADS` are used.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_copy)(FHASHTABLE_TYPE *restrict dest_ptr,
+                                                           const FHASHTABLE_TYPE *restrict src_ptr,
+                                                           const size_t n_threads);
+
+/**
+ * @brief Split the slot indicies into contiguous ranges, and call a function
+ *        on each range from it's own thread. Only defined with
+ *        `FHASHTABLE_PARALLEL`.
+ *
+ * Together the ranges cover `[0, capacity)` exactly once. The function may
+ * iterate it's range with `FHASHTABLE_FOR_EACH_RANGE`, and reduce into a
+ * result indexed by `thread_index` in the context.
+ *
+ * @warning The hashtable may not be modified until this returns.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] n_threads         Number of threads. At most `FHASHTABLE_PARALLEL_MAX_THREADS` are used.
+ * @param[in] fn                Function to call with the context, the thread index in `[0, n_threads)`, and the
+ *                              range of slot indicies `[begin, end)`.
+ * @param[in] context_ptr       Context passed to `fn`.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_for_each_range)(
+    const FHASHTABLE_TYPE *self, const size_t n_threads,
+    void (*fn)(void *context_ptr, size_t thread_index, FHASHTABLE_SIZE_TYPE begin, FHASHTABLE_SIZE_TYPE end),
+    void *context_ptr);
+
+#endif
+
+#ifdef FHASHTABLE_PERSIST
+
+/**
+ * @brief Write a file header and the hashtable struct to a file descriptor.
+ *        Only defined with `FHASHTABLE_PERSIST`.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] fd                File descriptor open for writing, positioned at
+ *                              the start of the file.
+ *
+ * @return                      Whether everything was written.
+ * @retval false                If `write` failed. `errno` is set by it.
+ */
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, save_to_fd)(const FHASHTABLE_TYPE *self, const int fd);
+
+/**
+ * @brief Map a hashtable saved with `save_to_fd` into memory. Only defined with
+ *        `FHASHTABLE_PERSIST`.
+ *
+ * The slots are only read from the file as they are accessed, so the hashtable
+ * is usable right away regardless of it's size.
+ *
+ * @note The mapping is private: modifications are never written back to the
+ *       file, and the file should not be modified while it is mapped.
+ *
+ * @param[in] path              Path of the file.
+ * @param[in] writable          Whether the hashtable may be modified (copy-on-write). Otherwise the mapping is
+ *                              read-only, and only the non-mutating operations may be used.
+ *
+ * @return                      A pointer to the hashtable. Must be released with `unmap`.
+ * @retval NULL
+ *   @li                        If the file could not be opened or mapped.
+ *   @li                        If the file header does not match this instantiation, or the file is truncated.
+ *   @li                        If `writable` is false with `FHASHTABLE_STATS`.
+ */
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, map_from_file)(const char *path, const bool writable);
+
+/**
+ * @brief Unmap a hashtable mapped with `map_from_file`. Only defined with
+ *        `FHASHTABLE_PERSIST`.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, unmap)(FHASHTABLE_TYPE *self);
+
+#endif
+
 // @}}}
 
 // function definitions: {{{
@@ -438,7 +1416,23 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef FHASHTABLE_LARGE_CAPACITY
+#include "round_up_pow2_64.h" // round_up_pow2_64
+#else
 #include "round_up_pow2_32.h" // round_up_pow2_32
+#endif
+
+#ifdef FHASHTABLE_PARALLEL
+#include <pthread.h>
+#endif
+
+#ifdef FHASHTABLE_PERSIST
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 /**
  * @def KEY_IS_EQUAL(a, b)
@@ -470,45 +1464,61 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest
  * Is undefined once header is included.
  *
  * @param key The key.
- * @return The hash of the key as `uint32_t`.
+ * @return The hash of the key as `uint32_t` (or `size_t` with
+ *         `FHASHTABLE_LARGE_CAPACITY`).
  */
 #ifndef HASH_FUNCTION
 #error "Must define HASH_FUNCTION."
 #define HASH_FUNCTION(key) (0)
 #endif
 
-FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, init)(FHASHTABLE_TYPE *self, const uint32_t pow2_capacity)
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, init)(FHASHTABLE_TYPE *self,
+                                                              const FHASHTABLE_SIZE_TYPE pow2_capacity)
 {
     assert(self);
     assert(IS_POW2(pow2_capacity));
 
     self->count = 0;
     self->capacity = pow2_capacity;
+#ifdef FHASHTABLE_LAYOUT_SOA
+    self->keys = (KEY_TYPE *)((char *)self + FHASHTABLE_SOA_KEYS_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+    self->values = (VALUE_TYPE *)((char *)self + FHASHTABLE_SOA_VALUES_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    self->occupied = (uint64_t *)((char *)self + FHASHTABLE_BITMAP_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+    memset(self->occupied, 0, OCCUPANCY_BITMAP_N_WORDS(pow2_capacity) * sizeof(uint64_t));
+#endif
 
-    for (uint32_t i = 0; i < self->capacity; i++) {
-        self->slots[i].offset = FHASHTABLE_EMPTY_SLOT_OFFSET;
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < self->capacity; i++) {
+        FHASHTABLE_OFFSET(self, i) = FHASHTABLE_EMPTY_SLOT_OFFSET;
     }
+#ifdef FHASHTABLE_CONTROL_BYTES
+    memset(FHASHTABLE_CTRL_BYTES(self), CONTROL_GROUP_EMPTY, self->capacity + CONTROL_GROUP_WIDTH);
+#endif
+#ifdef FHASHTABLE_STATS
+    memset(&self->stats, 0, sizeof(self->stats));
+#endif
 
     return self;
 }
 
-FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
-                                                                       void *(*allocate)(void *context_ptr,
-                                                                                         size_t alignment, size_t size))
+FUNCTION_LINKAGE FHASHTABLE_TYPE *
+    JOIN(FHASHTABLE_NAME, create_custom)(const FHASHTABLE_SIZE_TYPE min_capacity, void *context_ptr,
+                                         void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
 {
-    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+    if (min_capacity == 0 || min_capacity > FHASHTABLE_SIZE_MAX / 2 + 1) {
         return NULL;
     }
 
-    const uint32_t capacity = round_up_pow2_32(min_capacity);
+    const FHASHTABLE_SIZE_TYPE capacity = FHASHTABLE_ROUND_UP_POW2(min_capacity);
 
     if (FHASHTABLE_CALC_SIZEOF_OVERFLOWS(FHASHTABLE_NAME, capacity)) {
         return NULL;
     }
 
-    const uint32_t size = FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, capacity);
+    const FHASHTABLE_SIZE_TYPE size = FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, capacity);
 
-    FHASHTABLE_TYPE *self = (FHASHTABLE_TYPE *)allocate(context_ptr, alignof(FHASHTABLE_TYPE), size);
+    FHASHTABLE_TYPE *self = (FHASHTABLE_TYPE *)allocate(context_ptr, FHASHTABLE_ALIGNMENT, size);
 
     if (!self) {
         return NULL;
@@ -529,7 +1539,7 @@ static inline void *JOIN(internal, JOIN(FHASHTABLE_NAME, allocate))(void *contex
 }
 /// @endcond
 
-FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, create)(const uint32_t capacity)
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, create)(const FHASHTABLE_SIZE_TYPE capacity)
 {
     return JOIN(FHASHTABLE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(FHASHTABLE_NAME, allocate)));
 }
@@ -571,255 +1581,657 @@ FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, is_full)(const FHASHTABLE_TYPE *self
     return self->count == self->capacity;
 }
 
-FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, contains_key)(const FHASHTABLE_TYPE *self, const KEY_TYPE key)
+/// @cond DO_NOT_DOCUMENT
+#ifdef FHASHTABLE_CONTROL_BYTES
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, set_ctrl))(FHASHTABLE_TYPE *self,
+                                                                   const FHASHTABLE_SIZE_TYPE index, const uint8_t ctrl)
 {
-    assert(self != NULL);
+    uint8_t *ctrl_bytes = FHASHTABLE_CTRL_BYTES(self);
 
-    const uint32_t key_hash = HASH_FUNCTION(key);
-    const uint32_t index_mask = self->capacity - 1;
+    ctrl_bytes[index] = ctrl;
 
-    uint32_t index = key_hash & index_mask;
-    uint32_t max_possible_offset = 0;
-
-    while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
-
-        const bool below_max = max_possible_offset <= self->slots[index].offset;
-
-        if (!(not_empty && below_max)) {
-            break;
-        }
-
-        if (KEY_IS_EQUAL(self->slots[index].key, key)) {
-            return true;
-        }
-
-        index++;
-        index &= index_mask;
-        max_possible_offset++;
+    // mirror the first group after the end, so groups can be loaded without wrapping around:
+    for (FHASHTABLE_SIZE_TYPE i = index + self->capacity; i < self->capacity + CONTROL_GROUP_WIDTH;
+         i += self->capacity) {
+        ctrl_bytes[i] = ctrl;
     }
-    return false;
 }
 
-FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, get_value_mut)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+static inline FHASHTABLE_SIZE_TYPE
+    JOIN(internal, JOIN(FHASHTABLE_NAME, find_index_hashed))(const FHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             const FHASHTABLE_SIZE_TYPE key_hash)
 {
     assert(self != NULL);
 
-    const uint32_t key_hash = HASH_FUNCTION(key);
-    const uint32_t index_mask = self->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+    const uint8_t tag = CONTROL_GROUP_TAG(key_hash);
+    const uint32_t fingerprint = FHASHTABLE_FINGERPRINT_OF(key_hash);
+    const uint8_t *ctrl_bytes = FHASHTABLE_CTRL_BYTES(self);
 
-    uint32_t index = key_hash & index_mask;
-    uint32_t max_possible_offset = 0;
+    FHASHTABLE_SIZE_TYPE index = key_hash & index_mask;
+    uint32_t group_offset = 0;
 
     while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
+        const uint64_t empty_mask = control_group_match_empty(&ctrl_bytes[index]);
+
+        uint64_t match_mask = control_group_match(&ctrl_bytes[index], tag);
+        if (empty_mask) {
+            match_mask = control_group_mask_before(match_mask, empty_mask);
+        }
 
-        const bool below_max = max_possible_offset <= self->slots[index].offset;
+        while (match_mask) {
+            const FHASHTABLE_SIZE_TYPE match_index = (index + control_group_mask_lowest(match_mask)) & index_mask;
 
-        if (!(not_empty && below_max)) {
+            const bool fingerprint_is_same =
+                (FHASHTABLE_OFFSET(self, match_index) & FHASHTABLE_FINGERPRINT_MASK) == fingerprint;
+
+            if (fingerprint_is_same && KEY_IS_EQUAL(FHASHTABLE_KEY(self, match_index), key)) {
+                FHASHTABLE_STATS_LOOKUP(self, group_offset / CONTROL_GROUP_WIDTH + 1);
+                return match_index;
+            }
+            match_mask = control_group_mask_clear_lowest(match_mask);
+        }
+
+        if (empty_mask) {
             break;
         }
 
-        if (KEY_IS_EQUAL(self->slots[index].key, key)) {
-            return &self->slots[index].value;
+#ifdef FHASHTABLE_STATS
+        // no key is placed further away from it's ideal slot:
+        if (group_offset + CONTROL_GROUP_WIDTH > self->stats.max_offset) {
+            break;
         }
+#endif
 
-        index++;
-        index &= index_mask;
-        max_possible_offset++;
+        // a key is never placed after a slot closer to it's ideal slot than the key would be:
+        const FHASHTABLE_SIZE_TYPE last_index = (index + CONTROL_GROUP_WIDTH - 1) & index_mask;
+        if (FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, last_index)) < group_offset + CONTROL_GROUP_WIDTH - 1) {
+            break;
+        }
+
+        index = (index + CONTROL_GROUP_WIDTH) & index_mask;
+        group_offset += CONTROL_GROUP_WIDTH;
     }
-    return NULL;
+    FHASHTABLE_STATS_LOOKUP(self, group_offset / CONTROL_GROUP_WIDTH + 1);
+    return FHASHTABLE_NO_INDEX;
 }
-
-FUNCTION_LINKAGE VALUE_TYPE JOIN(FHASHTABLE_NAME, get_value)(const FHASHTABLE_TYPE *self, const KEY_TYPE key,
-                                                             VALUE_TYPE default_value)
+#else
+static inline FHASHTABLE_SIZE_TYPE
+    JOIN(internal, JOIN(FHASHTABLE_NAME, find_index_hashed))(const FHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             const FHASHTABLE_SIZE_TYPE key_hash)
 {
     assert(self != NULL);
 
-    const uint32_t key_hash = HASH_FUNCTION(key);
-    const uint32_t index_mask = self->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
 
-    uint32_t index = key_hash & index_mask;
-    uint32_t max_possible_offset = 0;
+    FHASHTABLE_SIZE_TYPE index = key_hash & index_mask;
+    uint32_t max_possible_offset = FHASHTABLE_FINGERPRINT_OF(key_hash);
 
     while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
+        const bool not_empty = FHASHTABLE_OFFSET(self, index) != FHASHTABLE_EMPTY_SLOT_OFFSET;
 
-        const bool below_max = max_possible_offset <= self->slots[index].offset;
+        const bool below_max =
+            FHASHTABLE_DISTANCE(max_possible_offset) <= FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, index));
 
         if (!(not_empty && below_max)) {
             break;
         }
 
-        if (KEY_IS_EQUAL(self->slots[index].key, key)) {
-            return self->slots[index].value;
+        // the key can only be stored with the exact offset (and fingerprint) it would have here:
+        const bool offset_is_same = FHASHTABLE_OFFSET(self, index) == max_possible_offset;
+
+        if (offset_is_same && KEY_IS_EQUAL(FHASHTABLE_KEY(self, index), key)) {
+            FHASHTABLE_STATS_LOOKUP(self, FHASHTABLE_DISTANCE(max_possible_offset) + 1);
+            return index;
         }
 
         index++;
         index &= index_mask;
-        max_possible_offset++;
+        max_possible_offset += FHASHTABLE_OFFSET_UNIT;
     }
-    return default_value;
+    FHASHTABLE_STATS_LOOKUP(self, FHASHTABLE_DISTANCE(max_possible_offset) + 1);
+    return FHASHTABLE_NO_INDEX;
 }
+#endif
 
-FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, search)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+static inline FHASHTABLE_SIZE_TYPE JOIN(internal, JOIN(FHASHTABLE_NAME, find_index))(const FHASHTABLE_TYPE *self,
+                                                                                     const KEY_TYPE key)
 {
-    return JOIN(FHASHTABLE_NAME, get_value_mut)(self, key);
+    return FHASHTABLE_FIND_HASHED(self, key, HASH_FUNCTION(key));
 }
 
-/// @cond DO_NOT_DOCUMENT
-static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, swap_slots))(FHASHTABLE_SLOT_TYPE *a, FHASHTABLE_SLOT_TYPE *b)
+// Find the indicies of up to `FHASHTABLE_BATCH_SIZE` keys. The slots are prefetched before any is probed.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, find_index_batch))(const FHASHTABLE_TYPE *self,
+                                                                           const FHASHTABLE_SIZE_TYPE n_keys,
+                                                                           const KEY_TYPE *keys,
+                                                                           FHASHTABLE_SIZE_TYPE *indicies)
 {
-    FHASHTABLE_SLOT_TYPE temp = *a;
-    *a = *b;
-    *b = temp;
+    assert(self != NULL);
+    assert(n_keys <= FHASHTABLE_BATCH_SIZE);
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+    FHASHTABLE_SIZE_TYPE key_hashes[FHASHTABLE_BATCH_SIZE];
+
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n_keys; i++) {
+        key_hashes[i] = HASH_FUNCTION(keys[i]);
+
+        FHASHTABLE_PREFETCH(&FHASHTABLE_OFFSET(self, key_hashes[i] & index_mask));
+#ifdef FHASHTABLE_LAYOUT_SOA
+        FHASHTABLE_PREFETCH(&FHASHTABLE_KEY(self, key_hashes[i] & index_mask));
+#endif
+#ifdef FHASHTABLE_CONTROL_BYTES
+        FHASHTABLE_PREFETCH(&FHASHTABLE_CTRL_BYTES(self)[key_hashes[i] & index_mask]);
+#endif
+    }
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n_keys; i++) {
+        indicies[i] = FHASHTABLE_FIND_HASHED(self, keys[i], key_hashes[i]);
+    }
 }
 /// @endcond
 
-FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, contains_key)(const FHASHTABLE_TYPE *self, const KEY_TYPE key)
 {
     assert(self != NULL);
-    assert(FHASHTABLE_CONTAINS_KEY(self, key) == false);
-
-    const uint32_t index_mask = self->capacity - 1;
-    const uint32_t key_hash = HASH_FUNCTION(key);
 
-    uint32_t index = key_hash & index_mask;
-    FHASHTABLE_SLOT_TYPE current_slot = {.offset = 0, .key = key, .value = value};
-
-    while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
+    return FHASHTABLE_FIND_INDEX(self, key) != FHASHTABLE_NO_INDEX;
+}
 
-        if (!not_empty) {
-            break;
-        }
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, get_value_mut)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
 
-        if (current_slot.offset > self->slots[index].offset) {
-            FHASHTABLE_SWAP_SLOTS(&self->slots[index], &current_slot);
-        }
+    const FHASHTABLE_SIZE_TYPE index = FHASHTABLE_FIND_INDEX(self, key);
 
-        index++;
-        index &= index_mask;
-        current_slot.offset++;
-    }
-    self->slots[index] = current_slot;
-    self->count++;
+    return index != FHASHTABLE_NO_INDEX ? &FHASHTABLE_VALUE(self, index) : NULL;
 }
 
-FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, update)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+FUNCTION_LINKAGE VALUE_TYPE JOIN(FHASHTABLE_NAME, get_value)(const FHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value)
 {
     assert(self != NULL);
 
-    const uint32_t index_mask = self->capacity - 1;
-    const uint32_t key_hash = HASH_FUNCTION(key);
+    const FHASHTABLE_SIZE_TYPE index = FHASHTABLE_FIND_INDEX(self, key);
 
-    uint32_t index = key_hash & index_mask;
-    FHASHTABLE_SLOT_TYPE current_slot = {.offset = 0, .key = key, .value = value};
+    return index != FHASHTABLE_NO_INDEX ? FHASHTABLE_VALUE(self, index) : default_value;
+}
 
-    while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, search)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    return JOIN(FHASHTABLE_NAME, get_value_mut)(self, key);
+}
 
-        if (!not_empty) {
-            break;
-        }
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, contains_key_batch)(const FHASHTABLE_TYPE *self,
+                                                                const FHASHTABLE_SIZE_TYPE n_keys, const KEY_TYPE *keys,
+                                                                bool *results)
+{
+    assert(self != NULL);
+    assert(n_keys == 0 || (keys != NULL && results != NULL));
 
-        const bool offset_is_same = current_slot.offset == self->slots[index].offset;
+    FHASHTABLE_SIZE_TYPE indicies[FHASHTABLE_BATCH_SIZE];
 
-        const bool key_is_equal = KEY_IS_EQUAL(current_slot.key, self->slots[index].key);
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n_keys; i += FHASHTABLE_BATCH_SIZE) {
+        const FHASHTABLE_SIZE_TYPE n = n_keys - i < FHASHTABLE_BATCH_SIZE ? n_keys - i : FHASHTABLE_BATCH_SIZE;
 
-        if (offset_is_same && key_is_equal) {
-            self->slots[index].value = current_slot.value;
-            return;
-        }
+        FHASHTABLE_FIND_BATCH(self, n, &keys[i], indicies);
 
-        if (current_slot.offset > self->slots[index].offset) {
-            FHASHTABLE_SWAP_SLOTS(&current_slot, &self->slots[index]);
+        for (FHASHTABLE_SIZE_TYPE j = 0; j < n; j++) {
+            results[i + j] = indicies[j] != FHASHTABLE_NO_INDEX;
         }
-
-        index++;
-        index &= index_mask;
-        current_slot.offset++;
     }
-
-    self->slots[index] = current_slot;
-    self->count++;
 }
 
-/// @cond DO_NOT_DOCUMENT
-static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, backshift))(FHASHTABLE_TYPE *self, const uint32_t index_mask,
-                                                                    uint32_t index)
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, get_value_mut_batch)(FHASHTABLE_TYPE *self,
+                                                                 const FHASHTABLE_SIZE_TYPE n_keys,
+                                                                 const KEY_TYPE *keys, VALUE_TYPE **value_ptrs)
 {
-    assert(self);
+    assert(self != NULL);
+    assert(n_keys == 0 || (keys != NULL && value_ptrs != NULL));
 
-    uint32_t next_index = (index + 1) & index_mask;
+    FHASHTABLE_SIZE_TYPE indicies[FHASHTABLE_BATCH_SIZE];
 
-    while (true) {
-        const bool not_empty = self->slots[next_index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n_keys; i += FHASHTABLE_BATCH_SIZE) {
+        const FHASHTABLE_SIZE_TYPE n = n_keys - i < FHASHTABLE_BATCH_SIZE ? n_keys - i : FHASHTABLE_BATCH_SIZE;
 
-        const bool offset_is_non_zero = self->slots[next_index].offset > 0;
+        FHASHTABLE_FIND_BATCH(self, n, &keys[i], indicies);
 
-        if (!(not_empty && offset_is_non_zero)) {
-            break;
+        for (FHASHTABLE_SIZE_TYPE j = 0; j < n; j++) {
+            value_ptrs[i + j] = indicies[j] != FHASHTABLE_NO_INDEX ? &FHASHTABLE_VALUE(self, indicies[j]) : NULL;
         }
-
-        self->slots[index] = self->slots[next_index];
-        self->slots[index].offset--;
-
-        self->slots[next_index].offset = FHASHTABLE_EMPTY_SLOT_OFFSET;
-
-        index = next_index;
-        next_index = (index + 1) & index_mask;
     }
 }
-/// @endcond
 
-FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, delete)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, get_value_batch)(const FHASHTABLE_TYPE *self,
+                                                             const FHASHTABLE_SIZE_TYPE n_keys, const KEY_TYPE *keys,
+                                                             VALUE_TYPE default_value, VALUE_TYPE *values)
 {
     assert(self != NULL);
+    assert(n_keys == 0 || (keys != NULL && values != NULL));
 
-    const uint32_t index_mask = self->capacity - 1;
-    const uint32_t key_hash = HASH_FUNCTION(key);
-
-    uint32_t index = key_hash & index_mask;
-    uint32_t max_possible_offset = 0;
+    FHASHTABLE_SIZE_TYPE indicies[FHASHTABLE_BATCH_SIZE];
 
-    while (true) {
-        const bool not_empty = self->slots[index].offset != FHASHTABLE_EMPTY_SLOT_OFFSET;
-
-        const bool below_max = max_possible_offset <= self->slots[index].offset;
-
-        if (!(not_empty && below_max)) {
-            break;
-        }
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n_keys; i += FHASHTABLE_BATCH_SIZE) {
+        const FHASHTABLE_SIZE_TYPE n = n_keys - i < FHASHTABLE_BATCH_SIZE ? n_keys - i : FHASHTABLE_BATCH_SIZE;
 
-        const bool key_is_equal = KEY_IS_EQUAL(key, self->slots[index].key);
+        FHASHTABLE_FIND_BATCH(self, n, &keys[i], indicies);
 
-        if (!key_is_equal) {
-            index = (index + 1) & index_mask;
-            max_possible_offset++;
-            continue;
+        for (FHASHTABLE_SIZE_TYPE j = 0; j < n; j++) {
+            values[i + j] = indicies[j] != FHASHTABLE_NO_INDEX ? FHASHTABLE_VALUE(self, indicies[j]) : default_value;
         }
-
-        self->slots[index].offset = FHASHTABLE_EMPTY_SLOT_OFFSET;
-        self->count--;
-
-        FHASHTABLE_BACKSHIFT(self, index_mask, index);
-
-        return true;
     }
-    return false;
 }
 
-FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, clear)(FHASHTABLE_TYPE *self)
+/// @cond DO_NOT_DOCUMENT
+static inline FHASHTABLE_SLOT_TYPE JOIN(internal, JOIN(FHASHTABLE_NAME, load_slot))(const FHASHTABLE_TYPE *self,
+                                                                                    const FHASHTABLE_SIZE_TYPE index)
 {
-    assert(self != NULL);
+#ifdef FHASHTABLE_LAYOUT_SOA
+    const FHASHTABLE_SLOT_TYPE slot = {.offset = FHASHTABLE_OFFSET(self, index),
+                                       .key = FHASHTABLE_KEY(self, index),
+                                       .value = FHASHTABLE_VALUE(self, index)};
+    return slot;
+#else
+    return self->slots[index];
+#endif
+}
 
-    for (uint32_t i = 0; i < self->capacity; i++) {
-        self->slots[i].offset = FHASHTABLE_EMPTY_SLOT_OFFSET;
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, store_slot))(FHASHTABLE_TYPE *self,
+                                                                     const FHASHTABLE_SIZE_TYPE index,
+                                                                     const FHASHTABLE_SLOT_TYPE slot)
+{
+#ifdef FHASHTABLE_LAYOUT_SOA
+    FHASHTABLE_OFFSET(self, index) = slot.offset;
+    FHASHTABLE_KEY(self, index) = slot.key;
+    FHASHTABLE_VALUE(self, index) = slot.value;
+#else
+    self->slots[index] = slot;
+#endif
+}
+
+// Swap the slot at an index with the given slot.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, swap_slots))(FHASHTABLE_TYPE *self,
+                                                                     const FHASHTABLE_SIZE_TYPE index,
+                                                                     FHASHTABLE_SLOT_TYPE *slot_ptr)
+{
+    const FHASHTABLE_SLOT_TYPE temp = FHASHTABLE_LOAD_SLOT(self, index);
+    FHASHTABLE_STORE_SLOT(self, index, *slot_ptr);
+    *slot_ptr = temp;
+}
+/// @endcond
+
+/// @cond DO_NOT_DOCUMENT
+
+// Place a slot at an index, which is empty or holds a slot closer to it's ideal index than the given slot. The
+// following slots are displaced as needed.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, place))(FHASHTABLE_TYPE *self, FHASHTABLE_SIZE_TYPE index,
+                                                                const FHASHTABLE_SIZE_TYPE key_hash,
+                                                                FHASHTABLE_SLOT_TYPE current_slot)
+{
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+
+#ifndef FHASHTABLE_CONTROL_BYTES
+    (void)key_hash;
+#else
+    uint8_t current_ctrl = CONTROL_GROUP_TAG(key_hash);
+#endif
+
+    while (true) {
+        const bool not_empty = FHASHTABLE_OFFSET(self, index) != FHASHTABLE_EMPTY_SLOT_OFFSET;
+
+        if (!not_empty) {
+            break;
+        }
+
+        if (FHASHTABLE_DISPLACES(FHASHTABLE_DISTANCE(current_slot.offset),
+                                 FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, index)))) {
+            FHASHTABLE_STATS_OFFSET(self, current_slot.offset);
+            FHASHTABLE_STATS_ADD(self, n_insert_swaps, 1);
+            FHASHTABLE_SWAP_SLOTS(self, index, &current_slot);
+#ifdef FHASHTABLE_CONTROL_BYTES
+            const uint8_t temp_ctrl = FHASHTABLE_CTRL_BYTES(self)[index];
+            FHASHTABLE_SET_CTRL(self, index, current_ctrl);
+            current_ctrl = temp_ctrl;
+#endif
+        }
+
+        index++;
+        index &= index_mask;
+        current_slot.offset += FHASHTABLE_OFFSET_UNIT;
+        assert(FHASHTABLE_DISTANCE(current_slot.offset) < FHASHTABLE_DISTANCE(FHASHTABLE_EMPTY_SLOT_OFFSET));
+    }
+    FHASHTABLE_STATS_OFFSET(self, current_slot.offset);
+    FHASHTABLE_STATS_ADD(self, n_inserts, 1);
+    FHASHTABLE_STORE_SLOT(self, index, current_slot);
+    FHASHTABLE_SET_OCCUPIED(self, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+    FHASHTABLE_SET_CTRL(self, index, current_ctrl);
+#endif
+    self->count++;
+}
+
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, insert_hash))(FHASHTABLE_TYPE *self,
+                                                                      const FHASHTABLE_SIZE_TYPE key_hash, KEY_TYPE key,
+                                                                      VALUE_TYPE value)
+{
+    const FHASHTABLE_SLOT_TYPE slot = {.offset = FHASHTABLE_FINGERPRINT_OF(key_hash), .key = key, .value = value};
+
+    FHASHTABLE_PLACE(self, key_hash & (self->capacity - 1), key_hash, slot);
+}
+
+#ifdef FHASHTABLE_MULTIMAP
+// Insert a key after the slots already holding it, or where insert would place it.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, insert_multi_hash))(FHASHTABLE_TYPE *self,
+                                                                            const FHASHTABLE_SIZE_TYPE key_hash,
+                                                                            KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self->count < self->capacity);
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+
+    FHASHTABLE_SIZE_TYPE index = key_hash & index_mask;
+    uint32_t offset = FHASHTABLE_FINGERPRINT_OF(key_hash);
+
+    // there is an empty slot, so the probing stops before wrapping around:
+    while (FHASHTABLE_OFFSET(self, index) != FHASHTABLE_EMPTY_SLOT_OFFSET) {
+        if (offset == FHASHTABLE_OFFSET(self, index) && KEY_IS_EQUAL(FHASHTABLE_KEY(self, index), key)) {
+            // go past the other slots of the key:
+            do {
+                index++;
+                index &= index_mask;
+                offset += FHASHTABLE_OFFSET_UNIT;
+            } while (offset == FHASHTABLE_OFFSET(self, index) && KEY_IS_EQUAL(FHASHTABLE_KEY(self, index), key));
+            break;
+        }
+
+        // the key would have displaced this slot:
+        if (FHASHTABLE_DISTANCE(offset) > FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, index))) {
+            break;
+        }
+
+        index++;
+        index &= index_mask;
+        offset += FHASHTABLE_OFFSET_UNIT;
+    }
+    FHASHTABLE_STATS_LOOKUP(self, FHASHTABLE_DISTANCE(offset) + 1);
+
+    const FHASHTABLE_SLOT_TYPE slot = {.offset = offset, .key = key, .value = value};
+
+    FHASHTABLE_PLACE(self, index, key_hash, slot);
+}
+#endif
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+    assert(FHASHTABLE_CONTAINS_KEY(self, key) == false);
+
+    FHASHTABLE_INSERT_HASH(self, HASH_FUNCTION(key), key, value);
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, update)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    bool inserted;
+    VALUE_TYPE *value_ptr = FHASHTABLE_GET_OR_INSERT(self, key, value, &inserted);
+
+    assert(value_ptr != NULL);
+
+    if (!inserted) {
+        *value_ptr = value;
+    }
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, get_or_insert)(FHASHTABLE_TYPE *self, KEY_TYPE key,
+                                                                  VALUE_TYPE default_value, bool *inserted_ptr)
+{
+    assert(self != NULL);
+    assert(inserted_ptr != NULL);
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE key_hash = HASH_FUNCTION(key);
+
+    FHASHTABLE_SIZE_TYPE index = key_hash & index_mask;
+    uint32_t offset = FHASHTABLE_FINGERPRINT_OF(key_hash);
+
+    while (true) {
+        const bool not_empty = FHASHTABLE_OFFSET(self, index) != FHASHTABLE_EMPTY_SLOT_OFFSET;
+
+        if (!not_empty) {
+            break;
+        }
+
+        const bool offset_is_same = offset == FHASHTABLE_OFFSET(self, index);
+
+        if (offset_is_same && KEY_IS_EQUAL(FHASHTABLE_KEY(self, index), key)) {
+            FHASHTABLE_STATS_LOOKUP(self, FHASHTABLE_DISTANCE(offset) + 1);
+            *inserted_ptr = false;
+            return &FHASHTABLE_VALUE(self, index);
+        }
+
+        // the key would have displaced this slot:
+        if (FHASHTABLE_DISTANCE(offset) > FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, index))) {
+            break;
+        }
+
+        index++;
+        index &= index_mask;
+        offset += FHASHTABLE_OFFSET_UNIT;
+
+        if (FHASHTABLE_DISTANCE(offset) == self->capacity) {
+            break;
+        }
+    }
+    FHASHTABLE_STATS_LOOKUP(self, FHASHTABLE_DISTANCE(offset) + 1);
+
+    if (self->count == self->capacity) {
+        return NULL;
+    }
+
+    const FHASHTABLE_SLOT_TYPE slot = {.offset = offset, .key = key, .value = default_value};
+
+    FHASHTABLE_PLACE(self, index, key_hash, slot);
+
+    *inserted_ptr = true;
+    return &FHASHTABLE_VALUE(self, index);
+}
+
+#ifdef COMBINE_VALUES
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(FHASHTABLE_NAME, upsert)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    bool inserted;
+    VALUE_TYPE *value_ptr = FHASHTABLE_GET_OR_INSERT(self, key, value, &inserted);
+
+    if (value_ptr != NULL && !inserted) {
+        *value_ptr = COMBINE_VALUES(*value_ptr, value);
+    }
+    return value_ptr;
+}
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, backshift))(FHASHTABLE_TYPE *self,
+                                                                    const FHASHTABLE_SIZE_TYPE index_mask,
+                                                                    FHASHTABLE_SIZE_TYPE index)
+{
+    assert(self);
+
+    FHASHTABLE_SIZE_TYPE next_index = (index + 1) & index_mask;
+
+    while (true) {
+        const bool not_empty = FHASHTABLE_OFFSET(self, next_index) != FHASHTABLE_EMPTY_SLOT_OFFSET;
+
+        const bool offset_is_non_zero = FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, next_index)) > 0;
+
+        if (!(not_empty && offset_is_non_zero)) {
+            break;
+        }
+
+        FHASHTABLE_STORE_SLOT(self, index, FHASHTABLE_LOAD_SLOT(self, next_index));
+        FHASHTABLE_OFFSET(self, index) -= FHASHTABLE_OFFSET_UNIT;
+        FHASHTABLE_STATS_ADD(self, n_backshifts, 1);
+
+        FHASHTABLE_OFFSET(self, next_index) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+        FHASHTABLE_SET_OCCUPIED(self, index);
+        FHASHTABLE_CLEAR_OCCUPIED(self, next_index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+        FHASHTABLE_SET_CTRL(self, index, FHASHTABLE_CTRL_BYTES(self)[next_index]);
+        FHASHTABLE_SET_CTRL(self, next_index, CONTROL_GROUP_EMPTY);
+#endif
+
+        index = next_index;
+        next_index = (index + 1) & index_mask;
+    }
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, delete)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE index = FHASHTABLE_FIND_INDEX(self, key);
+
+    if (index == FHASHTABLE_NO_INDEX) {
+        return false;
+    }
+
+    FHASHTABLE_OFFSET(self, index) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+    FHASHTABLE_CLEAR_OCCUPIED(self, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+    FHASHTABLE_SET_CTRL(self, index, CONTROL_GROUP_EMPTY);
+#endif
+    self->count--;
+    FHASHTABLE_STATS_ADD(self, n_deletes, 1);
+
+    FHASHTABLE_BACKSHIFT(self, index_mask, index);
+
+    return true;
+}
+
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+/// @cond DO_NOT_DOCUMENT
+
+// Flag the non-empty slots in [begin, end) as empty. begin must be a multiple of 64, and end a multiple of 64 or the
+// capacity.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, clear_occupied))(FHASHTABLE_TYPE *self,
+                                                                         const FHASHTABLE_SIZE_TYPE begin,
+                                                                         const FHASHTABLE_SIZE_TYPE end)
+{
+    for (FHASHTABLE_SIZE_TYPE w = begin / 64; w < OCCUPANCY_BITMAP_N_WORDS(end); w++) {
+        for (uint64_t word = self->occupied[w]; word != 0; word &= word - 1) {
+            const FHASHTABLE_SIZE_TYPE index = w * 64 + occupancy_bitmap_lowest(word);
+
+            FHASHTABLE_OFFSET(self, index) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+#ifdef FHASHTABLE_CONTROL_BYTES
+            FHASHTABLE_SET_CTRL(self, index, CONTROL_GROUP_EMPTY);
+#endif
+        }
+        self->occupied[w] = 0;
+    }
+}
+/// @endcond
+#endif
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, clear)(FHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    JOIN(internal, JOIN(FHASHTABLE_NAME, clear_occupied))(self, 0, self->capacity);
+#else
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < self->capacity; i++) {
+        FHASHTABLE_OFFSET(self, i) = FHASHTABLE_EMPTY_SLOT_OFFSET;
     }
+#ifdef FHASHTABLE_CONTROL_BYTES
+    memset(FHASHTABLE_CTRL_BYTES(self), CONTROL_GROUP_EMPTY, self->capacity + CONTROL_GROUP_WIDTH);
+#endif
+#endif
+#ifdef FHASHTABLE_STATS
+    self->stats.max_offset = 0;
+#endif
     self->count = 0;
 }
 
+/// @cond DO_NOT_DOCUMENT
+
+// Copy a hashtable into an empty hashtable of twice the capacity in one pass over the source slots. A key with the
+// ideal index i moves to the ideal index i or i + capacity, so starting at the beginning of a cluster the keys of each
+// half are visited in robin hood order. Splitting a cluster never moves a key further from it's ideal index, so each
+// key goes to the first empty slot after the previous key of the same cluster and half. Returns false if no cluster
+// starts in the source, i.e. all slots hold displaced keys.
+static inline bool JOIN(internal, JOIN(FHASHTABLE_NAME, copy_doubled))(FHASHTABLE_TYPE *restrict dest_ptr,
+                                                                        const FHASHTABLE_TYPE *restrict src_ptr,
+                                                                        const bool has_hash_bits)
+{
+    const FHASHTABLE_SIZE_TYPE src_mask = src_ptr->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE dest_mask = dest_ptr->capacity - 1;
+
+    FHASHTABLE_SIZE_TYPE start = 0;
+    while (start < src_ptr->capacity && FHASHTABLE_OFFSET(src_ptr, start) != FHASHTABLE_EMPTY_SLOT_OFFSET
+           && FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(src_ptr, start)) != 0) {
+        start++;
+    }
+    if (start == src_ptr->capacity) {
+        return false;
+    }
+
+    // the ideal and final index of the last key placed in the lower and the upper half:
+    FHASHTABLE_SIZE_TYPE last_ideal_index[2] = {0, 0};
+    FHASHTABLE_SIZE_TYPE last_index[2] = {0, 0};
+    bool has_last[2] = {false, false};
+
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < src_ptr->capacity; i++) {
+        const FHASHTABLE_SIZE_TYPE src_index = (start + i) & src_mask;
+        const uint32_t src_offset = FHASHTABLE_OFFSET(src_ptr, src_index);
+
+        if (src_offset == FHASHTABLE_EMPTY_SLOT_OFFSET) {
+            continue;
+        }
+
+        KEY_TYPE key = FHASHTABLE_KEY(src_ptr, src_index);
+        const FHASHTABLE_SIZE_TYPE src_ideal_index = (src_index - FHASHTABLE_DISTANCE(src_offset)) & src_mask;
+        const uint32_t fingerprint = src_offset & FHASHTABLE_FINGERPRINT_MASK;
+        const FHASHTABLE_SIZE_TYPE key_hash =
+            has_hash_bits ? (fingerprint << 16) | src_ideal_index : HASH_FUNCTION(key);
+        const FHASHTABLE_SIZE_TYPE ideal_index = key_hash & dest_mask;
+        const size_t half = ideal_index >= src_ptr->capacity ? 1 : 0;
+
+        // continue after the previous key of the same half, if the cluster reaches this ideal index:
+        FHASHTABLE_SIZE_TYPE index = ideal_index;
+        if (has_last[half]
+            && ((ideal_index - last_ideal_index[half]) & dest_mask)
+                   <= ((last_index[half] - last_ideal_index[half]) & dest_mask)) {
+            index = (last_index[half] + 1) & dest_mask;
+        }
+        // the keys of the other half may still be in the way:
+        while (FHASHTABLE_OFFSET(dest_ptr, index) != FHASHTABLE_EMPTY_SLOT_OFFSET) {
+            index = (index + 1) & dest_mask;
+        }
+
+        const uint32_t offset = (uint32_t)((index - ideal_index) & dest_mask) * FHASHTABLE_OFFSET_UNIT + fingerprint;
+        const FHASHTABLE_SLOT_TYPE slot = {.offset = offset, .key = key, .value = FHASHTABLE_VALUE(src_ptr, src_index)};
+        assert(FHASHTABLE_DISTANCE(offset) < FHASHTABLE_DISTANCE(FHASHTABLE_EMPTY_SLOT_OFFSET));
+
+        FHASHTABLE_STORE_SLOT(dest_ptr, index, slot);
+        FHASHTABLE_SET_OCCUPIED(dest_ptr, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+        FHASHTABLE_SET_CTRL(dest_ptr, index, FHASHTABLE_CTRL_BYTES(src_ptr)[src_index]);
+#endif
+        FHASHTABLE_STATS_OFFSET(dest_ptr, offset);
+        FHASHTABLE_STATS_ADD(dest_ptr, n_inserts, 1);
+        dest_ptr->count++;
+
+        last_ideal_index[half] = ideal_index;
+        last_index[half] = index;
+        has_last[half] = true;
+    }
+    return true;
+}
+/// @endcond
+
 FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest_ptr,
                                                   const FHASHTABLE_TYPE *restrict src_ptr)
 {
@@ -828,15 +2240,865 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest
     assert(src_ptr->capacity <= dest_ptr->capacity);
     assert(dest_ptr->count == 0);
 
-    uint32_t index;
+    if (dest_ptr->capacity == src_ptr->capacity) {
+        // the control bytes and the occupancy bitmap follow the slots, and are copied along:
+        memcpy((char *)dest_ptr + FHASHTABLE_SLOTS_OFFSET, (const char *)src_ptr + FHASHTABLE_SLOTS_OFFSET,
+               FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, src_ptr->capacity) - FHASHTABLE_SLOTS_OFFSET);
+        dest_ptr->count = src_ptr->count;
+#ifdef FHASHTABLE_STATS
+        dest_ptr->stats.max_offset = src_ptr->stats.max_offset;
+#endif
+        FHASHTABLE_STATS_ADD(dest_ptr, n_inserts, src_ptr->count);
+        return;
+    }
+
+    FHASHTABLE_SIZE_TYPE index;
     KEY_TYPE key;
     VALUE_TYPE value;
-    FHASHTABLE_FOR_EACH(src_ptr, index, key, value)
+
+#ifdef FHASHTABLE_FINGERPRINT
+    // the lower hash bits are given by the ideal slot index, and the upper hash bits by the fingerprint:
+#ifdef FHASHTABLE_LARGE_CAPACITY
+    // the fingerprint only covers the lower 32 hash bits:
+    const bool has_hash_bits =
+        src_ptr->capacity >= FHASHTABLE_OFFSET_UNIT && (uint64_t)dest_ptr->capacity <= UINT64_C(1) << 32;
+#else
+    const bool has_hash_bits = src_ptr->capacity >= FHASHTABLE_OFFSET_UNIT;
+#endif
+#else
+    const bool has_hash_bits = false;
+#endif
+
+    if (dest_ptr->capacity / 2 == src_ptr->capacity
+        && JOIN(internal, JOIN(FHASHTABLE_NAME, copy_doubled))(dest_ptr, src_ptr, has_hash_bits)) {
+        return;
+    }
+
+#ifdef FHASHTABLE_FINGERPRINT
+    if (has_hash_bits) {
+        const FHASHTABLE_SIZE_TYPE index_mask = src_ptr->capacity - 1;
+
+        FHASHTABLE_LAYOUT_FOR_EACH(src_ptr, index, key, value)
+        {
+            const uint32_t offset = FHASHTABLE_OFFSET(src_ptr, index);
+            const FHASHTABLE_SIZE_TYPE ideal_index = (index - FHASHTABLE_DISTANCE(offset)) & index_mask;
+            const FHASHTABLE_SIZE_TYPE key_hash = ((offset & FHASHTABLE_FINGERPRINT_MASK) << 16) | ideal_index;
+
+            FHASHTABLE_INSERT_COPY(dest_ptr, key_hash, key, value);
+        }
+        return;
+    }
+#endif
+
+    // the keys are distinct, so unlike insert they are not looked up first (other than to keep the slots of a key
+    // together with FHASHTABLE_MULTIMAP):
+    FHASHTABLE_LAYOUT_FOR_EACH(src_ptr, index, key, value)
     {
-        JOIN(FHASHTABLE_NAME, insert)(dest_ptr, key, value);
+        FHASHTABLE_INSERT_COPY(dest_ptr, HASH_FUNCTION(key), key, value);
+    }
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, build_from_arrays_custom)(
+    FHASHTABLE_TYPE *self, KEY_TYPE const *keys, VALUE_TYPE const *values, const FHASHTABLE_SIZE_TYPE n,
+    void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+    assert(n == 0 || (keys != NULL && values != NULL));
+    assert(self->count == 0);
+    assert(n <= self->capacity);
+
+    // the keys are partitioned by the upper bits of their ideal index first, so the slots written by each partition
+    // stay in the cache:
+    unsigned capacity_bits = 0;
+    while (((FHASHTABLE_SIZE_TYPE)1 << capacity_bits) < self->capacity) {
+        capacity_bits++;
+    }
+    const unsigned partition_bits = capacity_bits <= 12 ? 0 : capacity_bits - 12 < 12 ? capacity_bits - 12 : 12;
+    const unsigned window_bits = capacity_bits - partition_bits;
+    const FHASHTABLE_SIZE_TYPE n_partitions = (FHASHTABLE_SIZE_TYPE)1 << partition_bits;
+    const FHASHTABLE_SIZE_TYPE window_size = (FHASHTABLE_SIZE_TYPE)1 << window_bits;
+
+    // buffer: partition_end[n_partitions + 1], next_index[window_size], key_hashes[n], sorted_hashes[n]
+    const uint64_t buffer_length = (uint64_t)n_partitions + 1 + window_size + 2 * (uint64_t)n;
+
+    if (buffer_length > SIZE_MAX / sizeof(FHASHTABLE_SIZE_TYPE)
+        || (uint64_t)n + 1 > SIZE_MAX / sizeof(FHASHTABLE_SLOT_TYPE)) {
+        return false;
+    }
+
+    FHASHTABLE_SIZE_TYPE *partition_end = (FHASHTABLE_SIZE_TYPE *)allocate(
+        context_ptr, alignof(FHASHTABLE_SIZE_TYPE), sizeof(FHASHTABLE_SIZE_TYPE) * (size_t)buffer_length);
+
+    if (!partition_end) {
+        return false;
+    }
+
+    FHASHTABLE_SLOT_TYPE *sorted_slots = (FHASHTABLE_SLOT_TYPE *)allocate(
+        context_ptr, alignof(FHASHTABLE_SLOT_TYPE), sizeof(FHASHTABLE_SLOT_TYPE) * ((size_t)n + 1));
+
+    if (!sorted_slots) {
+        deallocate(context_ptr, partition_end);
+        return false;
+    }
+
+    FHASHTABLE_SIZE_TYPE *next_index = partition_end + n_partitions + 1;
+    FHASHTABLE_SIZE_TYPE *key_hashes = next_index + window_size;
+    FHASHTABLE_SIZE_TYPE *sorted_hashes = key_hashes + n;
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+
+    memset(partition_end, 0, sizeof(FHASHTABLE_SIZE_TYPE) * (n_partitions + 1));
+
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n; i++) {
+        key_hashes[i] = HASH_FUNCTION(keys[i]);
+        partition_end[((key_hashes[i] & index_mask) >> window_bits) + 1]++;
+    }
+    for (FHASHTABLE_SIZE_TYPE p = 0; p < n_partitions; p++) {
+        partition_end[p + 1] += partition_end[p];
+    }
+
+    // stable, so the keys of the same ideal slot keep their order. The keys and values are moved along, so they are
+    // read in order afterwards:
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n; i++) {
+        const FHASHTABLE_SIZE_TYPE j = partition_end[(key_hashes[i] & index_mask) >> window_bits]++;
+        const FHASHTABLE_SLOT_TYPE slot = {.offset = 0, .key = keys[i], .value = values[i]};
+
+        sorted_slots[j] = slot;
+        sorted_hashes[j] = key_hashes[i];
+    }
+
+    FHASHTABLE_SIZE_TYPE index = 0;
+    FHASHTABLE_SIZE_TYPE n_wrapped = 0;
+
+    for (FHASHTABLE_SIZE_TYPE p = 0; p < n_partitions; p++) {
+        const FHASHTABLE_SIZE_TYPE window_start = p << window_bits;
+        const FHASHTABLE_SIZE_TYPE begin = p == 0 ? 0 : partition_end[p - 1];
+        const FHASHTABLE_SIZE_TYPE end = partition_end[p];
+
+        memset(next_index, 0, sizeof(FHASHTABLE_SIZE_TYPE) * window_size);
+
+        for (FHASHTABLE_SIZE_TYPE j = begin; j < end; j++) {
+            next_index[(sorted_hashes[j] & index_mask) - window_start]++;
+        }
+
+        // the keys of each ideal slot follow those of the previous ideal slots, as robin hood hashing places them:
+        for (FHASHTABLE_SIZE_TYPE w = 0; w < window_size; w++) {
+            const FHASHTABLE_SIZE_TYPE n_keys = next_index[w];
+
+            index = index > window_start + w ? index : window_start + w;
+            next_index[w] = index;
+            index += n_keys;
+        }
+
+        for (FHASHTABLE_SIZE_TYPE j = begin; j < end; j++) {
+            const FHASHTABLE_SIZE_TYPE ideal_index = sorted_hashes[j] & index_mask;
+            const FHASHTABLE_SIZE_TYPE final_index = next_index[ideal_index - window_start]++;
+
+            if (final_index >= self->capacity) {
+                // the unsorted hashes are not needed anymore, and the keys to insert last are noted instead:
+                key_hashes[n_wrapped++] = j;
+                continue;
+            }
+
+            const uint32_t distance = (uint32_t)(final_index - ideal_index);
+
+            sorted_slots[j].offset = distance * FHASHTABLE_OFFSET_UNIT + FHASHTABLE_FINGERPRINT_OF(sorted_hashes[j]);
+            assert(FHASHTABLE_DISTANCE(sorted_slots[j].offset) < FHASHTABLE_DISTANCE(FHASHTABLE_EMPTY_SLOT_OFFSET));
+
+            FHASHTABLE_STORE_SLOT(self, final_index, sorted_slots[j]);
+            FHASHTABLE_SET_OCCUPIED(self, final_index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+            FHASHTABLE_SET_CTRL(self, final_index, CONTROL_GROUP_TAG(sorted_hashes[j]));
+#endif
+            FHASHTABLE_STATS_OFFSET(self, sorted_slots[j].offset);
+            FHASHTABLE_STATS_ADD(self, n_inserts, 1);
+            self->count++;
+        }
+    }
+
+    for (FHASHTABLE_SIZE_TYPE k = 0; k < n_wrapped; k++) {
+        const FHASHTABLE_SIZE_TYPE j = key_hashes[k];
+
+        FHASHTABLE_INSERT_HASH(self, sorted_hashes[j], sorted_slots[j].key, sorted_slots[j].value);
     }
+
+    deallocate(context_ptr, sorted_slots);
+    deallocate(context_ptr, partition_end);
+
+    return true;
+}
+
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, build_from_arrays)(FHASHTABLE_TYPE *self, KEY_TYPE const *keys,
+                                                               VALUE_TYPE const *values, const FHASHTABLE_SIZE_TYPE n)
+{
+    return JOIN(FHASHTABLE_NAME, build_from_arrays_custom)(self, keys, values, n, NULL,
+                                                           JOIN(internal, JOIN(FHASHTABLE_NAME, allocate)),
+                                                           JOIN(internal, JOIN(FHASHTABLE_NAME, deallocate)));
+}
+
+#ifdef FHASHTABLE_MULTIMAP
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, insert_multi)(FHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+    assert(self->count < self->capacity);
+
+    FHASHTABLE_INSERT_MULTI(self, HASH_FUNCTION(key), key, value);
 }
 
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, equal_range)(const FHASHTABLE_TYPE *self,
+                                                                         const KEY_TYPE key,
+                                                                         FHASHTABLE_SIZE_TYPE *first_index_ptr)
+{
+    assert(self != NULL);
+    assert(first_index_ptr != NULL);
+
+    const FHASHTABLE_SIZE_TYPE first_index = FHASHTABLE_FIND_INDEX(self, key);
+
+    if (first_index == FHASHTABLE_NO_INDEX) {
+        return 0;
+    }
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+
+    // the following slots of the key hold the same fingerprint, one slot further away:
+    FHASHTABLE_SIZE_TYPE n = 1;
+    uint32_t offset = FHASHTABLE_OFFSET(self, first_index) + FHASHTABLE_OFFSET_UNIT;
+
+    while (n < self->count) {
+        const FHASHTABLE_SIZE_TYPE index = (first_index + n) & index_mask;
+
+        if (!(offset == FHASHTABLE_OFFSET(self, index) && KEY_IS_EQUAL(FHASHTABLE_KEY(self, index), key))) {
+            break;
+        }
+        n++;
+        offset += FHASHTABLE_OFFSET_UNIT;
+    }
+
+    *first_index_ptr = first_index;
+    return n;
+}
+
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, count_key)(const FHASHTABLE_TYPE *self,
+                                                                       const KEY_TYPE key)
+{
+    FHASHTABLE_SIZE_TYPE first_index;
+
+    return FHASHTABLE_EQUAL_RANGE(self, key, &first_index);
+}
+
+FUNCTION_LINKAGE FHASHTABLE_SIZE_TYPE JOIN(FHASHTABLE_NAME, delete_all)(FHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    FHASHTABLE_SIZE_TYPE first_index;
+    const FHASHTABLE_SIZE_TYPE n = FHASHTABLE_EQUAL_RANGE(self, key, &first_index);
+
+    if (n == 0) {
+        return 0;
+    }
+
+    const FHASHTABLE_SIZE_TYPE index_mask = self->capacity - 1;
+
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < n; i++) {
+        const FHASHTABLE_SIZE_TYPE index = (first_index + i) & index_mask;
+
+        FHASHTABLE_OFFSET(self, index) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+        FHASHTABLE_CLEAR_OCCUPIED(self, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+        FHASHTABLE_SET_CTRL(self, index, CONTROL_GROUP_EMPTY);
+#endif
+    }
+    self->count -= n;
+    FHASHTABLE_STATS_ADD(self, n_deletes, n);
+
+    // move the following slots of the cluster back in one pass, each by up to the number of empty slots before it, but
+    // not past it's ideal index:
+    FHASHTABLE_SIZE_TYPE gap_index = first_index;
+    FHASHTABLE_SIZE_TYPE gap_size = n;
+
+    while (true) {
+        const FHASHTABLE_SIZE_TYPE index = (gap_index + gap_size) & index_mask;
+        const uint32_t offset = FHASHTABLE_OFFSET(self, index);
+
+        if (offset == FHASHTABLE_EMPTY_SLOT_OFFSET || FHASHTABLE_DISTANCE(offset) == 0) {
+            break;
+        }
+
+        const uint32_t distance = FHASHTABLE_DISTANCE(offset);
+        const uint32_t shift = distance < gap_size ? distance : (uint32_t)gap_size;
+        const FHASHTABLE_SIZE_TYPE dest_index = (index - shift) & index_mask;
+
+        FHASHTABLE_STORE_SLOT(self, dest_index, FHASHTABLE_LOAD_SLOT(self, index));
+        FHASHTABLE_OFFSET(self, dest_index) -= shift * FHASHTABLE_OFFSET_UNIT;
+        FHASHTABLE_STATS_ADD(self, n_backshifts, 1);
+
+        FHASHTABLE_OFFSET(self, index) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+        FHASHTABLE_SET_OCCUPIED(self, dest_index);
+        FHASHTABLE_CLEAR_OCCUPIED(self, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+        FHASHTABLE_SET_CTRL(self, dest_index, FHASHTABLE_CTRL_BYTES(self)[index]);
+        FHASHTABLE_SET_CTRL(self, index, CONTROL_GROUP_EMPTY);
+#endif
+
+        // the slots between the old gap and the slot's ideal index stay empty:
+        gap_index = (dest_index + 1) & index_mask;
+        gap_size = shift;
+    }
+
+    return n;
+}
+#endif
+
+#ifdef FHASHTABLE_STATS
+FUNCTION_LINKAGE struct fhashtable_stats JOIN(FHASHTABLE_NAME, get_stats)(const FHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->stats;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, reset_stats)(FHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    memset(&self->stats, 0, sizeof(self->stats));
+
+    for (FHASHTABLE_SIZE_TYPE i = 0; i < self->capacity; i++) {
+        if (FHASHTABLE_OFFSET(self, i) != FHASHTABLE_EMPTY_SLOT_OFFSET) {
+            FHASHTABLE_STATS_OFFSET(self, FHASHTABLE_OFFSET(self, i));
+        }
+    }
+}
+#endif
+
+#ifdef FHASHTABLE_PARALLEL
+
+/// @cond DO_NOT_DOCUMENT
+struct JOIN(internal, JOIN(FHASHTABLE_NAME, task)) {
+    FHASHTABLE_TYPE *dest_ptr;
+    const FHASHTABLE_TYPE *src_ptr;
+    size_t thread_index;
+    FHASHTABLE_SIZE_TYPE begin;
+    FHASHTABLE_SIZE_TYPE end;
+
+    void (*fn)(void *context_ptr, size_t thread_index, FHASHTABLE_SIZE_TYPE begin, FHASHTABLE_SIZE_TYPE end);
+    void *context_ptr;
+    bool clears_all_slots;
+
+    // results of rehash_worker:
+    FHASHTABLE_SIZE_TYPE count;
+    uint32_t max_distance;
+    FHASHTABLE_SLOT_TYPE *pushed_out_slots;
+    size_t n_pushed_out;
+    size_t pushed_out_capacity;
+    bool has_failed;
+};
+
+// Split the indicies [0, n) into contiguous ranges of (almost) the same size, one per task.
+static inline size_t JOIN(internal, JOIN(FHASHTABLE_NAME, split))(FHASHTABLE_TASK_TYPE *tasks,
+                                                                   const FHASHTABLE_SIZE_TYPE n, size_t n_threads)
+{
+    n_threads = n_threads < FHASHTABLE_PARALLEL_MAX_THREADS ? n_threads : FHASHTABLE_PARALLEL_MAX_THREADS;
+    n_threads = n_threads < n ? n_threads : n;
+    n_threads = n_threads > 0 ? n_threads : 1;
+
+    FHASHTABLE_SIZE_TYPE range_size = (FHASHTABLE_SIZE_TYPE)(n / n_threads + (n % n_threads != 0 ? 1 : 0));
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    // no two tasks share a bitmap word:
+    range_size = (range_size + 63) / 64 * 64;
+#endif
+
+    memset(tasks, 0, n_threads * sizeof(*tasks));
+    for (size_t t = 0; t < n_threads; t++) {
+        const FHASHTABLE_SIZE_TYPE begin = (FHASHTABLE_SIZE_TYPE)t * range_size;
+
+        tasks[t].thread_index = t;
+        tasks[t].begin = begin < n ? begin : n;
+        tasks[t].end = n - tasks[t].begin > range_size ? tasks[t].begin + range_size : n;
+    }
+    return n_threads;
+}
+
+// Run the tasks on their own threads, with the first task on the calling thread.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, run_tasks))(FHASHTABLE_TASK_TYPE *tasks, const size_t n_tasks,
+                                                                     void *(*worker)(void *task_ptr))
+{
+    pthread_t threads[FHASHTABLE_PARALLEL_MAX_THREADS];
+    bool is_started[FHASHTABLE_PARALLEL_MAX_THREADS];
+
+    for (size_t t = 1; t < n_tasks; t++) {
+        is_started[t] = pthread_create(&threads[t], NULL, worker, &tasks[t]) == 0;
+    }
+    worker(&tasks[0]);
+    for (size_t t = 1; t < n_tasks; t++) {
+        if (is_started[t]) {
+            pthread_join(threads[t], NULL);
+        }
+        else {
+            worker(&tasks[t]);
+        }
+    }
+}
+
+static inline void *JOIN(internal, JOIN(FHASHTABLE_NAME, clear_worker))(void *task_ptr)
+{
+    const FHASHTABLE_TASK_TYPE *task = (const FHASHTABLE_TASK_TYPE *)task_ptr;
+    FHASHTABLE_TYPE *self = task->dest_ptr;
+
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    if (!task->clears_all_slots) {
+        JOIN(internal, JOIN(FHASHTABLE_NAME, clear_occupied))(self, task->begin, task->end);
+        return NULL;
+    }
+    memset(&self->occupied[task->begin / 64], 0,
+           (OCCUPANCY_BITMAP_N_WORDS(task->end) - task->begin / 64) * sizeof(uint64_t));
+#endif
+    for (FHASHTABLE_SIZE_TYPE i = task->begin; i < task->end; i++) {
+        FHASHTABLE_OFFSET(self, i) = FHASHTABLE_EMPTY_SLOT_OFFSET;
+    }
+#ifdef FHASHTABLE_CONTROL_BYTES
+    memset(FHASHTABLE_CTRL_BYTES(self) + task->begin, CONTROL_GROUP_EMPTY, task->end - task->begin);
+#endif
+    return NULL;
+}
+
+static inline void *JOIN(internal, JOIN(FHASHTABLE_NAME, copy_worker))(void *task_ptr)
+{
+    const FHASHTABLE_TASK_TYPE *task = (const FHASHTABLE_TASK_TYPE *)task_ptr;
+    FHASHTABLE_TYPE *dest_ptr = task->dest_ptr;
+    const FHASHTABLE_TYPE *src_ptr = task->src_ptr;
+    const FHASHTABLE_SIZE_TYPE n = task->end - task->begin;
+
+#ifdef FHASHTABLE_LAYOUT_SOA
+    memcpy(&dest_ptr->offsets[task->begin], &src_ptr->offsets[task->begin], n * sizeof(src_ptr->offsets[0]));
+    memcpy(&dest_ptr->keys[task->begin], &src_ptr->keys[task->begin], n * sizeof(KEY_TYPE));
+    memcpy(&dest_ptr->values[task->begin], &src_ptr->values[task->begin], n * sizeof(VALUE_TYPE));
+#else
+    memcpy(&dest_ptr->slots[task->begin], &src_ptr->slots[task->begin], n * sizeof(FHASHTABLE_SLOT_TYPE));
+#endif
+#ifdef FHASHTABLE_CONTROL_BYTES
+    memcpy(FHASHTABLE_CTRL_BYTES(dest_ptr) + task->begin, FHASHTABLE_CTRL_BYTES(src_ptr) + task->begin, n);
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    memcpy(&dest_ptr->occupied[task->begin / 64], &src_ptr->occupied[task->begin / 64],
+           (OCCUPANCY_BITMAP_N_WORDS(task->end) - task->begin / 64) * sizeof(uint64_t));
+#endif
+    return NULL;
+}
+
+// Place a slot as in place, but only within the slots [index, end). The slot pushed past end, if any, is kept in the
+// task to be inserted afterwards.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, place_in_range))(FHASHTABLE_TASK_TYPE *task,
+                                                                         FHASHTABLE_SIZE_TYPE index,
+                                                                         const FHASHTABLE_SIZE_TYPE end,
+                                                                         const FHASHTABLE_SIZE_TYPE key_hash,
+                                                                         FHASHTABLE_SLOT_TYPE current_slot)
+{
+    FHASHTABLE_TYPE *self = task->dest_ptr;
+
+#ifndef FHASHTABLE_CONTROL_BYTES
+    (void)key_hash;
+#else
+    uint8_t current_ctrl = CONTROL_GROUP_TAG(key_hash);
+#endif
+
+    while (index < end && FHASHTABLE_OFFSET(self, index) != FHASHTABLE_EMPTY_SLOT_OFFSET) {
+        if (FHASHTABLE_DISPLACES(FHASHTABLE_DISTANCE(current_slot.offset),
+                                 FHASHTABLE_DISTANCE(FHASHTABLE_OFFSET(self, index)))) {
+            FHASHTABLE_SWAP_SLOTS(self, index, &current_slot);
+#ifdef FHASHTABLE_CONTROL_BYTES
+            const uint8_t temp_ctrl = FHASHTABLE_CTRL_BYTES(self)[index];
+            FHASHTABLE_SET_CTRL(self, index, current_ctrl);
+            current_ctrl = temp_ctrl;
+#endif
+        }
+        index++;
+        current_slot.offset += FHASHTABLE_OFFSET_UNIT;
+        assert(FHASHTABLE_DISTANCE(current_slot.offset) < FHASHTABLE_DISTANCE(FHASHTABLE_EMPTY_SLOT_OFFSET));
+    }
+
+    if (index == end) {
+        if (task->n_pushed_out == task->pushed_out_capacity) {
+            const size_t new_capacity = 2 * task->pushed_out_capacity + 16;
+            FHASHTABLE_SLOT_TYPE *slots = (FHASHTABLE_SLOT_TYPE *)realloc(
+                task->pushed_out_slots, new_capacity * sizeof(FHASHTABLE_SLOT_TYPE));
+
+            if (!slots) {
+                task->has_failed = true;
+                return;
+            }
+            task->pushed_out_slots = slots;
+            task->pushed_out_capacity = new_capacity;
+        }
+        task->pushed_out_slots[task->n_pushed_out++] = current_slot;
+        return;
+    }
+
+    if (FHASHTABLE_DISTANCE(current_slot.offset) > task->max_distance) {
+        task->max_distance = FHASHTABLE_DISTANCE(current_slot.offset);
+    }
+    FHASHTABLE_STORE_SLOT(self, index, current_slot);
+    FHASHTABLE_SET_OCCUPIED(self, index);
+#ifdef FHASHTABLE_CONTROL_BYTES
+    FHASHTABLE_SET_CTRL(self, index, current_ctrl);
+#endif
+    task->count++;
+}
+
+// Insert the source keys with ideal indicies in [begin, end). The task only writes to the destination slots whose
+// ideal indicies map back to this range.
+static inline void *JOIN(internal, JOIN(FHASHTABLE_NAME, rehash_worker))(void *task_ptr)
+{
+    FHASHTABLE_TASK_TYPE *task = (FHASHTABLE_TASK_TYPE *)task_ptr;
+    const FHASHTABLE_TYPE *src_ptr = task->src_ptr;
+    const FHASHTABLE_SIZE_TYPE src_index_mask = src_ptr->capacity - 1;
+    const FHASHTABLE_SIZE_TYPE dest_index_mask = task->dest_ptr->capacity - 1;
+
+    // the keys are ordered by ideal index within a cluster, so the keys of the range are found from begin up to the
+    // first empty slot or key of a later range past end. i - distance is the ideal index without wrapping around,
+    // which comes before the range for a key wrapping around to the start of the slots:
+    for (FHASHTABLE_SIZE_TYPE i = task->begin; !task->has_failed; i++) {
+        const FHASHTABLE_SIZE_TYPE index = i & src_index_mask;
+        const uint32_t offset = FHASHTABLE_OFFSET(src_ptr, index);
+
+        if (offset == FHASHTABLE_EMPTY_SLOT_OFFSET) {
+            if (i >= task->end) {
+                break;
+            }
+            continue;
+        }
+        if (FHASHTABLE_DISTANCE(offset) > i || i - FHASHTABLE_DISTANCE(offset) < task->begin) {
+            continue;
+        }
+        if (i - FHASHTABLE_DISTANCE(offset) >= task->end) {
+            break;
+        }
+
+        const KEY_TYPE key = FHASHTABLE_KEY(src_ptr, index);
+        const FHASHTABLE_SIZE_TYPE key_hash = HASH_FUNCTION(key);
+        const FHASHTABLE_SLOT_TYPE slot = {
+            .offset = FHASHTABLE_FINGERPRINT_OF(key_hash), .key = key, .value = FHASHTABLE_VALUE(src_ptr, index)};
+        const FHASHTABLE_SIZE_TYPE dest_index = key_hash & dest_index_mask;
+        const FHASHTABLE_SIZE_TYPE dest_end = dest_index - (key_hash & src_index_mask) + task->end;
+
+        JOIN(internal, JOIN(FHASHTABLE_NAME, place_in_range))(task, dest_index, dest_end, key_hash, slot);
+    }
+    return NULL;
+}
+
+static inline void *JOIN(internal, JOIN(FHASHTABLE_NAME, for_each_worker))(void *task_ptr)
+{
+    const FHASHTABLE_TASK_TYPE *task = (const FHASHTABLE_TASK_TYPE *)task_ptr;
+
+    task->fn(task->context_ptr, task->thread_index, task->begin, task->end);
+    return NULL;
+}
+
+// Flag the slots as empty over several threads. With clears_all_slots, every slot is written, as after allocating.
+static inline void JOIN(internal, JOIN(FHASHTABLE_NAME, parallel_clear_slots))(FHASHTABLE_TYPE *self,
+                                                                               const size_t n_threads,
+                                                                               const bool clears_all_slots)
+{
+    FHASHTABLE_TASK_TYPE tasks[FHASHTABLE_PARALLEL_MAX_THREADS];
+    const size_t n_tasks = JOIN(internal, JOIN(FHASHTABLE_NAME, split))(tasks, self->capacity, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++) {
+        tasks[t].dest_ptr = self;
+        tasks[t].clears_all_slots = clears_all_slots;
+    }
+    JOIN(internal, JOIN(FHASHTABLE_NAME, run_tasks))(tasks, n_tasks,
+                                                     JOIN(internal, JOIN(FHASHTABLE_NAME, clear_worker)));
+
+#ifdef FHASHTABLE_CONTROL_BYTES
+    memset(FHASHTABLE_CTRL_BYTES(self) + self->capacity, CONTROL_GROUP_EMPTY, CONTROL_GROUP_WIDTH);
+#endif
+}
+/// @endcond
+
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, parallel_init)(FHASHTABLE_TYPE *self,
+                                                                       const FHASHTABLE_SIZE_TYPE pow2_capacity,
+                                                                       const size_t n_threads)
+{
+    assert(self);
+    assert(IS_POW2(pow2_capacity));
+
+    self->count = 0;
+    self->capacity = pow2_capacity;
+#ifdef FHASHTABLE_LAYOUT_SOA
+    self->keys = (KEY_TYPE *)((char *)self + FHASHTABLE_SOA_KEYS_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+    self->values = (VALUE_TYPE *)((char *)self + FHASHTABLE_SOA_VALUES_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    self->occupied = (uint64_t *)((char *)self + FHASHTABLE_BITMAP_OFFSET(FHASHTABLE_NAME, pow2_capacity));
+#endif
+#ifdef FHASHTABLE_STATS
+    memset(&self->stats, 0, sizeof(self->stats));
+#endif
+
+    JOIN(internal, JOIN(FHASHTABLE_NAME, parallel_clear_slots))(self, n_threads, true);
+
+    return self;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_clear)(FHASHTABLE_TYPE *self, const size_t n_threads)
+{
+    assert(self != NULL);
+
+    JOIN(internal, JOIN(FHASHTABLE_NAME, parallel_clear_slots))(self, n_threads, false);
+
+#ifdef FHASHTABLE_STATS
+    self->stats.max_offset = 0;
+#endif
+    self->count = 0;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_copy)(FHASHTABLE_TYPE *restrict dest_ptr,
+                                                           const FHASHTABLE_TYPE *restrict src_ptr,
+                                                           const size_t n_threads)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(src_ptr->capacity <= dest_ptr->capacity);
+    assert(dest_ptr->count == 0);
+
+    FHASHTABLE_TASK_TYPE tasks[FHASHTABLE_PARALLEL_MAX_THREADS];
+    const size_t n_tasks = JOIN(internal, JOIN(FHASHTABLE_NAME, split))(tasks, src_ptr->capacity, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++) {
+        tasks[t].dest_ptr = dest_ptr;
+        tasks[t].src_ptr = src_ptr;
+    }
+
+    if (dest_ptr->capacity == src_ptr->capacity) {
+        JOIN(internal, JOIN(FHASHTABLE_NAME, run_tasks))(tasks, n_tasks,
+                                                         JOIN(internal, JOIN(FHASHTABLE_NAME, copy_worker)));
+#ifdef FHASHTABLE_CONTROL_BYTES
+        memcpy(FHASHTABLE_CTRL_BYTES(dest_ptr) + dest_ptr->capacity,
+               FHASHTABLE_CTRL_BYTES(src_ptr) + src_ptr->capacity, CONTROL_GROUP_WIDTH);
+#endif
+#ifdef FHASHTABLE_STATS
+        dest_ptr->stats.max_offset = src_ptr->stats.max_offset;
+#endif
+        FHASHTABLE_STATS_ADD(dest_ptr, n_inserts, src_ptr->count);
+        dest_ptr->count = src_ptr->count;
+        return;
+    }
+
+    JOIN(internal, JOIN(FHASHTABLE_NAME, run_tasks))(tasks, n_tasks,
+                                                     JOIN(internal, JOIN(FHASHTABLE_NAME, rehash_worker)));
+
+    bool has_failed = false;
+    for (size_t t = 0; t < n_tasks; t++) {
+        has_failed = has_failed || tasks[t].has_failed;
+        dest_ptr->count += tasks[t].count;
+        FHASHTABLE_STATS_ADD(dest_ptr, n_inserts, tasks[t].count);
+#ifdef FHASHTABLE_STATS
+        if (tasks[t].max_distance > dest_ptr->stats.max_offset) {
+            dest_ptr->stats.max_offset = tasks[t].max_distance;
+        }
+#endif
+    }
+    for (size_t t = 0; t < n_tasks; t++) {
+        for (size_t i = 0; i < tasks[t].n_pushed_out && !has_failed; i++) {
+            const FHASHTABLE_SLOT_TYPE slot = tasks[t].pushed_out_slots[i];
+
+            FHASHTABLE_INSERT_COPY(dest_ptr, HASH_FUNCTION(slot.key), slot.key, slot.value);
+        }
+        free(tasks[t].pushed_out_slots);
+    }
+
+    if (has_failed) {
+        // out of memory for the keys pushed out of the ranges. start over one key at a time:
+        JOIN(FHASHTABLE_NAME, parallel_clear)(dest_ptr, n_threads);
+        JOIN(FHASHTABLE_NAME, copy)(dest_ptr, src_ptr);
+    }
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, parallel_for_each_range)(
+    const FHASHTABLE_TYPE *self, const size_t n_threads,
+    void (*fn)(void *context_ptr, size_t thread_index, FHASHTABLE_SIZE_TYPE begin, FHASHTABLE_SIZE_TYPE end),
+    void *context_ptr)
+{
+    assert(self != NULL);
+    assert(fn != NULL);
+
+    FHASHTABLE_TASK_TYPE tasks[FHASHTABLE_PARALLEL_MAX_THREADS];
+    const size_t n_tasks = JOIN(internal, JOIN(FHASHTABLE_NAME, split))(tasks, self->capacity, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++) {
+        tasks[t].src_ptr = self;
+        tasks[t].fn = fn;
+        tasks[t].context_ptr = context_ptr;
+    }
+    JOIN(internal, JOIN(FHASHTABLE_NAME, run_tasks))(tasks, n_tasks,
+                                                     JOIN(internal, JOIN(FHASHTABLE_NAME, for_each_worker)));
+}
+
+#endif
+
+#ifdef FHASHTABLE_PERSIST
+
+/// @cond DO_NOT_DOCUMENT
+static inline struct fhashtable_file_header
+    JOIN(internal, JOIN(FHASHTABLE_NAME, file_header))(const uint64_t table_size)
+{
+    struct fhashtable_file_header header = {0};
+
+    header.magic = FHASHTABLE_FILE_MAGIC;
+    header.version = FHASHTABLE_FILE_VERSION;
+#ifdef FHASHTABLE_CONTROL_BYTES
+    header.layout |= 1U | (uint32_t)CONTROL_GROUP_WIDTH << 8;
+#endif
+#ifdef FHASHTABLE_FINGERPRINT
+    header.layout |= 2U;
+#endif
+#ifdef FHASHTABLE_LAYOUT_SOA
+    header.layout |= 4U;
+#endif
+#ifdef FHASHTABLE_LARGE_CAPACITY
+    header.layout |= 8U;
+#endif
+#ifdef FHASHTABLE_STATS
+    header.layout |= 16U;
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+    header.layout |= 32U;
+#endif
+    header.key_size = sizeof(KEY_TYPE);
+    header.value_size = sizeof(VALUE_TYPE);
+    header.hash_id = FHASHTABLE_HASH_ID;
+    header.table_size = table_size;
+
+    return header;
+}
+
+// Write all bytes, resuming after partial writes and interrupts.
+static inline bool JOIN(internal, JOIN(FHASHTABLE_NAME, write_all))(const int fd, const void *buf, size_t size)
+{
+    const char *ptr = (const char *)buf;
+
+    while (size > 0) {
+        const ssize_t n_written = write(fd, ptr, size);
+
+        if (n_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        ptr += n_written;
+        size -= (size_t)n_written;
+    }
+    return true;
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(FHASHTABLE_NAME, save_to_fd)(const FHASHTABLE_TYPE *self, const int fd)
+{
+    assert(self != NULL);
+
+    const size_t table_size = FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, self->capacity);
+    const struct fhashtable_file_header header = JOIN(internal, JOIN(FHASHTABLE_NAME, file_header))(table_size);
+
+    // with FHASHTABLE_LAYOUT_SOA (FHASHTABLE_OCCUPANCY_BITMAP), the `keys` and `values` (`occupied`) pointers are
+    // written as well, and fixed up on mapping:
+    return JOIN(internal, JOIN(FHASHTABLE_NAME, write_all))(fd, &header, sizeof(header))
+           && JOIN(internal, JOIN(FHASHTABLE_NAME, write_all))(fd, self, table_size);
+}
+
+FUNCTION_LINKAGE FHASHTABLE_TYPE *JOIN(FHASHTABLE_NAME, map_from_file)(const char *path, const bool writable)
+{
+    assert(path != NULL);
+
+    if (FHASHTABLE_ALIGNMENT > sizeof(struct fhashtable_file_header)) {
+        return NULL;
+    }
+#ifdef FHASHTABLE_STATS
+    // the lookups write to the counters:
+    if (!writable) {
+        return NULL;
+    }
+#endif
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return NULL;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size <= sizeof(struct fhashtable_file_header)
+        || (uint64_t)st.st_size > SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t file_size = (size_t)st.st_size;
+#if defined(FHASHTABLE_LAYOUT_SOA) || defined(FHASHTABLE_OCCUPANCY_BITMAP)
+    const int prot = PROT_READ | PROT_WRITE;
+#else
+    const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+#endif
+
+    void *base_ptr = mmap(NULL, file_size, prot, MAP_PRIVATE, fd, 0);
+
+    // the mapping stays valid after closing:
+    close(fd);
+
+    if (base_ptr == MAP_FAILED) {
+        return NULL;
+    }
+
+    const struct fhashtable_file_header *header_ptr = (const struct fhashtable_file_header *)base_ptr;
+    FHASHTABLE_TYPE *self = (FHASHTABLE_TYPE *)((char *)base_ptr + sizeof(struct fhashtable_file_header));
+
+    const uint64_t table_size = file_size - sizeof(struct fhashtable_file_header);
+    const struct fhashtable_file_header expected = JOIN(internal, JOIN(FHASHTABLE_NAME, file_header))(table_size);
+
+    bool is_valid = memcmp(header_ptr, &expected, sizeof(expected)) == 0
+                    && table_size >= offsetof(FHASHTABLE_TYPE, capacity) + sizeof(self->capacity)
+                    && IS_POW2(self->capacity) && self->count <= self->capacity
+                    && !FHASHTABLE_CALC_SIZEOF_OVERFLOWS(FHASHTABLE_NAME, self->capacity)
+                    && FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, self->capacity) == table_size;
+
+#if defined(FHASHTABLE_LAYOUT_SOA) || defined(FHASHTABLE_OCCUPANCY_BITMAP)
+    if (is_valid) {
+        // the pointers saved are those of the saved process:
+#ifdef FHASHTABLE_LAYOUT_SOA
+        self->keys = (KEY_TYPE *)((char *)self + FHASHTABLE_SOA_KEYS_OFFSET(FHASHTABLE_NAME, self->capacity));
+        self->values = (VALUE_TYPE *)((char *)self + FHASHTABLE_SOA_VALUES_OFFSET(FHASHTABLE_NAME, self->capacity));
+#endif
+#ifdef FHASHTABLE_OCCUPANCY_BITMAP
+        self->occupied = (uint64_t *)((char *)self + FHASHTABLE_BITMAP_OFFSET(FHASHTABLE_NAME, self->capacity));
+#endif
+
+        // the first page is now a private copy, and the mapping can be made read-only again:
+        is_valid = writable || mprotect(base_ptr, file_size, PROT_READ) == 0;
+    }
+#endif
+
+    if (!is_valid) {
+        munmap(base_ptr, file_size);
+        return NULL;
+    }
+
+    return self;
+}
+
+FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, unmap)(FHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    const size_t file_size =
+        sizeof(struct fhashtable_file_header) + FHASHTABLE_CALC_SIZEOF(FHASHTABLE_NAME, self->capacity);
+
+    munmap((char *)self - sizeof(struct fhashtable_file_header), file_size);
+}
+
+#endif
+
 #endif
 
 // }}}
@@ -848,6 +3110,17 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest
 #undef VALUE_TYPE
 #undef KEY_IS_EQUAL
 #undef HASH_FUNCTION
+#undef COMBINE_VALUES
+#undef FHASHTABLE_CONTROL_BYTES
+#undef FHASHTABLE_FINGERPRINT
+#undef FHASHTABLE_LAYOUT_SOA
+#undef FHASHTABLE_LARGE_CAPACITY
+#undef FHASHTABLE_PERSIST
+#undef FHASHTABLE_STATS
+#undef FHASHTABLE_PARALLEL
+#undef FHASHTABLE_OCCUPANCY_BITMAP
+#undef FHASHTABLE_MULTIMAP
+#undef FHASHTABLE_HASH_ID
 #undef FUNCTION_LINKAGE
 #undef FUNCTION_DEFINITIONS
 #undef TYPE_DEFINITIONS
@@ -859,8 +3132,51 @@ FUNCTION_LINKAGE void JOIN(FHASHTABLE_NAME, copy)(FHASHTABLE_TYPE *restrict dest
 #undef FHASHTABLE_IS_FULL
 #undef FHASHTABLE_CONTAINS_KEY
 #undef FHASHTABLE_CALC_SIZEOF
+#undef FHASHTABLE_CALC_SIZEOF_OVERFLOWS
+#undef FHASHTABLE_CALC_SLOTS_SIZEOF
+#undef FHASHTABLE_CALC_SLOTS_SIZEOF_OVERFLOWS
 #undef FHASHTABLE_SWAP_SLOTS
 #undef FHASHTABLE_BACKSHIFT
+#undef FHASHTABLE_FIND_INDEX
+#undef FHASHTABLE_FIND_HASHED
+#undef FHASHTABLE_FIND_BATCH
+#undef FHASHTABLE_PREFETCH
+#undef FHASHTABLE_INSERT_HASH
+#undef FHASHTABLE_PLACE
+#undef FHASHTABLE_GET_OR_INSERT
+#undef FHASHTABLE_INSERT_MULTI
+#undef FHASHTABLE_INSERT_COPY
+#undef FHASHTABLE_EQUAL_RANGE
+#undef FHASHTABLE_DISPLACES
+#undef FHASHTABLE_TASK_TYPE
+#undef FHASHTABLE_NO_INDEX
+#undef FHASHTABLE_SIZE_TYPE
+#undef FHASHTABLE_SIZE_MAX
+#undef FHASHTABLE_ROUND_UP_POW2
+#undef FHASHTABLE_OFFSET_UNIT
+#undef FHASHTABLE_FINGERPRINT_MASK
+#undef FHASHTABLE_FINGERPRINT_OF
+#undef FHASHTABLE_DISTANCE
+#undef FHASHTABLE_STATS_ADD
+#undef FHASHTABLE_STATS_LOOKUP
+#undef FHASHTABLE_STATS_OFFSET
+#undef FHASHTABLE_LOAD_SLOT
+#undef FHASHTABLE_STORE_SLOT
+#undef FHASHTABLE_OFFSET
+#undef FHASHTABLE_KEY
+#undef FHASHTABLE_VALUE
+#undef FHASHTABLE_SLOTS_OFFSET
+#undef FHASHTABLE_LAYOUT_FOR_EACH
+#undef FHASHTABLE_ALIGN_UP
+#undef FHASHTABLE_MAX
+#undef FHASHTABLE_ALIGNMENT
+#undef FHASHTABLE_SOA_KEYS_OFFSET
+#undef FHASHTABLE_SOA_VALUES_OFFSET
+#undef FHASHTABLE_CTRL_BYTES
+#undef FHASHTABLE_SET_CTRL
+#undef FHASHTABLE_BITMAP_OFFSET
+#undef FHASHTABLE_SET_OCCUPIED
+#undef FHASHTABLE_CLEAR_OCCUPIED
 
 // }}}
 
@@ -0,0 +1,160 @@
+/**
+ * @file inthash.h
+ * @brief Integer hashing functions
+ *
+ * Branch-free mixers for fixed-size integer keys, to be used as
+ * `HASH_FUNCTION` instead of hashing the bytes of the key with
+ * `murmur3_32` or `fnvhash_32`.
+ *
+ * The hashtables take the ideal slot index from the lower bits of the hash
+ * (`key_hash & index_mask`), and the control tags and fingerprints from the
+ * upper bits of the lower 32 bits. The mixers here spread every key bit over
+ * all of the hash bits, except for the Fibonacci hash, whose product only has
+ * it's upper bits well mixed. `inthash_fibonacci_32` therefore swaps the bytes
+ * of the product, so the index is taken from the upper bits of the product.
+ *
+ * The 64-bit hashes are truncated with `(uint32_t)` unless
+ * `FHASHTABLE_LARGE_CAPACITY` is used.
+ *
+ * @note None of these are cryptographic hashing functions. An adversary
+ *       knowing the function can pick keys with the same ideal slot.
+ *
+ * Sources used:
+ * @li https://probablydance.com/2018/06/16/fibonacci-hashing-the-optimization-that-the-world-forgot-or-a-better-alternative-to-integer-modulo/
+ * @li https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+ * @li https://prng.di.unimi.it/splitmix64.c
+ * @li https://mostlymangling.blogspot.com/2019/12/stronger-better-morer-moremur-better.html
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h> // uint32_t, uint64_t
+
+/**
+ * @def INTHASH_GOLDEN_RATIO_64
+ * @brief 2^64 divided by the golden ratio, rounded to an odd number.
+ */
+#define INTHASH_GOLDEN_RATIO_64 (UINT64_C(0x9E3779B97F4A7C15))
+
+/// @cond DO_NOT_DOCUMENT
+static inline uint64_t internal_inthash_bswap_64(const uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(x);
+#else
+    return ((x & UINT64_C(0x00000000000000FF)) << 56) | ((x & UINT64_C(0x000000000000FF00)) << 40)
+           | ((x & UINT64_C(0x0000000000FF0000)) << 24) | ((x & UINT64_C(0x00000000FF000000)) << 8)
+           | ((x & UINT64_C(0x000000FF00000000)) >> 8) | ((x & UINT64_C(0x0000FF0000000000)) >> 24)
+           | ((x & UINT64_C(0x00FF000000000000)) >> 40) | ((x & UINT64_C(0xFF00000000000000)) >> 56);
+#endif
+}
+/// @endcond
+
+/**
+ * @brief Get the Fibonacci (multiplicative) hash of an integer, with the
+ *        upper bytes of the product as the lower bytes of the hash.
+ *
+ * One multiplication and a byte swap. The lower bits of the hash then come
+ * from the upper, well mixed, bits of the product, as Fibonacci hashing takes
+ * the index from `(key * INTHASH_GOLDEN_RATIO_64) >> (64 - log2(capacity))`.
+ * The control tags and fingerprints come from the bits after those.
+ *
+ * Spreads sequential and strided keys evenly, but keys differing only in
+ * their upper bits are not mixed well. Prefer `inthash_fmix64` for keys of
+ * unknown distribution.
+ *
+ * @param[in] key               The key.
+ *
+ * @return                      A 32-bit hash of the key.
+ */
+static inline uint32_t inthash_fibonacci_32(const uint64_t key)
+{
+    return (uint32_t)internal_inthash_bswap_64(key * INTHASH_GOLDEN_RATIO_64);
+}
+
+/**
+ * @brief Get the MurmurHash3 finalizer (fmix32) of a 32-bit integer.
+ *
+ * A bijection, so distinct keys always give distinct hashes.
+ *
+ * @param[in] key               The key.
+ *
+ * @return                      A 32-bit hash of the key.
+ */
+static inline uint32_t inthash_fmix32(uint32_t key)
+{
+    key ^= key >> 16;
+    key *= UINT32_C(0x85EBCA6B);
+    key ^= key >> 13;
+    key *= UINT32_C(0xC2B2AE35);
+    key ^= key >> 16;
+    return key;
+}
+
+/**
+ * @brief Get the MurmurHash3 finalizer (fmix64) of a 64-bit integer.
+ *
+ * A bijection, so distinct keys always give distinct hashes. Maps 0 to 0.
+ *
+ * @param[in] key               The key.
+ *
+ * @return                      A 64-bit hash of the key.
+ */
+static inline uint64_t inthash_fmix64(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= UINT64_C(0xFF51AFD7ED558CCD);
+    key ^= key >> 33;
+    key *= UINT64_C(0xC4CEB9FE1A85EC53);
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * @brief Get the splitmix64 hash of a 64-bit integer.
+ *
+ * The key is offset by `INTHASH_GOLDEN_RATIO_64` and mixed with the
+ * splitmix64 finalizer, so the hash of `i * INTHASH_GOLDEN_RATIO_64` is the
+ * `i + 1`-th output of splitmix64 seeded with 0. A bijection.
+ *
+ * @param[in] key               The key.
+ *
+ * @return                      A 64-bit hash of the key.
+ */
+static inline uint64_t inthash_splitmix64(uint64_t key)
+{
+    key += INTHASH_GOLDEN_RATIO_64;
+    key = (key ^ (key >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    key = (key ^ (key >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return key ^ (key >> 31);
+}
+
+/**
+ * @brief Get the moremur hash of a 64-bit integer.
+ *
+ * Same cost as `inthash_fmix64`, with constants and shifts chosen for fewer
+ * statistical flaws on sequential keys. A bijection. Maps 0 to 0.
+ *
+ * @param[in] key               The key.
+ *
+ * @return                      A 64-bit hash of the key.
+ */
+static inline uint64_t inthash_moremur(uint64_t key)
+{
+    key ^= key >> 27;
+    key *= UINT64_C(0x3C79AC492BA7B653);
+    key ^= key >> 33;
+    key *= UINT64_C(0x1C69B3F74AC4AE35);
+    key ^= key >> 27;
+    return key;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c
@@ -0,0 +1,633 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file lfhashtable_template.h
+ * @brief Fixed-size lock-free hashtable with `uint64_t` keys and values
+ *
+ * Uses the flat power-of-two slot array of `fhashtable_template.h`, but with
+ * plain linear probing, as robin hood hashing moves keys around. A key is
+ * claimed by a compare-and-swap on an empty slot and is never moved or removed
+ * afterwards, so:
+ *      @li lookups are wait-free: they visit at most `capacity` slots and
+ *          never retry.
+ *      @li insertions and updates are lock-free: a failed compare-and-swap
+ *          means another thread has claimed the slot, and the probe simply
+ *          continues.
+ *      @li values are updated in place with atomic stores and atomic adds.
+ *
+ * There is no delete. `clear()` and the destruction are not thread-safe. It is
+ * suited for counters and sets built up concurrently, sized so they never fill
+ * up.
+ *
+ * `LFHASHTABLE_EMPTY_KEY` is reserved to flag empty slots and may not be used
+ * as a key.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `HASH_FUNCTION`
+ *
+ * Source(s) used:
+ *  @li https://preshing.com/20130605/the-worlds-simplest-lock-free-hash-table/
+ *  @li https://en.cppreference.com/w/c/atomic
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def IS_POW2(X)
+ * @brief Check if a number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def LFHASHTABLE_EMPTY_KEY
+ * @brief Key constant used to flag empty slots. Can be defined to another
+ *        value before including this header file the first time.
+ */
+#ifndef LFHASHTABLE_EMPTY_KEY
+#define LFHASHTABLE_EMPTY_KEY (UINT64_MAX)
+#endif
+
+/**
+ * @def LFHASHTABLE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the non-empty slots in the hashtable in arbitary order.
+ *
+ * @note Concurrent insertions may or may not be visited. A key claimed
+ *       concurrently may be visited with the value 0.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `uint64_t`.
+ * @param[out] value_           Current value. Should be `uint64_t`.
+ */
+#ifndef LFHASHTABLE_FOR_EACH
+#define LFHASHTABLE_FOR_EACH(self, index, key_, value_)                                                         \
+    for ((index) = 0; (index) < (self)->capacity; (index)++)                                                    \
+        if (((key_) = atomic_load_explicit(&(self)->slots[(index)].key, memory_order_acquire),                  \
+             (key_) != LFHASHTABLE_EMPTY_KEY)                                                                   \
+            && ((value_) = atomic_load_explicit(&(self)->slots[(index)].value, memory_order_relaxed), true))
+#endif
+
+/**
+ * @def LFHASHTABLE_CALC_SIZEOF(lfhashtable_name, capacity)
+ *
+ * @brief Calculate the size of the hashtable struct. No overflow checks.
+ *
+ * @param[in] lfhashtable_name  Defined hashtable NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#ifndef LFHASHTABLE_CALC_SIZEOF
+#define LFHASHTABLE_CALC_SIZEOF(lfhashtable_name, capacity) \
+    (uint32_t)(offsetof(struct lfhashtable_name, slots) + capacity * sizeof(((struct lfhashtable_name *)0)->slots[0]))
+#endif
+
+/**
+ * @def LFHASHTABLE_CALC_SIZEOF_OVERFLOWS(lfhashtable_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the hashtable struct overflows.
+ *
+ * @param[in] lfhashtable_name  Defined hashtable NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#ifndef LFHASHTABLE_CALC_SIZEOF_OVERFLOWS
+#define LFHASHTABLE_CALC_SIZEOF_OVERFLOWS(lfhashtable_name, capacity) \
+    (capacity                                                         \
+     > (UINT32_MAX - offsetof(struct lfhashtable_name, slots)) / sizeof(((struct lfhashtable_name *)0)->slots[0]))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define LFHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define LFHASHTABLE_TYPE      struct LFHASHTABLE_NAME
+#define LFHASHTABLE_SLOT_TYPE struct JOIN(LFHASHTABLE_NAME, slot)
+#define LFHASHTABLE_FIND      JOIN(internal, JOIN(LFHASHTABLE_NAME, find_slot))
+#define LFHASHTABLE_CLAIM     JOIN(internal, JOIN(LFHASHTABLE_NAME, claim_slot))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated hashtable slot struct type.
+ */
+struct JOIN(LFHASHTABLE_NAME, slot) {
+    _Atomic uint64_t key;   ///< The key in this slot. `LFHASHTABLE_EMPTY_KEY` if empty.
+    _Atomic uint64_t value; ///< The value in this slot.
+};
+
+/**
+ * @brief Generated hashtable struct type.
+ */
+struct LFHASHTABLE_NAME {
+    _Atomic uint32_t count;        ///< Number of non-empty slots.
+    uint32_t capacity;             ///< Number of slots.
+    LFHASHTABLE_SLOT_TYPE slots[]; ///< Array of slots.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Initialize a hashtable struct, given a (power-of-2) capacity.
+ *
+ * @param[in] self              Hashtable pointer
+ * @param[in] pow2_capacity     Power of 2 capacity.
+ */
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *JOIN(LFHASHTABLE_NAME, init)(LFHASHTABLE_TYPE *self, const uint32_t pow2_capacity);
+
+/**
+ * @brief Create an hashtable with a given capacity with a custom allocator.
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
+ *                              overflows.
+ */
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *
+    JOIN(LFHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                          void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
+
+/**
+ * @brief Create an hashtable with a given capacity with malloc().
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
+ *                              overflows.
+ */
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *JOIN(LFHASHTABLE_NAME, create)(const uint32_t min_capacity);
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        a custom allocator.
+ *
+ * @warning May not be called twice in a row on the same object, nor while
+ *          other threads use the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, destroy_custom)(LFHASHTABLE_TYPE *self, void *context_ptr,
+                                                             void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        free().
+ *
+ * @warning May not be called twice in a row on the same object, nor while
+ *          other threads use the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, destroy)(LFHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return the number of keys in the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      The number of keys claimed so far.
+ */
+FUNCTION_LINKAGE uint32_t JOIN(LFHASHTABLE_NAME, count)(const LFHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether the hashtable is full.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, is_full)(const LFHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key. Wait-free.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key. May not be `LFHASHTABLE_EMPTY_KEY`.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, contains_key)(const LFHASHTABLE_TYPE *self, const uint64_t key);
+
+/**
+ * @brief From a given key, get the corresponding value in the hashtable.
+ *        Wait-free.
+ *
+ * @note A key being inserted concurrently may be found with the value 0
+ *       before it's value is stored.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for. May not be `LFHASHTABLE_EMPTY_KEY`.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding value.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE uint64_t JOIN(LFHASHTABLE_NAME, get_value)(const LFHASHTABLE_TYPE *self, const uint64_t key,
+                                                            const uint64_t default_value);
+
+/**
+ * @brief Insert a key and it's corresponding value, if the key is not already
+ *        contained in the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key. May not be `LFHASHTABLE_EMPTY_KEY`.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the key was inserted by this call.
+ * @retval false
+ *   @li                        If the key was already contained in the hashtable.
+ *   @li                        If the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, insert)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t value);
+
+/**
+ * @brief Store a key's corresponding value, inserting the key if needed.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key. May not be `LFHASHTABLE_EMPTY_KEY`.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the value was stored.
+ * @retval false                If the key was not contained and the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, update)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t value);
+
+/**
+ * @brief Atomically add to a key's corresponding value, inserting the key
+ *        with the value 0 first if needed. Wraps around on overflow.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key. May not be `LFHASHTABLE_EMPTY_KEY`.
+ * @param[in] delta             The amount to add.
+ *
+ * @return                      Whether the value was added to.
+ * @retval false                If the key was not contained and the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, add)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t delta);
+
+/**
+ * @brief Clear an existing hashtable.
+ *
+ * @warning Not thread-safe.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ */
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, clear)(LFHASHTABLE_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+#include "round_up_pow2_32.h" // round_up_pow2_32
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute indicies of keys. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key as `uint64_t`.
+ * @return The hash of the key as `uint32_t`.
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *JOIN(LFHASHTABLE_NAME, init)(LFHASHTABLE_TYPE *self, const uint32_t pow2_capacity)
+{
+    assert(self);
+    assert(IS_POW2(pow2_capacity));
+
+    atomic_init(&self->count, 0);
+    self->capacity = pow2_capacity;
+
+    for (uint32_t i = 0; i < self->capacity; i++) {
+        atomic_init(&self->slots[i].key, LFHASHTABLE_EMPTY_KEY);
+        atomic_init(&self->slots[i].value, 0);
+    }
+
+    return self;
+}
+
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *
+    JOIN(LFHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                          void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    const uint32_t capacity = round_up_pow2_32(min_capacity);
+
+    if (LFHASHTABLE_CALC_SIZEOF_OVERFLOWS(LFHASHTABLE_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = LFHASHTABLE_CALC_SIZEOF(LFHASHTABLE_NAME, capacity);
+
+    LFHASHTABLE_TYPE *self = (LFHASHTABLE_TYPE *)allocate(context_ptr, alignof(LFHASHTABLE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    JOIN(LFHASHTABLE_NAME, init)(self, capacity);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(LFHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+/// @endcond
+
+FUNCTION_LINKAGE LFHASHTABLE_TYPE *JOIN(LFHASHTABLE_NAME, create)(const uint32_t min_capacity)
+{
+    return JOIN(LFHASHTABLE_NAME, create_custom)(min_capacity, NULL, JOIN(internal, JOIN(LFHASHTABLE_NAME, allocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, destroy_custom)(LFHASHTABLE_TYPE *self, void *context_ptr,
+                                                             void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(LFHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, destroy)(LFHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(LFHASHTABLE_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(LFHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE uint32_t JOIN(LFHASHTABLE_NAME, count)(const LFHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return atomic_load_explicit(&((LFHASHTABLE_TYPE *)self)->count, memory_order_relaxed);
+}
+
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, is_full)(const LFHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return JOIN(LFHASHTABLE_NAME, count)(self) == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+// Find the slot of a key. Returns NULL if the key is not contained.
+static inline LFHASHTABLE_SLOT_TYPE *JOIN(internal, JOIN(LFHASHTABLE_NAME, find_slot))(const LFHASHTABLE_TYPE *self,
+                                                                                        const uint64_t key)
+{
+    assert(self != NULL);
+    assert(key != LFHASHTABLE_EMPTY_KEY);
+
+    LFHASHTABLE_SLOT_TYPE *slots = ((LFHASHTABLE_TYPE *)self)->slots;
+    const uint32_t index_mask = self->capacity - 1;
+    const uint32_t key_hash = HASH_FUNCTION(key);
+
+    for (uint32_t i = 0, index = key_hash & index_mask; i < self->capacity; i++, index = (index + 1) & index_mask) {
+        const uint64_t slot_key = atomic_load_explicit(&slots[index].key, memory_order_acquire);
+
+        if (slot_key == key) {
+            return &slots[index];
+        }
+        // keys are never removed, so the key would have been placed here:
+        if (slot_key == LFHASHTABLE_EMPTY_KEY) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+// Find the slot of a key, or claim an empty slot for it. Returns NULL if the key is not contained and the table is
+// full. `has_claimed` is set if this call claimed the slot.
+static inline LFHASHTABLE_SLOT_TYPE *JOIN(internal, JOIN(LFHASHTABLE_NAME, claim_slot))(LFHASHTABLE_TYPE *self,
+                                                                                         const uint64_t key,
+                                                                                         bool *has_claimed)
+{
+    assert(self != NULL);
+    assert(key != LFHASHTABLE_EMPTY_KEY);
+
+    const uint32_t index_mask = self->capacity - 1;
+    const uint32_t key_hash = HASH_FUNCTION(key);
+
+    *has_claimed = false;
+
+    for (uint32_t i = 0, index = key_hash & index_mask; i < self->capacity; i++, index = (index + 1) & index_mask) {
+        uint64_t slot_key = atomic_load_explicit(&self->slots[index].key, memory_order_acquire);
+
+        if (slot_key == LFHASHTABLE_EMPTY_KEY) {
+            // on failure, `slot_key` is updated to the key of the thread which claimed the slot first:
+            if (atomic_compare_exchange_strong_explicit(&self->slots[index].key, &slot_key, key, memory_order_acq_rel,
+                                                        memory_order_acquire)) {
+                atomic_fetch_add_explicit(&self->count, 1, memory_order_relaxed);
+                *has_claimed = true;
+                return &self->slots[index];
+            }
+        }
+        if (slot_key == key) {
+            return &self->slots[index];
+        }
+    }
+    return NULL;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, contains_key)(const LFHASHTABLE_TYPE *self, const uint64_t key)
+{
+    return LFHASHTABLE_FIND(self, key) != NULL;
+}
+
+FUNCTION_LINKAGE uint64_t JOIN(LFHASHTABLE_NAME, get_value)(const LFHASHTABLE_TYPE *self, const uint64_t key,
+                                                            const uint64_t default_value)
+{
+    LFHASHTABLE_SLOT_TYPE *slot_ptr = LFHASHTABLE_FIND(self, key);
+
+    return slot_ptr ? atomic_load_explicit(&slot_ptr->value, memory_order_relaxed) : default_value;
+}
+
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, insert)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t value)
+{
+    bool has_claimed;
+    LFHASHTABLE_SLOT_TYPE *slot_ptr = LFHASHTABLE_CLAIM(self, key, &has_claimed);
+
+    if (has_claimed) {
+        atomic_store_explicit(&slot_ptr->value, value, memory_order_relaxed);
+    }
+    return has_claimed;
+}
+
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, update)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t value)
+{
+    bool has_claimed;
+    LFHASHTABLE_SLOT_TYPE *slot_ptr = LFHASHTABLE_CLAIM(self, key, &has_claimed);
+
+    if (!slot_ptr) {
+        return false;
+    }
+    atomic_store_explicit(&slot_ptr->value, value, memory_order_relaxed);
+
+    return true;
+}
+
+FUNCTION_LINKAGE bool JOIN(LFHASHTABLE_NAME, add)(LFHASHTABLE_TYPE *self, const uint64_t key, const uint64_t delta)
+{
+    bool has_claimed;
+    LFHASHTABLE_SLOT_TYPE *slot_ptr = LFHASHTABLE_CLAIM(self, key, &has_claimed);
+
+    if (!slot_ptr) {
+        return false;
+    }
+    atomic_fetch_add_explicit(&slot_ptr->value, delta, memory_order_relaxed);
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(LFHASHTABLE_NAME, clear)(LFHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(LFHASHTABLE_NAME, init)(self, self->capacity);
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef HASH_FUNCTION
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef LFHASHTABLE_NAME
+#undef LFHASHTABLE_TYPE
+#undef LFHASHTABLE_SLOT_TYPE
+#undef LFHASHTABLE_FIND
+#undef LFHASHTABLE_CLAIM
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
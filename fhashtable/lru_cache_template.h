@@ -0,0 +1,592 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file lru_cache_template.h
+ * @brief Fixed-capacity least-recently-used cache (built on fhashtable and list)
+ *
+ * The entries are kept in a pool allocated once with the cache, each with it's
+ * list node, key and value next to each other. The entries are linked in a
+ * list from the most to the least recently used entry, and a table maps the
+ * keys to the entry indices. Getting, putting and deleting keys take O(1)
+ * time and never allocate. Putting a new key into a full cache evicts the
+ * least recently used entry.
+ *
+ * The table is an instance of an `fhashtable_template.h` instantiation with
+ * `KEY_TYPE` keys and `uint32_t` values, and the list node is an instance of a
+ * `list_template.h` instantiation. They must be defined beforehand. The table
+ * is created and destroyed with it's `create_custom` / `destroy_custom` and
+ * the allocator given to this cache.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `TABLE_NAME`
+ *      @li `LIST_NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * Source(s) used:
+ *  @li https://en.wikipedia.org/wiki/Cache_replacement_policies#LRU
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def LRU_CACHE_FOR_EACH(self, entry_ptr)
+ *
+ * @brief Iterate over the entries from the most to the least recently used.
+ *
+ * @warning Modifying the cache under the iteration may result in errors.
+ *
+ * @param[in] self              Cache pointer.
+ * @param[out] entry_ptr        Current entry pointer. Should be a pointer to the generated entry type.
+ */
+#ifndef LRU_CACHE_FOR_EACH
+#define LRU_CACHE_FOR_EACH(self, entry_ptr)                                                         \
+    for ((entry_ptr) = (void *)(self)->head.next_ptr; (void *)(entry_ptr) != (void *)&(self)->head; \
+         (entry_ptr) = (void *)(entry_ptr)->node.next_ptr)
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to cache types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define LRU_CACHE_NAME NAME
+#endif
+
+/**
+ * @def TABLE_NAME
+ * @brief Name of the `fhashtable_template.h` instantiation mapping the keys to
+ *        the entry indices. This must be manually defined before including
+ *        this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef TABLE_NAME
+#error "Must define TABLE_NAME."
+#endif
+
+/**
+ * @def LIST_NAME
+ * @brief Name of the `list_template.h` instantiation used for the entry list
+ *        nodes. This must be manually defined before including this header
+ *        file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef LIST_NAME
+#error "Must define LIST_NAME."
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define LRU_CACHE_TYPE       struct LRU_CACHE_NAME
+#define LRU_CACHE_ENTRY_TYPE struct JOIN(LRU_CACHE_NAME, entry)
+#define LRU_CACHE_TABLE_TYPE struct TABLE_NAME
+#define LRU_CACHE_NODE_TYPE  struct JOIN(LIST_NAME, node)
+#define LRU_CACHE_FIND       JOIN(internal, JOIN(LRU_CACHE_NAME, find))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(LRU_CACHE_NAME, entry);
+struct LRU_CACHE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated cache entry struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ *
+ * The list node is the first member, so a node pointer is also an entry
+ * pointer.
+ */
+struct JOIN(LRU_CACHE_NAME, entry) {
+    LRU_CACHE_NODE_TYPE node; ///< List node. In the list of used entries or of free entries.
+    KEY_TYPE key;             ///< The key of the entry.
+    VALUE_TYPE value;         ///< The value of the entry.
+};
+
+/**
+ * @brief Generated cache struct type for a given `KEY_TYPE` and `VALUE_TYPE`.
+ */
+struct LRU_CACHE_NAME {
+    uint32_t count;                  ///< Number of used entries.
+    uint32_t capacity;               ///< Number of entries.
+    uint32_t n_untouched;            ///< Number of entries at the end of the pool, which were never used.
+    LRU_CACHE_NODE_TYPE head;        ///< Head of the list of used entries, most recently used first.
+    LRU_CACHE_NODE_TYPE free_head;   ///< Head of the list of free entries, which were used before.
+    LRU_CACHE_TABLE_TYPE *table_ptr; ///< Table mapping the keys to the entry indices.
+
+    void *context_ptr;                                                   ///< Allocator context.
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size); ///< Allocate function.
+    void (*deallocate)(void *context_ptr, void *mem);                    ///< Deallocate function.
+
+    LRU_CACHE_ENTRY_TYPE entries[]; ///< Pool of entries.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Create a cache with a given capacity with a custom allocator.
+ *
+ * The table is created with room for a third more keys than the capacity, to
+ * keep it's load factor at most 75%.
+ *
+ * @param[in] capacity          Number of entries.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ * @param[in] deallocate        Deallocate function.
+ *
+ * @return                      A pointer to the cache.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0 or the equivalent size overflows.
+ *   @li                        If the table could not be created.
+ */
+FUNCTION_LINKAGE LRU_CACHE_TYPE *JOIN(LRU_CACHE_NAME, create_custom)(
+    const uint32_t capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Create a cache with a given capacity with malloc() and free().
+ *
+ * @param[in] capacity          Number of entries.
+ *
+ * @return                      A pointer to the cache.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0 or the equivalent size overflows.
+ *   @li                        If the table could not be created.
+ */
+FUNCTION_LINKAGE LRU_CACHE_TYPE *JOIN(LRU_CACHE_NAME, create)(const uint32_t capacity);
+
+/**
+ * @brief Destroy a cache and free the underlying memory with the allocator it
+ *        was created with.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The cache pointer.
+ */
+FUNCTION_LINKAGE void JOIN(LRU_CACHE_NAME, destroy)(LRU_CACHE_TYPE *self);
+
+/**
+ * @brief Return whether the cache is empty.
+ *
+ * @param[in] self              The cache pointer.
+ *
+ * @return                      Whether the cache is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, is_empty)(const LRU_CACHE_TYPE *self);
+
+/**
+ * @brief Return whether the cache is full, so putting a new key evicts an
+ *        entry.
+ *
+ * @param[in] self              The cache pointer.
+ *
+ * @return                      Whether the cache is full.
+ */
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, is_full)(const LRU_CACHE_TYPE *self);
+
+/**
+ * @brief Check if the cache contains a key, without marking it as used.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the cache contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, contains_key)(const LRU_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Get the pointer to the value of a key, and mark it as the most
+ *        recently used.
+ *
+ * @note The returned pointer stays valid until the entry is evicted or
+ *       deleted.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the cache did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(LRU_CACHE_NAME, get)(LRU_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Get the pointer to the value of a key, without marking it as used.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the cache did not contain the key.
+ */
+FUNCTION_LINKAGE const VALUE_TYPE *JOIN(LRU_CACHE_NAME, peek)(const LRU_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Put a key and it's value in the cache, and mark it as the most
+ *        recently used. If the key is already contained, it's value is
+ *        replaced.
+ *
+ * If the key is new and the cache is full, the least recently used entry is
+ * evicted first.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ * @param[in] on_evict          Function called with the key and value of the evicted entry. May be NULL.
+ * @param[in] context_ptr       Context given to `on_evict`.
+ *
+ * @return                      Whether an entry was evicted.
+ */
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, put)(LRU_CACHE_TYPE *self, KEY_TYPE key, VALUE_TYPE value,
+                                                void (*on_evict)(void *context_ptr, KEY_TYPE key, VALUE_TYPE value),
+                                                void *context_ptr);
+
+/**
+ * @brief Delete a key and it's value from the cache.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         cache.
+ */
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, delete)(LRU_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear the cache.
+ *
+ * @param[in] self              The cache pointer.
+ */
+FUNCTION_LINKAGE void JOIN(LRU_CACHE_NAME, clear)(LRU_CACHE_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(LRU_CACHE_NAME, reset))(LRU_CACHE_TYPE *self)
+{
+    self->count = 0;
+    self->n_untouched = self->capacity;
+    JOIN(LIST_NAME, node_init)(&self->head);
+    JOIN(LIST_NAME, node_init)(&self->free_head);
+}
+/// @endcond
+
+FUNCTION_LINKAGE LRU_CACHE_TYPE *JOIN(LRU_CACHE_NAME, create_custom)(
+    const uint32_t capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem))
+{
+    const size_t max_capacity = (SIZE_MAX - offsetof(LRU_CACHE_TYPE, entries)) / sizeof(LRU_CACHE_ENTRY_TYPE);
+
+    if (capacity == 0 || capacity > UINT32_MAX / 2 || capacity > max_capacity) {
+        return NULL;
+    }
+
+    const size_t size = offsetof(LRU_CACHE_TYPE, entries) + capacity * sizeof(LRU_CACHE_ENTRY_TYPE);
+
+    LRU_CACHE_TYPE *self = (LRU_CACHE_TYPE *)allocate(context_ptr, alignof(LRU_CACHE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->table_ptr = JOIN(TABLE_NAME, create_custom)(capacity + capacity / 3, context_ptr, allocate);
+
+    if (!self->table_ptr) {
+        deallocate(context_ptr, self);
+        return NULL;
+    }
+
+    self->capacity = capacity;
+    self->context_ptr = context_ptr;
+    self->allocate = allocate;
+    self->deallocate = deallocate;
+    JOIN(internal, JOIN(LRU_CACHE_NAME, reset))(self);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(LRU_CACHE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+
+static inline void JOIN(internal, JOIN(LRU_CACHE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE LRU_CACHE_TYPE *JOIN(LRU_CACHE_NAME, create)(const uint32_t capacity)
+{
+    return JOIN(LRU_CACHE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(LRU_CACHE_NAME, allocate)),
+                                               JOIN(internal, JOIN(LRU_CACHE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(LRU_CACHE_NAME, destroy)(LRU_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(TABLE_NAME, destroy_custom)(self->table_ptr, self->context_ptr, self->deallocate);
+
+    self->deallocate(self->context_ptr, self);
+}
+
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, is_empty)(const LRU_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, is_full)(const LRU_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline LRU_CACHE_ENTRY_TYPE *JOIN(internal, JOIN(LRU_CACHE_NAME, find))(const LRU_CACHE_TYPE *self,
+                                                                                const KEY_TYPE key)
+{
+    const uint32_t index = JOIN(TABLE_NAME, get_value)(self->table_ptr, key, UINT32_MAX);
+
+    return index != UINT32_MAX ? (LRU_CACHE_ENTRY_TYPE *)&self->entries[index] : NULL;
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, contains_key)(const LRU_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    return JOIN(TABLE_NAME, contains_key)(self->table_ptr, key);
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(LRU_CACHE_NAME, get)(LRU_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    LRU_CACHE_ENTRY_TYPE *entry_ptr = LRU_CACHE_FIND(self, key);
+
+    if (!entry_ptr) {
+        return NULL;
+    }
+    if (!JOIN(LIST_NAME, node_is_first)(&self->head, &entry_ptr->node)) {
+        JOIN(LIST_NAME, node_remove)(&entry_ptr->node);
+        JOIN(LIST_NAME, node_add_after)(&self->head, &entry_ptr->node);
+    }
+    return &entry_ptr->value;
+}
+
+FUNCTION_LINKAGE const VALUE_TYPE *JOIN(LRU_CACHE_NAME, peek)(const LRU_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    const LRU_CACHE_ENTRY_TYPE *entry_ptr = LRU_CACHE_FIND(self, key);
+
+    return entry_ptr ? &entry_ptr->value : NULL;
+}
+
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, put)(LRU_CACHE_TYPE *self, KEY_TYPE key, VALUE_TYPE value,
+                                                void (*on_evict)(void *context_ptr, KEY_TYPE key, VALUE_TYPE value),
+                                                void *context_ptr)
+{
+    assert(self != NULL);
+
+    VALUE_TYPE *value_ptr = JOIN(LRU_CACHE_NAME, get)(self, key);
+
+    if (value_ptr) {
+        *value_ptr = value;
+        return false;
+    }
+
+    LRU_CACHE_ENTRY_TYPE *entry_ptr;
+    bool is_evicted = false;
+
+    if (self->count == self->capacity) {
+        entry_ptr = (LRU_CACHE_ENTRY_TYPE *)JOIN(LIST_NAME, node_remove)(self->head.prev_ptr);
+
+        const bool is_deleted = JOIN(TABLE_NAME, delete)(self->table_ptr, entry_ptr->key);
+        assert(is_deleted);
+        (void)is_deleted;
+
+        if (on_evict) {
+            on_evict(context_ptr, entry_ptr->key, entry_ptr->value);
+        }
+        self->count--;
+        is_evicted = true;
+    }
+    else if (!JOIN(LIST_NAME, node_is_singular)(&self->free_head)) {
+        entry_ptr = (LRU_CACHE_ENTRY_TYPE *)JOIN(LIST_NAME, node_remove)(self->free_head.next_ptr);
+    }
+    else {
+        entry_ptr = &self->entries[self->capacity - self->n_untouched--];
+        JOIN(LIST_NAME, node_init)(&entry_ptr->node);
+    }
+
+    entry_ptr->key = key;
+    entry_ptr->value = value;
+    JOIN(LIST_NAME, node_add_after)(&self->head, &entry_ptr->node);
+    JOIN(TABLE_NAME, insert)(self->table_ptr, key, (uint32_t)(entry_ptr - self->entries));
+    self->count++;
+
+    return is_evicted;
+}
+
+FUNCTION_LINKAGE bool JOIN(LRU_CACHE_NAME, delete)(LRU_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    LRU_CACHE_ENTRY_TYPE *entry_ptr = LRU_CACHE_FIND(self, key);
+
+    if (!entry_ptr) {
+        return false;
+    }
+
+    JOIN(TABLE_NAME, delete)(self->table_ptr, key);
+    JOIN(LIST_NAME, node_remove)(&entry_ptr->node);
+    JOIN(LIST_NAME, node_add_after)(&self->free_head, &entry_ptr->node);
+    self->count--;
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(LRU_CACHE_NAME, clear)(LRU_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(TABLE_NAME, clear)(self->table_ptr);
+    JOIN(internal, JOIN(LRU_CACHE_NAME, reset))(self);
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef TABLE_NAME
+#undef LIST_NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef LRU_CACHE_NAME
+#undef LRU_CACHE_TYPE
+#undef LRU_CACHE_ENTRY_TYPE
+#undef LRU_CACHE_TABLE_TYPE
+#undef LRU_CACHE_NODE_TYPE
+#undef LRU_CACHE_FIND
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
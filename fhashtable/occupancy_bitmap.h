@@ -0,0 +1,98 @@
+/**
+ * @file occupancy_bitmap.h
+ * @brief Find the occupied slots in a bitmap of slots
+ *
+ * Bit `i % 64` of word `i / 64` is set if slot `i` is occupied. Finding the
+ * next occupied slot skips 64 empty slots per word, and finds the slot within
+ * a word by counting the trailing zero bits (`tzcnt` / `bsf` on x86).
+ *
+ * Sources used:
+ *  @li https://lemire.me/blog/2018/02/21/iterating-over-set-bits-quickly/
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @def OCCUPANCY_BITMAP_N_WORDS(capacity)
+ * @brief Number of 64-bit words in the bitmap of a given number of slots.
+ */
+#define OCCUPANCY_BITMAP_N_WORDS(capacity) (((capacity) + 63) / 64)
+
+/**
+ * @brief Get the lowest set bit position of a non-zero word.
+ *
+ * @param[in] word              The word.
+ *
+ * @return                      The bit position.
+ */
+static inline uint32_t occupancy_bitmap_lowest(const uint64_t word)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctzll(word);
+#else
+    uint32_t n = 0;
+    while (!((word >> n) & 1)) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief Get the first occupied slot at or after an index.
+ *
+ * @param[in] words             The bitmap.
+ * @param[in] capacity          Number of slots. The bits past it must not be set.
+ * @param[in] index             The index to start from.
+ *
+ * @return                      The index of the slot.
+ * @retval capacity             If there is no occupied slot left.
+ */
+static inline size_t occupancy_bitmap_next(const uint64_t *words, const size_t capacity, const size_t index)
+{
+    if (index >= capacity) {
+        return capacity;
+    }
+
+    const size_t n_words = OCCUPANCY_BITMAP_N_WORDS(capacity);
+    size_t w = index / 64;
+    uint64_t word = words[w] & (~UINT64_C(0) << (index % 64));
+
+    while (word == 0) {
+        if (++w == n_words) {
+            return capacity;
+        }
+        word = words[w];
+    }
+    return w * 64 + occupancy_bitmap_lowest(word);
+}
+
+/**
+ * @brief 32-bit version of `occupancy_bitmap_next`.
+ */
+static inline uint32_t occupancy_bitmap_next_32(const uint64_t *words, const uint32_t capacity, const uint32_t index)
+{
+    return (uint32_t)occupancy_bitmap_next(words, capacity, index);
+}
+
+/**
+ * @def OCCUPANCY_BITMAP_NEXT(words, capacity, index)
+ * @brief Call `occupancy_bitmap_next_32` for an `uint32_t` index, and
+ *        `occupancy_bitmap_next` otherwise, so the result has the type of the
+ *        index. Only available in C11.
+ */
+#define OCCUPANCY_BITMAP_NEXT(words, capacity, index) \
+    _Generic((index), uint32_t: occupancy_bitmap_next_32, default: occupancy_bitmap_next)((words), (capacity), (index))
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c
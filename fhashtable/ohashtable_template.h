@@ -0,0 +1,907 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file ohashtable_template.h
+ * @brief Fixed-size insertion-ordered hashtable (compact dict)
+ *
+ * The entries are stored densely in insertion order, each with it's hash, key
+ * and value. A separate array of (robin hood hashed) indices into the entries
+ * is used for lookups. The indices are 8, 16 or 32 bits wide depending on the
+ * capacity, so displacing an index moves 1 to 4 bytes instead of a whole slot.
+ *
+ * Iterating with `OHASHTABLE_FOR_EACH` scans the entries in insertion order
+ * instead of all the slots. Deleted entries leave holes, which are skipped
+ * when iterating. The holes are compacted away when an entry is inserted and
+ * the end of the entries is reached.
+ *
+ * Ensure the capacity rounded up to the power of 2 is 75% of the expected
+ * numbers of keys to be stored to keep load factor low and the hash table
+ * performant.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * The following macros must be defined in the implementation:
+ *      @li `KEY_IS_EQUAL(a,b)`
+ *      @li `HASH_FUNCTION(key)`
+ *
+ * Source(s) used:
+ *  @li https://mail.python.org/pipermail/python-dev/2012-December/123028.html
+ *  @li https://thenumb.at/Hashtables/#robin-hood-linear-probing
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @brief Macro to check if a number is a power of two.
+ *
+ * @param[in] X             The number at hand.
+ *
+ * @return                  A boolean value indicating whether the number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def OHASHTABLE_DELETED_HASH
+ * @brief Hash constant used to flag deleted entries. The hashes of the
+ *        entries are stored without the top bit, so it never clashes.
+ */
+#ifndef OHASHTABLE_DELETED_HASH
+#define OHASHTABLE_DELETED_HASH (UINT32_MAX)
+#endif
+
+/**
+ * @def OHASHTABLE_EMPTY_INDEX
+ * @brief Index constant used to flag empty slots of the index array.
+ */
+#ifndef OHASHTABLE_EMPTY_INDEX
+#define OHASHTABLE_EMPTY_INDEX (UINT32_MAX)
+#endif
+
+/**
+ * @def OHASHTABLE_INDEX_WIDTH(capacity)
+ * @brief Width in bytes of the indices of a given capacity. The largest index
+ *        value of each width flags empty slots.
+ */
+#ifndef OHASHTABLE_INDEX_WIDTH
+#define OHASHTABLE_INDEX_WIDTH(capacity) \
+    ((capacity) <= (UINT8_MAX >> 1) + 1 ? 1 : (capacity) <= (UINT16_MAX >> 1) + 1 ? 2 : 4)
+#endif
+
+/**
+ * @def OHASHTABLE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the entries in the hashtable in insertion order.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef OHASHTABLE_FOR_EACH
+#define OHASHTABLE_FOR_EACH(self, index, key_, value_)               \
+    for ((index) = 0; (index) < (self)->n_entries; (index)++)        \
+        if ((self)->entries[(index)].hash != OHASHTABLE_DELETED_HASH \
+            && ((key_) = (self)->entries[(index)].key, (value_) = (self)->entries[(index)].value, true))
+#endif
+
+/**
+ * @def OHASHTABLE_CALC_SIZEOF(ohashtable_name, capacity)
+ *
+ * @brief Calculate the size of the hashtable struct, including the index
+ *        array. No overflow checks.
+ *
+ * @param[in] ohashtable_name   Defined hashtable NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#ifndef OHASHTABLE_CALC_SIZEOF
+#define OHASHTABLE_CALC_SIZEOF(ohashtable_name, capacity) \
+    (uint32_t)(offsetof(struct ohashtable_name, entries)  \
+               + capacity * (sizeof(((struct ohashtable_name *)0)->entries[0]) + OHASHTABLE_INDEX_WIDTH(capacity)))
+#endif
+
+/**
+ * @def OHASHTABLE_CALC_SIZEOF_OVERFLOWS(ohashtable_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the hashtable struct overflows.
+ *
+ * @param[in] ohashtable_name   Defined hashtable NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#ifndef OHASHTABLE_CALC_SIZEOF_OVERFLOWS
+#define OHASHTABLE_CALC_SIZEOF_OVERFLOWS(ohashtable_name, capacity)      \
+    (capacity > (UINT32_MAX - offsetof(struct ohashtable_name, entries)) \
+                    / (sizeof(((struct ohashtable_name *)0)->entries[0]) + OHASHTABLE_INDEX_WIDTH(capacity)))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define OHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define OHASHTABLE_TYPE       struct OHASHTABLE_NAME
+#define OHASHTABLE_ENTRY_TYPE struct JOIN(OHASHTABLE_NAME, entry)
+#define OHASHTABLE_INIT       JOIN(OHASHTABLE_NAME, init)
+#define OHASHTABLE_GET_INDEX  JOIN(internal, JOIN(OHASHTABLE_NAME, get_index))
+#define OHASHTABLE_SET_INDEX  JOIN(internal, JOIN(OHASHTABLE_NAME, set_index))
+#define OHASHTABLE_FIND       JOIN(internal, JOIN(OHASHTABLE_NAME, find))
+#define OHASHTABLE_PLACE      JOIN(internal, JOIN(OHASHTABLE_NAME, place))
+#define OHASHTABLE_COMPACT    JOIN(internal, JOIN(OHASHTABLE_NAME, compact))
+#define OHASHTABLE_INSERT     JOIN(internal, JOIN(OHASHTABLE_NAME, insert))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(OHASHTABLE_NAME, entry);
+struct OHASHTABLE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated hashtable entry struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct JOIN(OHASHTABLE_NAME, entry) {
+    uint32_t hash;    ///< Hash of the key without the top bit, or `OHASHTABLE_DELETED_HASH`.
+    KEY_TYPE key;     ///< The key in this entry.
+    VALUE_TYPE value; ///< The value in this entry.
+};
+
+/**
+ * @brief Generated hashtable struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ *
+ * The index array of `capacity` indices of `index_width` bytes follows the
+ * entries.
+ */
+struct OHASHTABLE_NAME {
+    uint32_t count;                  ///< Number of entries not deleted.
+    uint32_t n_entries;              ///< Number of entries, including the deleted ones.
+    uint32_t capacity;               ///< Number of entries and index slots.
+    uint32_t index_width;            ///< Width of the indices in bytes.
+    OHASHTABLE_ENTRY_TYPE entries[]; ///< Array of entries.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Initialize a hashtable struct, given a (power-of-2) capacity.
+ *
+ * @param[in] self              Hashtable pointer
+ * @param[in] pow2_capacity     Power of 2 capacity.
+ */
+FUNCTION_LINKAGE OHASHTABLE_TYPE *JOIN(OHASHTABLE_NAME, init)(OHASHTABLE_TYPE *self, const uint32_t pow2_capacity);
+
+/**
+ * @brief Create an hashtable with a given capacity with a custom allocator.
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent
+ *                              size overflows.
+ */
+FUNCTION_LINKAGE OHASHTABLE_TYPE *
+    JOIN(OHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                         void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
+
+/**
+ * @brief Create an hashtable with a given capacity with malloc().
+ *
+ * @param[in] min_capacity      Maximum number of elements to be stored.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0 or larger than UINT32_MAX / 2 + 1 or the equivalent
+ *                              size overflows.
+ */
+FUNCTION_LINKAGE OHASHTABLE_TYPE *JOIN(OHASHTABLE_NAME, create)(const uint32_t min_capacity);
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        a custom allocator.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, destroy_custom)(OHASHTABLE_TYPE *self, void *context_ptr,
+                                                            void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, destroy)(OHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether the hashtable is empty.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, is_empty)(const OHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether the hashtable is full.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is full.
+ */
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, is_full)(const OHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, contains_key)(const OHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the pointer to the corresponding value in the
+ *        hashtable.
+ *
+ * @note The returned pointer is **not** garanteed to point to the same value if
+ *       the hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding key.
+ *  @retval NULL                If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(OHASHTABLE_NAME, get_value_mut)(OHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the copy of the corresponding value in the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding key.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE JOIN(OHASHTABLE_NAME, get_value)(const OHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value);
+
+/**
+ * @brief Insert a non-duplicate key and it's corresponding value inside the
+ *        hashtable, after the entries inserted before it.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, insert)(OHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Update a key's corresponding value inside the hashtable. Allows
+ *        duplicates. An updated key keeps it's place in the insertion order.
+ *
+ * @note The hashtable may not be full if it does not contain the key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, update)(OHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Delete a key and it's corresponding value from the hashtable.
+ *
+ * The entry is flagged as deleted, and the order of the other entries is kept.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashtable.
+ */
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, delete)(OHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashtable and flag all index slots as empty.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, clear)(OHASHTABLE_TYPE *self);
+
+/**
+ * @brief Copy the entries of a source hashtable to a destination hashtable in
+ *        insertion order, leaving out the deleted entries.
+ *
+ * @param[out] dest_ptr         The destination hashtable. Must be empty.
+ * @param[in] src_ptr           The source hashtable.
+ */
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, copy)(OHASHTABLE_TYPE *restrict dest_ptr,
+                                                  const OHASHTABLE_TYPE *restrict src_ptr);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "round_up_pow2_32.h" // round_up_pow2_32
+
+/**
+ * @def KEY_IS_EQUAL(a, b)
+ * @brief Used to compare two keys This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @attention
+ *   @li If comparing two scalar values, set this macro to ((a) == (b)).
+ *   @li If comparing two strings, set this macro to strcmp() or strncmp()
+ *       appropiately.
+ *   @li If comparing two structs, set this macro to a function that does
+ *       element-wise comparison between the structs.
+ *
+ * @retval true If the two keys are equal. Equivalent to a non-zero int.
+ * @retval false If the two key are not equal. Equivalent to the int 0.
+ */
+#ifndef KEY_IS_EQUAL
+#error "Must define KEY_IS_EQUAL."
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute indicies of keys. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key.
+ * @return The hash of the key as `uint32_t`. The top bit is not used.
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+static inline uint32_t JOIN(internal, JOIN(OHASHTABLE_NAME, get_index))(const OHASHTABLE_TYPE *self,
+                                                                         const uint32_t slot)
+{
+    const void *indices = &self->entries[self->capacity];
+
+    switch (self->index_width) {
+    case 1: {
+        const uint8_t index = ((const uint8_t *)indices)[slot];
+        return index == UINT8_MAX ? OHASHTABLE_EMPTY_INDEX : index;
+    }
+    case 2: {
+        const uint16_t index = ((const uint16_t *)indices)[slot];
+        return index == UINT16_MAX ? OHASHTABLE_EMPTY_INDEX : index;
+    }
+    default:
+        return ((const uint32_t *)indices)[slot];
+    }
+}
+
+static inline void JOIN(internal, JOIN(OHASHTABLE_NAME, set_index))(OHASHTABLE_TYPE *self, const uint32_t slot,
+                                                                     const uint32_t index)
+{
+    void *indices = &self->entries[self->capacity];
+
+    switch (self->index_width) {
+    case 1:
+        ((uint8_t *)indices)[slot] = (uint8_t)index;
+        break;
+    case 2:
+        ((uint16_t *)indices)[slot] = (uint16_t)index;
+        break;
+    default:
+        ((uint32_t *)indices)[slot] = index;
+        break;
+    }
+}
+/// @endcond
+
+FUNCTION_LINKAGE OHASHTABLE_TYPE *JOIN(OHASHTABLE_NAME, init)(OHASHTABLE_TYPE *self, const uint32_t pow2_capacity)
+{
+    assert(self);
+    assert(IS_POW2(pow2_capacity));
+
+    self->count = 0;
+    self->n_entries = 0;
+    self->capacity = pow2_capacity;
+    self->index_width = OHASHTABLE_INDEX_WIDTH(pow2_capacity);
+
+    memset(&self->entries[self->capacity], UINT8_MAX, (size_t)self->capacity * self->index_width);
+
+    return self;
+}
+
+FUNCTION_LINKAGE OHASHTABLE_TYPE *
+    JOIN(OHASHTABLE_NAME, create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                         void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    const uint32_t capacity = round_up_pow2_32(min_capacity);
+
+    if (OHASHTABLE_CALC_SIZEOF_OVERFLOWS(OHASHTABLE_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = OHASHTABLE_CALC_SIZEOF(OHASHTABLE_NAME, capacity);
+
+    OHASHTABLE_TYPE *self = (OHASHTABLE_TYPE *)allocate(context_ptr, alignof(OHASHTABLE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    OHASHTABLE_INIT(self, capacity);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(OHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+/// @endcond
+
+FUNCTION_LINKAGE OHASHTABLE_TYPE *JOIN(OHASHTABLE_NAME, create)(const uint32_t capacity)
+{
+    return JOIN(OHASHTABLE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(OHASHTABLE_NAME, allocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, destroy_custom)(OHASHTABLE_TYPE *self, void *context_ptr,
+                                                            void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(OHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, destroy)(OHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(OHASHTABLE_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(OHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, is_empty)(const OHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, is_full)(const OHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+// Find the index slot of a key. If it's not contained, slot and offset are set to where the key's index would be
+// placed: an empty slot or the first slot closer to it's ideal slot than the key's index would be.
+static inline bool JOIN(internal, JOIN(OHASHTABLE_NAME, find))(const OHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                                const uint32_t key_hash, uint32_t *slot_ptr,
+                                                                uint32_t *offset_ptr)
+{
+    const uint32_t slot_mask = self->capacity - 1;
+
+    uint32_t slot = key_hash & slot_mask;
+    uint32_t max_possible_offset = 0;
+
+    while (true) {
+        const uint32_t index = OHASHTABLE_GET_INDEX(self, slot);
+
+        if (index == OHASHTABLE_EMPTY_INDEX) {
+            break;
+        }
+
+        const uint32_t entry_hash = self->entries[index].hash;
+
+        if (((slot - entry_hash) & slot_mask) < max_possible_offset) {
+            break;
+        }
+
+        if (entry_hash == key_hash && KEY_IS_EQUAL(self->entries[index].key, key)) {
+            *slot_ptr = slot;
+            return true;
+        }
+
+        slot++;
+        slot &= slot_mask;
+        max_possible_offset++;
+    }
+    *slot_ptr = slot;
+    *offset_ptr = max_possible_offset;
+    return false;
+}
+
+// Place an entry index at a slot, which is empty or holds an index closer to it's ideal slot. The following indices
+// are displaced as needed.
+static inline void JOIN(internal, JOIN(OHASHTABLE_NAME, place))(OHASHTABLE_TYPE *self, uint32_t slot,
+                                                                 uint32_t offset, uint32_t index)
+{
+    const uint32_t slot_mask = self->capacity - 1;
+
+    while (true) {
+        const uint32_t slot_index = OHASHTABLE_GET_INDEX(self, slot);
+
+        if (slot_index == OHASHTABLE_EMPTY_INDEX) {
+            break;
+        }
+
+        const uint32_t slot_offset = (slot - self->entries[slot_index].hash) & slot_mask;
+
+        if (offset > slot_offset) {
+            OHASHTABLE_SET_INDEX(self, slot, index);
+            index = slot_index;
+            offset = slot_offset;
+        }
+        slot++;
+        slot &= slot_mask;
+        offset++;
+    }
+    OHASHTABLE_SET_INDEX(self, slot, index);
+}
+
+// Move the entries not deleted to the front, keeping their order, and rebuild the index array.
+static inline void JOIN(internal, JOIN(OHASHTABLE_NAME, compact))(OHASHTABLE_TYPE *self)
+{
+    const uint32_t slot_mask = self->capacity - 1;
+
+    memset(&self->entries[self->capacity], UINT8_MAX, (size_t)self->capacity * self->index_width);
+
+    uint32_t n_entries = 0;
+    for (uint32_t i = 0; i < self->n_entries; i++) {
+        if (self->entries[i].hash == OHASHTABLE_DELETED_HASH) {
+            continue;
+        }
+        self->entries[n_entries] = self->entries[i];
+        OHASHTABLE_PLACE(self, self->entries[n_entries].hash & slot_mask, 0, n_entries);
+        n_entries++;
+    }
+    assert(n_entries == self->count);
+    self->n_entries = n_entries;
+}
+
+static inline void JOIN(internal, JOIN(OHASHTABLE_NAME, insert))(OHASHTABLE_TYPE *self, uint32_t slot,
+                                                                  const uint32_t offset, const uint32_t key_hash,
+                                                                  KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self->count < self->capacity);
+
+    if (self->n_entries == self->capacity) {
+        OHASHTABLE_COMPACT(self);
+
+        // the index array is rebuilt, so the key is looked up again:
+        uint32_t new_offset = 0;
+        const bool found = OHASHTABLE_FIND(self, key, key_hash, &slot, &new_offset);
+        assert(!found);
+        (void)found;
+        OHASHTABLE_PLACE(self, slot, new_offset, self->n_entries);
+    }
+    else {
+        OHASHTABLE_PLACE(self, slot, offset, self->n_entries);
+    }
+
+    const OHASHTABLE_ENTRY_TYPE entry = {.hash = key_hash, .key = key, .value = value};
+    self->entries[self->n_entries++] = entry;
+    self->count++;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, contains_key)(const OHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t slot, offset;
+
+    return OHASHTABLE_FIND(self, key, HASH_FUNCTION(key) & (UINT32_MAX >> 1), &slot, &offset);
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(OHASHTABLE_NAME, get_value_mut)(OHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t slot, offset;
+
+    if (!OHASHTABLE_FIND(self, key, HASH_FUNCTION(key) & (UINT32_MAX >> 1), &slot, &offset)) {
+        return NULL;
+    }
+    return &self->entries[OHASHTABLE_GET_INDEX(self, slot)].value;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE JOIN(OHASHTABLE_NAME, get_value)(const OHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value)
+{
+    assert(self != NULL);
+
+    uint32_t slot, offset;
+
+    if (!OHASHTABLE_FIND(self, key, HASH_FUNCTION(key) & (UINT32_MAX >> 1), &slot, &offset)) {
+        return default_value;
+    }
+    return self->entries[OHASHTABLE_GET_INDEX(self, slot)].value;
+}
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, insert)(OHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    const uint32_t key_hash = HASH_FUNCTION(key) & (UINT32_MAX >> 1);
+
+    uint32_t slot, offset;
+
+    const bool found = OHASHTABLE_FIND(self, key, key_hash, &slot, &offset);
+    assert(!found);
+    (void)found;
+
+    OHASHTABLE_INSERT(self, slot, offset, key_hash, key, value);
+}
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, update)(OHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    const uint32_t key_hash = HASH_FUNCTION(key) & (UINT32_MAX >> 1);
+
+    uint32_t slot, offset;
+
+    if (OHASHTABLE_FIND(self, key, key_hash, &slot, &offset)) {
+        self->entries[OHASHTABLE_GET_INDEX(self, slot)].value = value;
+        return;
+    }
+    OHASHTABLE_INSERT(self, slot, offset, key_hash, key, value);
+}
+
+FUNCTION_LINKAGE bool JOIN(OHASHTABLE_NAME, delete)(OHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    uint32_t slot, offset;
+
+    if (!OHASHTABLE_FIND(self, key, HASH_FUNCTION(key) & (UINT32_MAX >> 1), &slot, &offset)) {
+        return false;
+    }
+
+    self->entries[OHASHTABLE_GET_INDEX(self, slot)].hash = OHASHTABLE_DELETED_HASH;
+    self->count--;
+
+    // backshift the following indices:
+    const uint32_t slot_mask = self->capacity - 1;
+
+    uint32_t next_slot = (slot + 1) & slot_mask;
+
+    while (true) {
+        const uint32_t next_index = OHASHTABLE_GET_INDEX(self, next_slot);
+
+        if (next_index == OHASHTABLE_EMPTY_INDEX || (self->entries[next_index].hash & slot_mask) == next_slot) {
+            break;
+        }
+        OHASHTABLE_SET_INDEX(self, slot, next_index);
+
+        slot = next_slot;
+        next_slot = (slot + 1) & slot_mask;
+    }
+    OHASHTABLE_SET_INDEX(self, slot, OHASHTABLE_EMPTY_INDEX);
+
+    // deleting the last entries frees their place:
+    while (self->n_entries > 0 && self->entries[self->n_entries - 1].hash == OHASHTABLE_DELETED_HASH) {
+        self->n_entries--;
+    }
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, clear)(OHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    memset(&self->entries[self->capacity], UINT8_MAX, (size_t)self->capacity * self->index_width);
+
+    self->count = 0;
+    self->n_entries = 0;
+}
+
+FUNCTION_LINKAGE void JOIN(OHASHTABLE_NAME, copy)(OHASHTABLE_TYPE *restrict dest_ptr,
+                                                  const OHASHTABLE_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(src_ptr->count <= dest_ptr->capacity);
+    assert(dest_ptr->count == 0 && dest_ptr->n_entries == 0);
+
+    // the hashes are stored, so the keys are not hashed again:
+    const uint32_t slot_mask = dest_ptr->capacity - 1;
+
+    for (uint32_t i = 0; i < src_ptr->n_entries; i++) {
+        if (src_ptr->entries[i].hash == OHASHTABLE_DELETED_HASH) {
+            continue;
+        }
+        dest_ptr->entries[dest_ptr->n_entries] = src_ptr->entries[i];
+        OHASHTABLE_PLACE(dest_ptr, src_ptr->entries[i].hash & slot_mask, 0, dest_ptr->n_entries);
+        dest_ptr->n_entries++;
+    }
+    dest_ptr->count = dest_ptr->n_entries;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef KEY_IS_EQUAL
+#undef HASH_FUNCTION
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef OHASHTABLE_NAME
+#undef OHASHTABLE_TYPE
+#undef OHASHTABLE_ENTRY_TYPE
+#undef OHASHTABLE_INIT
+#undef OHASHTABLE_GET_INDEX
+#undef OHASHTABLE_SET_INDEX
+#undef OHASHTABLE_FIND
+#undef OHASHTABLE_PLACE
+#undef OHASHTABLE_COMPACT
+#undef OHASHTABLE_INSERT
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
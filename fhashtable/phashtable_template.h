@@ -0,0 +1,674 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file phashtable_template.h
+ * @brief Read-only hashtable based on a minimal perfect hash function (built
+ *        from fhashtable)
+ *
+ * A populated `fhashtable_template.h` instance is frozen into a table with
+ * exactly one slot per key, so the load is 100%. Every key is mapped to its
+ * own slot by a minimal perfect hash function. Lookups hash the key, read a
+ * small "pilot" number of the key's bucket, and compare the key in a single
+ * slot. There is no probing.
+ *
+ * The keys are split into buckets of about `PHASHTABLE_BUCKET_SIZE` keys. For
+ * each bucket, largest first, the smallest pilot is searched for, which places
+ * all keys of the bucket in free slots. This costs 4 bytes per bucket.
+ *
+ * The keys are fixed once frozen. The values may be modified in place through
+ * `get_value_mut`.
+ *
+ * `HASH_FUNCTION` should give distinct hashes for distinct keys: keys with the
+ * same hash can not be separated, and freezing fails. A 64-bit hash makes this
+ * unlikely for large key sets. The hash is mixed before use, so it does not
+ * need to be well-distributed.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `TABLE_NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * The following macros must be defined in the implementation:
+ *      @li `KEY_IS_EQUAL(a,b)`
+ *      @li `HASH_FUNCTION(key)`
+ *
+ * The following macros can be defined in the implementation:
+ *      @li `TABLE_FOR_EACH`
+ *
+ * Source(s) used:
+ *  @li https://arxiv.org/abs/2104.10402 (PTHash)
+ *  @li https://cmph.sourceforge.net/papers/esa09.pdf (CHD)
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def PHASHTABLE_BUCKET_SIZE
+ * @brief Average number of keys per bucket.
+ *
+ * Larger buckets take less space for the pilots, but make freezing slower.
+ */
+#ifndef PHASHTABLE_BUCKET_SIZE
+#define PHASHTABLE_BUCKET_SIZE (4)
+#endif
+
+/**
+ * @def PHASHTABLE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the keys and values in the hashtable in arbitary order.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef PHASHTABLE_FOR_EACH
+#define PHASHTABLE_FOR_EACH(self, index, key_, value_)   \
+    for ((index) = 0; (index) < (self)->count; (index)++) \
+        if (((key_) = (self)->slots[(index)].key, (value_) = (self)->slots[(index)].value, true))
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#ifndef PHASHTABLE_MIX
+// splitmix64 finalizer:
+static inline uint64_t internal_phashtable_mix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= UINT64_C(0xBF58476D1CE4E5B9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94D049BB133111EB);
+    x ^= x >> 31;
+    return x;
+}
+#define PHASHTABLE_MIX(x) internal_phashtable_mix((x))
+
+// map the upper 32 bits of a hash to [0, n) without division:
+#define PHASHTABLE_REDUCE(x, n) ((uint32_t)((((uint64_t)(x) >> 32) * (uint64_t)(n)) >> 32))
+
+#define PHASHTABLE_BUCKET_OF(mixed_hash, n_buckets) PHASHTABLE_REDUCE((mixed_hash) << 32, (n_buckets))
+#define PHASHTABLE_POSITION_OF(mixed_hash, pilot, count) \
+    PHASHTABLE_REDUCE(PHASHTABLE_MIX((mixed_hash) ^ (((uint64_t)(pilot) + 1) * UINT64_C(0x9E3779B97F4A7C15))), (count))
+#endif
+/// @endcond
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define PHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def TABLE_NAME
+ * @brief Name of the `fhashtable_template.h` instantiation frozen from. This
+ *        must be manually defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef TABLE_NAME
+#error "Must define TABLE_NAME."
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define PHASHTABLE_TYPE       struct PHASHTABLE_NAME
+#define PHASHTABLE_SLOT_TYPE  struct JOIN(PHASHTABLE_NAME, slot)
+#define PHASHTABLE_TABLE_TYPE struct TABLE_NAME
+#define PHASHTABLE_FIND_INDEX JOIN(internal, JOIN(PHASHTABLE_NAME, find_index))
+#define PHASHTABLE_NO_INDEX   (UINT32_MAX)
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated hashtable slot struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct JOIN(PHASHTABLE_NAME, slot) {
+    KEY_TYPE key;     ///< The key in this slot
+    VALUE_TYPE value; ///< The value in this slot
+};
+
+/**
+ * @brief Generated hashtable struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct PHASHTABLE_NAME {
+    uint32_t count;               ///< Number of keys and slots.
+    uint32_t n_buckets;           ///< Number of buckets.
+    uint32_t *pilots;             ///< Pilot of each bucket. Placed after the slots.
+    PHASHTABLE_SLOT_TYPE slots[]; ///< Array of slots.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Freeze the keys and values of an hashtable into a new read-only
+ *        hashtable with a custom allocator.
+ *
+ * Takes O(n) time on average. The source hashtable is left as is.
+ *
+ * @param[in] table_ptr         The hashtable to freeze.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function. Also used for temporary buffers.
+ * @param[in] deallocate        Deallocate function. Used for temporary buffers.
+ *
+ * @return                      A pointer to the frozen hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If two keys have the same hash.
+ */
+FUNCTION_LINKAGE PHASHTABLE_TYPE *
+    JOIN(PHASHTABLE_NAME, freeze_custom)(const PHASHTABLE_TABLE_TYPE *table_ptr, void *context_ptr,
+                                         void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+                                         void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Freeze the keys and values of an hashtable into a new read-only
+ *        hashtable with malloc() and free().
+ *
+ * @param[in] table_ptr         The hashtable to freeze.
+ *
+ * @return                      A pointer to the frozen hashtable.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If two keys have the same hash.
+ */
+FUNCTION_LINKAGE PHASHTABLE_TYPE *JOIN(PHASHTABLE_NAME, freeze)(const PHASHTABLE_TABLE_TYPE *table_ptr);
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        a custom allocator.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(PHASHTABLE_NAME, destroy_custom)(PHASHTABLE_TYPE *self, void *context_ptr,
+                                                            void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy an hashtable struct and free the underlying memory with
+ *        free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(PHASHTABLE_NAME, destroy)(PHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(PHASHTABLE_NAME, contains_key)(const PHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the pointer to the corresponding value in the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(PHASHTABLE_NAME, get_value_mut)(PHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the copy of the corresponding value in the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding value.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE JOIN(PHASHTABLE_NAME, get_value)(const PHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def KEY_IS_EQUAL(a, b)
+ * @brief Used to compare two keys This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @retval true If the two keys are equal. Equivalent to a non-zero int.
+ * @retval false If the two key are not equal. Equivalent to the int 0.
+ */
+#ifndef KEY_IS_EQUAL
+#error "Must define KEY_IS_EQUAL."
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#endif
+
+/**
+ * @def HASH_FUNCTION(key)
+ * @brief Used to compute the slots of keys. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined once header is included.
+ *
+ * @param key The key.
+ * @return The hash of the key as an unsigned integer of up to 64 bits.
+ */
+#ifndef HASH_FUNCTION
+#error "Must define HASH_FUNCTION."
+#define HASH_FUNCTION(key) (0)
+#endif
+
+/**
+ * @def TABLE_FOR_EACH(self, index, key_, value_)
+ * @brief Used to iterate over the hashtable frozen from. Should be defined as
+ *        `FHASHTABLE_SOA_FOR_EACH` if it was defined with
+ *        `FHASHTABLE_LAYOUT_SOA`.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef TABLE_FOR_EACH
+#define TABLE_FOR_EACH FHASHTABLE_FOR_EACH
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+
+// Place the keys of a bucket with a given pilot. Returns false, and leaves the taken slots as they were, if a slot is
+// already taken.
+static inline bool JOIN(internal, JOIN(PHASHTABLE_NAME, try_pilot))(const uint64_t *mixed_hashes,
+                                                                    const uint32_t *bucket_keys,
+                                                                    const uint32_t bucket_size, const uint32_t pilot,
+                                                                    const uint32_t count, uint64_t *taken_bits,
+                                                                    uint32_t *slot_of_key)
+{
+    for (uint32_t i = 0; i < bucket_size; i++) {
+        const uint32_t position = PHASHTABLE_POSITION_OF(mixed_hashes[bucket_keys[i]], pilot, count);
+
+        if (taken_bits[position / 64] & (UINT64_C(1) << (position % 64))) {
+            while (i-- > 0) {
+                const uint32_t prev_position = slot_of_key[bucket_keys[i]];
+                taken_bits[prev_position / 64] &= ~(UINT64_C(1) << (prev_position % 64));
+            }
+            return false;
+        }
+        taken_bits[position / 64] |= UINT64_C(1) << (position % 64);
+        slot_of_key[bucket_keys[i]] = position;
+    }
+    return true;
+}
+
+// Find the pilot of each bucket and the slot of each key. Returns false if two keys have the same hash.
+static inline bool JOIN(internal, JOIN(PHASHTABLE_NAME, search_pilots))(PHASHTABLE_TYPE *self,
+                                                                        const uint64_t *mixed_hashes,
+                                                                        uint32_t *slot_of_key, uint64_t *taken_bits,
+                                                                        uint32_t *bucket_start, uint32_t *bucket_keys,
+                                                                        uint32_t *size_start, uint32_t *order)
+{
+    const uint32_t count = self->count;
+    const uint32_t n_buckets = self->n_buckets;
+
+    // group the keys by bucket with a counting sort:
+    memset(bucket_start, 0, sizeof(uint32_t) * ((size_t)n_buckets + 1));
+    for (uint32_t i = 0; i < count; i++) {
+        bucket_start[PHASHTABLE_BUCKET_OF(mixed_hashes[i], n_buckets) + 1]++;
+    }
+    for (uint32_t b = 0; b < n_buckets; b++) {
+        bucket_start[b + 1] += bucket_start[b];
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        bucket_keys[bucket_start[PHASHTABLE_BUCKET_OF(mixed_hashes[i], n_buckets)]++] = i;
+    }
+    // each bucket start was moved to the next bucket start:
+    for (uint32_t b = n_buckets; b > 0; b--) {
+        bucket_start[b] = bucket_start[b - 1];
+    }
+    bucket_start[0] = 0;
+
+    // order the buckets from largest to smallest with another counting sort, so the large buckets are placed while
+    // most slots are free:
+    memset(size_start, 0, sizeof(uint32_t) * ((size_t)count + 2));
+    for (uint32_t b = 0; b < n_buckets; b++) {
+        size_start[count - (bucket_start[b + 1] - bucket_start[b]) + 1]++;
+    }
+    for (uint32_t i = 0; i <= count; i++) {
+        size_start[i + 1] += size_start[i];
+    }
+    for (uint32_t b = 0; b < n_buckets; b++) {
+        order[size_start[count - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+    }
+
+    memset(taken_bits, 0, sizeof(uint64_t) * ((size_t)count / 64 + 1));
+
+    for (uint32_t k = 0; k < n_buckets; k++) {
+        const uint32_t b = order[k];
+        const uint32_t *keys = &bucket_keys[bucket_start[b]];
+        const uint32_t bucket_size = bucket_start[b + 1] - bucket_start[b];
+
+        // no pilot separates keys with the same hash:
+        for (uint32_t i = 0; i < bucket_size; i++) {
+            for (uint32_t j = i + 1; j < bucket_size; j++) {
+                if (mixed_hashes[keys[i]] == mixed_hashes[keys[j]]) {
+                    return false;
+                }
+            }
+        }
+
+        uint32_t pilot = 0;
+        while (!JOIN(internal, JOIN(PHASHTABLE_NAME, try_pilot))(mixed_hashes, keys, bucket_size, pilot, count,
+                                                                 taken_bits, slot_of_key)) {
+            if (pilot == UINT32_MAX) {
+                return false;
+            }
+            pilot++;
+        }
+        self->pilots[b] = pilot;
+    }
+    return true;
+}
+
+static inline uint32_t JOIN(internal, JOIN(PHASHTABLE_NAME, find_index))(const PHASHTABLE_TYPE *self,
+                                                                         const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    if (self->count == 0) {
+        return PHASHTABLE_NO_INDEX;
+    }
+
+    const uint64_t mixed_hash = PHASHTABLE_MIX((uint64_t)HASH_FUNCTION(key));
+    const uint32_t pilot = self->pilots[PHASHTABLE_BUCKET_OF(mixed_hash, self->n_buckets)];
+    const uint32_t index = PHASHTABLE_POSITION_OF(mixed_hash, pilot, self->count);
+
+    return KEY_IS_EQUAL(self->slots[index].key, key) ? index : PHASHTABLE_NO_INDEX;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE PHASHTABLE_TYPE *
+    JOIN(PHASHTABLE_NAME, freeze_custom)(const PHASHTABLE_TABLE_TYPE *table_ptr, void *context_ptr,
+                                         void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+                                         void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(table_ptr != NULL);
+
+    // keeps the scratch buffer sizes below from overflowing:
+    if ((uint64_t)table_ptr->count > UINT32_MAX / 2) {
+        return NULL;
+    }
+#if SIZE_MAX <= UINT32_MAX
+    if (table_ptr->count > SIZE_MAX / 64) {
+        return NULL;
+    }
+#endif
+
+    const uint32_t count = (uint32_t)table_ptr->count;
+    const uint32_t n_buckets = count / PHASHTABLE_BUCKET_SIZE + 1;
+
+    const size_t pilots_offset =
+        (offsetof(PHASHTABLE_TYPE, slots) + sizeof(PHASHTABLE_SLOT_TYPE) * count + alignof(uint32_t) - 1)
+        / alignof(uint32_t) * alignof(uint32_t);
+    const size_t size = pilots_offset + sizeof(uint32_t) * n_buckets;
+
+    // scratch buffer: mixed_hashes[count], taken_bits[count / 64 + 1], slot_of_key[count],
+    // bucket_start[n_buckets + 1], bucket_keys[count], size_start[count + 2], order[n_buckets]
+    const size_t n_words = (size_t)count + count / 64 + 1;
+    const size_t n_halfwords = 3 * (size_t)count + 2 * (size_t)n_buckets + 3;
+    const size_t scratch_size = sizeof(uint64_t) * n_words + sizeof(uint32_t) * n_halfwords;
+
+    PHASHTABLE_TYPE *self = (PHASHTABLE_TYPE *)allocate(context_ptr, alignof(PHASHTABLE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    uint64_t *mixed_hashes = (uint64_t *)allocate(context_ptr, alignof(uint64_t), scratch_size);
+
+    if (!mixed_hashes) {
+        deallocate(context_ptr, self);
+        return NULL;
+    }
+
+    uint64_t *taken_bits = mixed_hashes + count;
+    uint32_t *slot_of_key = (uint32_t *)(mixed_hashes + n_words);
+    uint32_t *bucket_start = slot_of_key + count;
+    uint32_t *bucket_keys = bucket_start + n_buckets + 1;
+    uint32_t *size_start = bucket_keys + count;
+    uint32_t *order = size_start + count + 2;
+
+    self->count = count;
+    self->n_buckets = n_buckets;
+    self->pilots = (uint32_t *)((char *)self + pilots_offset);
+
+    size_t index;
+    KEY_TYPE key;
+    VALUE_TYPE value;
+    uint32_t i = 0;
+
+    TABLE_FOR_EACH(table_ptr, index, key, value)
+    {
+        mixed_hashes[i++] = PHASHTABLE_MIX((uint64_t)HASH_FUNCTION(key));
+    }
+
+    const bool has_found_pilots = JOIN(internal, JOIN(PHASHTABLE_NAME, search_pilots))(
+        self, mixed_hashes, slot_of_key, taken_bits, bucket_start, bucket_keys, size_start, order);
+
+    if (has_found_pilots) {
+        // the keys are visited in the same order as above:
+        i = 0;
+        TABLE_FOR_EACH(table_ptr, index, key, value)
+        {
+            self->slots[slot_of_key[i]].key = key;
+            self->slots[slot_of_key[i]].value = value;
+            i++;
+        }
+    }
+
+    deallocate(context_ptr, mixed_hashes);
+
+    if (!has_found_pilots) {
+        deallocate(context_ptr, self);
+        return NULL;
+    }
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(PHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+
+static inline void JOIN(internal, JOIN(PHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE PHASHTABLE_TYPE *JOIN(PHASHTABLE_NAME, freeze)(const PHASHTABLE_TABLE_TYPE *table_ptr)
+{
+    return JOIN(PHASHTABLE_NAME, freeze_custom)(table_ptr, NULL, JOIN(internal, JOIN(PHASHTABLE_NAME, allocate)),
+                                                JOIN(internal, JOIN(PHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(PHASHTABLE_NAME, destroy_custom)(PHASHTABLE_TYPE *self, void *context_ptr,
+                                                            void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+FUNCTION_LINKAGE void JOIN(PHASHTABLE_NAME, destroy)(PHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(PHASHTABLE_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(PHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE bool JOIN(PHASHTABLE_NAME, contains_key)(const PHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    return PHASHTABLE_FIND_INDEX(self, key) != PHASHTABLE_NO_INDEX;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(PHASHTABLE_NAME, get_value_mut)(PHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    const uint32_t index = PHASHTABLE_FIND_INDEX(self, key);
+
+    return index != PHASHTABLE_NO_INDEX ? &self->slots[index].value : NULL;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE JOIN(PHASHTABLE_NAME, get_value)(const PHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value)
+{
+    const uint32_t index = PHASHTABLE_FIND_INDEX(self, key);
+
+    return index != PHASHTABLE_NO_INDEX ? self->slots[index].value : default_value;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef TABLE_NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef KEY_IS_EQUAL
+#undef HASH_FUNCTION
+#undef TABLE_FOR_EACH
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef PHASHTABLE_NAME
+#undef PHASHTABLE_TYPE
+#undef PHASHTABLE_SLOT_TYPE
+#undef PHASHTABLE_TABLE_TYPE
+#undef PHASHTABLE_FIND_INDEX
+#undef PHASHTABLE_NO_INDEX
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
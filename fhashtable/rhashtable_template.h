@@ -0,0 +1,663 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file rhashtable_template.h
+ * @brief Resizable hashtable with incremental rehashing (built on fhashtable)
+ *
+ * The hashtable doubles it's capacity once it's load exceeds 75%. Instead of
+ * moving every slot at once, the slots of the previous table are moved a few
+ * at a time on the following insertions, updates and deletions. Lookups search
+ * both tables while a resize is in progress. This way no single operation
+ * stalls for the full rehash of a large table.
+ *
+ * The tables are instances of an `fhashtable_template.h` instantiation, which
+ * must be defined beforehand with the same `KEY_TYPE` and `VALUE_TYPE`, the
+ * default slot layout (not `FHASHTABLE_LAYOUT_SOA`) and the default sizing (not
+ * `FHASHTABLE_LARGE_CAPACITY`). They are created and destroyed with it's
+ * `create_custom` / `destroy_custom` and the allocator given to this
+ * hashtable.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `TABLE_NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * Source(s) used:
+ *  @li https://en.wikipedia.org/wiki/Hash_table#Incremental_resizing
+ *  @li https://redis.io/docs/latest/develop/reference/internals/rehashing/
+ */
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def RHASHTABLE_MIGRATE_STEP
+ * @brief Number of slots of the previous table visited per mutating operation
+ *        while a resize is in progress.
+ *
+ * A table is doubled at 75% load, so 4 slots per insertion is enough to finish
+ * the migration long before the next resize.
+ */
+#ifndef RHASHTABLE_MIGRATE_STEP
+#define RHASHTABLE_MIGRATE_STEP (4)
+#endif
+
+/**
+ * @def RHASHTABLE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the keys and values in the hashtable in arbitary order.
+ *
+ * @warning Modifying the hashtable under the iteration may result in errors.
+ *
+ * @param[in] self              Hashtable pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef RHASHTABLE_FOR_EACH
+#define RHASHTABLE_FOR_EACH(self, index, key_, value_)                                                              \
+    for ((index) = 0;                                                                                               \
+         (index) < (self)->curr_ptr->capacity + ((self)->prev_ptr ? (self)->prev_ptr->capacity : 0);                \
+         (index)++)                                                                                                 \
+        if (RHASHTABLE_SLOT_PTR(self, index)->offset != FHASHTABLE_EMPTY_SLOT_OFFSET                                \
+            && ((key_) = RHASHTABLE_SLOT_PTR(self, index)->key, (value_) = RHASHTABLE_SLOT_PTR(self, index)->value, \
+                true))
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#ifndef RHASHTABLE_SLOT_PTR
+#define RHASHTABLE_SLOT_PTR(self, index)     \
+    ((index) < (self)->curr_ptr->capacity    \
+         ? &(self)->curr_ptr->slots[(index)] \
+         : &(self)->prev_ptr->slots[(index) - (self)->curr_ptr->capacity])
+#endif
+/// @endcond
+
+/**
+ * @def NAME
+ * @brief Prefix to hashtable types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define RHASHTABLE_NAME NAME
+#endif
+
+/**
+ * @def TABLE_NAME
+ * @brief Name of the `fhashtable_template.h` instantiation used for the
+ *        underlying tables. This must be manually defined before including
+ *        this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef TABLE_NAME
+#error "Must define TABLE_NAME."
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define RHASHTABLE_TYPE        struct RHASHTABLE_NAME
+#define RHASHTABLE_TABLE_TYPE  struct TABLE_NAME
+#define RHASHTABLE_MIGRATE     JOIN(internal, JOIN(RHASHTABLE_NAME, migrate))
+#define RHASHTABLE_GROW        JOIN(internal, JOIN(RHASHTABLE_NAME, grow))
+#define RHASHTABLE_IS_OVERLOAD JOIN(internal, JOIN(RHASHTABLE_NAME, is_overloaded))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct RHASHTABLE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated resizable hashtable struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct RHASHTABLE_NAME {
+    uint32_t count;                  ///< Number of keys in both tables.
+    uint32_t migrate_index;          ///< Next slot of the previous table to migrate.
+    RHASHTABLE_TABLE_TYPE *curr_ptr; ///< Table new keys are inserted into.
+    RHASHTABLE_TABLE_TYPE *prev_ptr; ///< Table being migrated from. NULL if no resize is in progress.
+
+    void *context_ptr;                                                   ///< Allocator context.
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size); ///< Allocate function.
+    void (*deallocate)(void *context_ptr, void *mem);                    ///< Deallocate function.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Create a resizable hashtable with a given initial capacity with a
+ *        custom allocator.
+ *
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ * @param[in] deallocate        Deallocate function.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If the underlying table could not be created.
+ */
+FUNCTION_LINKAGE RHASHTABLE_TYPE *JOIN(RHASHTABLE_NAME, create_custom)(
+    const uint32_t min_capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Create a resizable hashtable with a given initial capacity with
+ *        malloc() and free().
+ *
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ *
+ * @return                      A pointer to the hashtable.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If the underlying table could not be created.
+ */
+FUNCTION_LINKAGE RHASHTABLE_TYPE *JOIN(RHASHTABLE_NAME, create)(const uint32_t min_capacity);
+
+/**
+ * @brief Destroy a hashtable and free the underlying memory with the
+ *        deallocate function given on creation.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The hashtable pointer.
+ */
+FUNCTION_LINKAGE void JOIN(RHASHTABLE_NAME, destroy)(RHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether the hashtable is empty.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether the hashtable is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, is_empty)(const RHASHTABLE_TYPE *self);
+
+/**
+ * @brief Return whether a resize is in progress.
+ *
+ * @param[in] self              The hashtable pointer.
+ *
+ * @return                      Whether slots are still to be moved from a previous table.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, is_resizing)(const RHASHTABLE_TYPE *self);
+
+/**
+ * @brief Check if hashtable contains a key.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the hashtable contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, contains_key)(const RHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the pointer to the corresponding value in the
+ *        hashtable.
+ *
+ * @note The returned pointer is **not** garanteed to point to the same value if
+ *       the hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(RHASHTABLE_NAME, get_value_mut)(RHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief From a given key, get the copy of the corresponding value in the
+ *        hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ * @param[in] default_value     The default value returned if the hashtable did
+ *                              not contain the key.
+ *
+ * @return                      The corresponding value.
+ * @retval `default_value`      If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE JOIN(RHASHTABLE_NAME, get_value)(const RHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value);
+
+/**
+ * @brief Search a given key in the hashtable and get the pointer to the
+ *        corresponding value.
+ *
+ * @note The returned pointer is **not** garanteed to point to the same value if
+ *       the hashtable is modified.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ * @retval NULL                 If the hashtable did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(RHASHTABLE_NAME, search)(RHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Insert a non-duplicate key and it's corresponding value inside the
+ *        hashtable. Grows the hashtable if needed.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the key was inserted.
+ * @retval false                If the table is full and growing it failed to allocate.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, insert)(RHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Update a key's corresponding value inside the hashtable. Allows
+ *        duplicates. Grows the hashtable if needed.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the key was inserted or updated.
+ * @retval false                If the table is full and growing it failed to allocate.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, update)(RHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value);
+
+/**
+ * @brief Delete a key and it's corresponding value from the hashtable.
+ *
+ * @param[in] self              The hashtable pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         hashtable.
+ */
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, delete)(RHASHTABLE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear an existing hashtable. Keeps the current capacity.
+ *
+ * @param[in] self              The pointer of the hashtable to clear.
+ */
+FUNCTION_LINKAGE void JOIN(RHASHTABLE_NAME, clear)(RHASHTABLE_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+FUNCTION_LINKAGE RHASHTABLE_TYPE *JOIN(RHASHTABLE_NAME, create_custom)(
+    const uint32_t min_capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem))
+{
+    RHASHTABLE_TYPE *self = (RHASHTABLE_TYPE *)allocate(context_ptr, alignof(RHASHTABLE_TYPE), sizeof(RHASHTABLE_TYPE));
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->curr_ptr = JOIN(TABLE_NAME, create_custom)(min_capacity, context_ptr, allocate);
+
+    if (!self->curr_ptr) {
+        deallocate(context_ptr, self);
+        return NULL;
+    }
+
+    self->count = 0;
+    self->migrate_index = 0;
+    self->prev_ptr = NULL;
+    self->context_ptr = context_ptr;
+    self->allocate = allocate;
+    self->deallocate = deallocate;
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(RHASHTABLE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+
+static inline void JOIN(internal, JOIN(RHASHTABLE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE RHASHTABLE_TYPE *JOIN(RHASHTABLE_NAME, create)(const uint32_t min_capacity)
+{
+    return JOIN(RHASHTABLE_NAME, create_custom)(min_capacity, NULL, JOIN(internal, JOIN(RHASHTABLE_NAME, allocate)),
+                                                JOIN(internal, JOIN(RHASHTABLE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(RHASHTABLE_NAME, destroy)(RHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    if (self->prev_ptr) {
+        JOIN(TABLE_NAME, destroy_custom)(self->prev_ptr, self->context_ptr, self->deallocate);
+    }
+    JOIN(TABLE_NAME, destroy_custom)(self->curr_ptr, self->context_ptr, self->deallocate);
+
+    self->deallocate(self->context_ptr, self);
+}
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, is_empty)(const RHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, is_resizing)(const RHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->prev_ptr != NULL;
+}
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, contains_key)(const RHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    if (JOIN(TABLE_NAME, contains_key)(self->curr_ptr, key)) {
+        return true;
+    }
+    return self->prev_ptr != NULL && JOIN(TABLE_NAME, contains_key)(self->prev_ptr, key);
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(RHASHTABLE_NAME, get_value_mut)(RHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    VALUE_TYPE *value_ptr = JOIN(TABLE_NAME, get_value_mut)(self->curr_ptr, key);
+
+    if (value_ptr == NULL && self->prev_ptr != NULL) {
+        value_ptr = JOIN(TABLE_NAME, get_value_mut)(self->prev_ptr, key);
+    }
+    return value_ptr;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE JOIN(RHASHTABLE_NAME, get_value)(const RHASHTABLE_TYPE *self, const KEY_TYPE key,
+                                                             VALUE_TYPE default_value)
+{
+    assert(self != NULL);
+
+    if (self->prev_ptr != NULL) {
+        default_value = JOIN(TABLE_NAME, get_value)(self->prev_ptr, key, default_value);
+    }
+    return JOIN(TABLE_NAME, get_value)(self->curr_ptr, key, default_value);
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(RHASHTABLE_NAME, search)(RHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    return JOIN(RHASHTABLE_NAME, get_value_mut)(self, key);
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+// Move up to `n_steps` slots of the previous table into the current table.
+static inline void JOIN(internal, JOIN(RHASHTABLE_NAME, migrate))(RHASHTABLE_TYPE *self, uint32_t n_steps)
+{
+    RHASHTABLE_TABLE_TYPE *prev_ptr = self->prev_ptr;
+
+    if (prev_ptr == NULL) {
+        return;
+    }
+
+    // slots before `migrate_index` are empty, as deleting only shifts slots backwards up to the deleted slot:
+    while (n_steps > 0 && prev_ptr->count > 0) {
+        assert(self->migrate_index < prev_ptr->capacity);
+
+        if (prev_ptr->slots[self->migrate_index].offset == FHASHTABLE_EMPTY_SLOT_OFFSET) {
+            self->migrate_index++;
+        }
+        else {
+            const KEY_TYPE key = prev_ptr->slots[self->migrate_index].key;
+            const VALUE_TYPE value = prev_ptr->slots[self->migrate_index].value;
+
+            JOIN(TABLE_NAME, delete)(prev_ptr, key);
+            JOIN(TABLE_NAME, insert)(self->curr_ptr, key, value);
+        }
+        n_steps--;
+    }
+
+    if (prev_ptr->count == 0) {
+        JOIN(TABLE_NAME, destroy_custom)(prev_ptr, self->context_ptr, self->deallocate);
+        self->prev_ptr = NULL;
+        self->migrate_index = 0;
+    }
+}
+
+static inline bool JOIN(internal, JOIN(RHASHTABLE_NAME, is_overloaded))(const RHASHTABLE_TYPE *self)
+{
+    const uint32_t capacity = self->curr_ptr->capacity;
+
+    return self->count >= capacity - capacity / 4;
+}
+
+// Start a resize into a table of double capacity. Returns false if the allocation failed.
+static inline bool JOIN(internal, JOIN(RHASHTABLE_NAME, grow))(RHASHTABLE_TYPE *self)
+{
+    const uint32_t capacity = self->curr_ptr->capacity;
+
+    if (capacity > UINT32_MAX / 4) {
+        return false;
+    }
+
+    RHASHTABLE_TABLE_TYPE *next_ptr = JOIN(TABLE_NAME, create_custom)(capacity * 2, self->context_ptr, self->allocate);
+
+    if (!next_ptr) {
+        return false;
+    }
+
+    // the previous resize is (normally) long done. if not, finish it now:
+    RHASHTABLE_MIGRATE(self, UINT32_MAX);
+
+    self->prev_ptr = self->curr_ptr;
+    self->curr_ptr = next_ptr;
+    self->migrate_index = 0;
+
+    return true;
+}
+
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, insert)(RHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+    assert(JOIN(RHASHTABLE_NAME, contains_key)(self, key) == false);
+
+    RHASHTABLE_MIGRATE(self, RHASHTABLE_MIGRATE_STEP);
+
+    if (RHASHTABLE_IS_OVERLOAD(self)) {
+        const bool has_grown = RHASHTABLE_GROW(self);
+
+        if (!has_grown && JOIN(TABLE_NAME, is_full)(self->curr_ptr)) {
+            return false;
+        }
+    }
+
+    JOIN(TABLE_NAME, insert)(self->curr_ptr, key, value);
+    self->count++;
+
+    return true;
+}
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, update)(RHASHTABLE_TYPE *self, KEY_TYPE key, VALUE_TYPE value)
+{
+    assert(self != NULL);
+
+    RHASHTABLE_MIGRATE(self, RHASHTABLE_MIGRATE_STEP);
+
+    VALUE_TYPE *value_ptr = JOIN(RHASHTABLE_NAME, get_value_mut)(self, key);
+
+    if (value_ptr != NULL) {
+        *value_ptr = value;
+        return true;
+    }
+
+    return JOIN(RHASHTABLE_NAME, insert)(self, key, value);
+}
+
+FUNCTION_LINKAGE bool JOIN(RHASHTABLE_NAME, delete)(RHASHTABLE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    RHASHTABLE_MIGRATE(self, RHASHTABLE_MIGRATE_STEP);
+
+    bool has_deleted = JOIN(TABLE_NAME, delete)(self->curr_ptr, key);
+
+    if (!has_deleted && self->prev_ptr != NULL) {
+        has_deleted = JOIN(TABLE_NAME, delete)(self->prev_ptr, key);
+    }
+
+    if (has_deleted) {
+        self->count--;
+    }
+    return has_deleted;
+}
+
+FUNCTION_LINKAGE void JOIN(RHASHTABLE_NAME, clear)(RHASHTABLE_TYPE *self)
+{
+    assert(self != NULL);
+
+    if (self->prev_ptr) {
+        JOIN(TABLE_NAME, destroy_custom)(self->prev_ptr, self->context_ptr, self->deallocate);
+        self->prev_ptr = NULL;
+        self->migrate_index = 0;
+    }
+    JOIN(TABLE_NAME, clear)(self->curr_ptr);
+    self->count = 0;
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef TABLE_NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef RHASHTABLE_NAME
+#undef RHASHTABLE_TYPE
+#undef RHASHTABLE_TABLE_TYPE
+#undef RHASHTABLE_MIGRATE
+#undef RHASHTABLE_GROW
+#undef RHASHTABLE_IS_OVERLOAD
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
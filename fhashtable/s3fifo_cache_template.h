@@ -0,0 +1,753 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file s3fifo_cache_template.h
+ * @brief Fixed-capacity scan-resistant S3-FIFO cache (built on fhashtable and fqueue)
+ *
+ * The entries are kept in a pool allocated once with the cache. New entries
+ * are enqueued in a small FIFO queue, and entries which were hit while in the
+ * small queue are moved to a main FIFO queue when they reach it's front. The
+ * other entries are evicted, and their keys are remembered in a ghost FIFO
+ * queue, so a key put again soon after is placed directly in the main queue.
+ * The entries reaching the front of the main queue are evicted, unless they
+ * were hit, in which case they are enqueued again.
+ *
+ * A hit only increments a 2-bit frequency counter in the entry, so getting a
+ * value does not relink anything. Keys seen only once (e.g. from a scan) pass
+ * through the small queue without displacing the entries in the main queue.
+ *
+ * The table is an instance of an `fhashtable_template.h` instantiation with
+ * `KEY_TYPE` keys and `uint32_t` values, mapping the keys to the entry indices
+ * (and the ghost keys to their place in the ghost queue). The small and main
+ * queues are instances of an `fqueue_template.h` instantiation with `uint32_t`
+ * values, and the ghost queue is an instance of one with `KEY_TYPE` values.
+ * They must be defined beforehand, and are created and destroyed with their
+ * `create_custom` / `destroy_custom` and the allocator given to this cache.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `TABLE_NAME`
+ *      @li `QUEUE_NAME`
+ *      @li `GHOST_QUEUE_NAME`
+ *      @li `KEY_TYPE`
+ *      @li `VALUE_TYPE`
+ *
+ * Source(s) used:
+ *  @li https://dl.acm.org/doi/10.1145/3600006.3613147 (FIFO queues are all you need for cache eviction)
+ *  @li https://s3fifo.com
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def S3FIFO_CACHE_MAX_FREQ
+ * @brief Maximum value of the frequency counter of an entry.
+ */
+#ifndef S3FIFO_CACHE_MAX_FREQ
+#define S3FIFO_CACHE_MAX_FREQ 3
+#endif
+
+/**
+ * @def S3FIFO_CACHE_DELETED_FREQ
+ * @brief Frequency counter of a deleted entry, which is still in one of the
+ *        queues.
+ */
+#ifndef S3FIFO_CACHE_DELETED_FREQ
+#define S3FIFO_CACHE_DELETED_FREQ UINT8_MAX
+#endif
+
+/**
+ * @def S3FIFO_CACHE_GHOST_BIT
+ * @brief Bit set in the table values of the ghost keys. The other bits hold
+ *        the place of the key in the ghost queue.
+ */
+#ifndef S3FIFO_CACHE_GHOST_BIT
+#define S3FIFO_CACHE_GHOST_BIT (UINT32_C(1) << 31)
+#endif
+
+/**
+ * @def S3FIFO_CACHE_FOR_EACH(self, index, key_, value_)
+ *
+ * @brief Iterate over the keys and values in the cache in no particular order.
+ *
+ * @warning Modifying the cache under the iteration may result in errors.
+ *
+ * @param[in] self              Cache pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] key_             Current key. Should be `KEY_TYPE`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#ifndef S3FIFO_CACHE_FOR_EACH
+#define S3FIFO_CACHE_FOR_EACH(self, index, key_, value_)                           \
+    for ((index) = 0; (index) < (self)->capacity - (self)->n_untouched; (index)++) \
+        if ((self)->entries[(index)].freq != S3FIFO_CACHE_DELETED_FREQ             \
+            && ((key_) = (self)->entries[(index)].key, (value_) = (self)->entries[(index)].value, true))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to cache types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define S3FIFO_CACHE_NAME NAME
+#endif
+
+/**
+ * @def TABLE_NAME
+ * @brief Name of the `fhashtable_template.h` instantiation mapping the keys to
+ *        the entry indices. This must be manually defined before including
+ *        this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef TABLE_NAME
+#error "Must define TABLE_NAME."
+#endif
+
+/**
+ * @def QUEUE_NAME
+ * @brief Name of the `fqueue_template.h` instantiation with `uint32_t` values
+ *        used for the small and main queues. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef QUEUE_NAME
+#error "Must define QUEUE_NAME."
+#endif
+
+/**
+ * @def GHOST_QUEUE_NAME
+ * @brief Name of the `fqueue_template.h` instantiation with `KEY_TYPE` values
+ *        used for the ghost queue. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef GHOST_QUEUE_NAME
+#error "Must define GHOST_QUEUE_NAME."
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief The key type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE int
+#error "Must define KEY_TYPE."
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief The value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined once header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define S3FIFO_CACHE_TYPE        struct S3FIFO_CACHE_NAME
+#define S3FIFO_CACHE_ENTRY_TYPE  struct JOIN(S3FIFO_CACHE_NAME, entry)
+#define S3FIFO_CACHE_TABLE_TYPE  struct TABLE_NAME
+#define S3FIFO_CACHE_QUEUE_TYPE  struct QUEUE_NAME
+#define S3FIFO_CACHE_GHOST_TYPE  struct GHOST_QUEUE_NAME
+#define S3FIFO_CACHE_FIND        JOIN(internal, JOIN(S3FIFO_CACHE_NAME, find))
+#define S3FIFO_CACHE_ADD_GHOST   JOIN(internal, JOIN(S3FIFO_CACHE_NAME, add_ghost))
+#define S3FIFO_CACHE_EVICT       JOIN(internal, JOIN(S3FIFO_CACHE_NAME, evict))
+#define S3FIFO_CACHE_HIT         JOIN(internal, JOIN(S3FIFO_CACHE_NAME, hit))
+#define S3FIFO_CACHE_GHOST_VALUE JOIN(internal, JOIN(S3FIFO_CACHE_NAME, ghost_value))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(S3FIFO_CACHE_NAME, entry);
+struct S3FIFO_CACHE_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated cache entry struct type for a given `KEY_TYPE` and
+ *        `VALUE_TYPE`.
+ */
+struct JOIN(S3FIFO_CACHE_NAME, entry) {
+    KEY_TYPE key;     ///< The key of the entry.
+    VALUE_TYPE value; ///< The value of the entry.
+    uint8_t freq;     ///< Number of hits, up to `S3FIFO_CACHE_MAX_FREQ`, or `S3FIFO_CACHE_DELETED_FREQ`.
+};
+
+/**
+ * @brief Generated cache struct type for a given `KEY_TYPE` and `VALUE_TYPE`.
+ */
+struct S3FIFO_CACHE_NAME {
+    uint32_t count;          ///< Number of entries in the cache.
+    uint32_t capacity;       ///< Number of entries in the pool.
+    uint32_t n_untouched;    ///< Number of entries at the end of the pool, which were never used.
+    uint32_t small_capacity; ///< Size of the small queue. Entries are evicted from it first once reached.
+    uint32_t ghost_capacity; ///< Maximum number of keys in the ghost queue.
+    uint32_t ghost_sequence; ///< Number of keys ever enqueued in the ghost queue.
+
+    S3FIFO_CACHE_TABLE_TYPE *table_ptr; ///< Table mapping the keys to the entry indices.
+    S3FIFO_CACHE_QUEUE_TYPE *small_ptr; ///< Queue of the indices of the entries seen once.
+    S3FIFO_CACHE_QUEUE_TYPE *main_ptr;  ///< Queue of the indices of the entries seen more than once.
+    S3FIFO_CACHE_GHOST_TYPE *ghost_ptr; ///< Queue of the keys recently evicted from the small queue.
+
+    void *context_ptr;                                                   ///< Allocator context.
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size); ///< Allocate function.
+    void (*deallocate)(void *context_ptr, void *mem);                    ///< Deallocate function.
+
+    S3FIFO_CACHE_ENTRY_TYPE entries[]; ///< Pool of entries.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Create a cache with a given capacity with a custom allocator.
+ *
+ * A tenth of the capacity (at least 1) is used for the small queue, and the
+ * ghost queue remembers as many keys as there are left for the main queue. The
+ * table is created with room for a third more keys than the entries and the
+ * ghost keys, to keep it's load factor at most 75%.
+ *
+ * @param[in] capacity          Number of entries.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ * @param[in] deallocate        Deallocate function.
+ *
+ * @return                      A pointer to the cache.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is equal to 0, larger than UINT32_MAX / 4 or the equivalent size
+ *                              overflows.
+ *   @li                        If the table or the queues could not be created.
+ */
+FUNCTION_LINKAGE S3FIFO_CACHE_TYPE *JOIN(S3FIFO_CACHE_NAME, create_custom)(
+    const uint32_t capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Create a cache with a given capacity with malloc() and free().
+ *
+ * @param[in] capacity          Number of entries.
+ *
+ * @return                      A pointer to the cache.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is equal to 0, larger than UINT32_MAX / 4 or the equivalent size
+ *                              overflows.
+ *   @li                        If the table or the queues could not be created.
+ */
+FUNCTION_LINKAGE S3FIFO_CACHE_TYPE *JOIN(S3FIFO_CACHE_NAME, create)(const uint32_t capacity);
+
+/**
+ * @brief Destroy a cache and free the underlying memory with the allocator it
+ *        was created with.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The cache pointer.
+ */
+FUNCTION_LINKAGE void JOIN(S3FIFO_CACHE_NAME, destroy)(S3FIFO_CACHE_TYPE *self);
+
+/**
+ * @brief Return whether the cache is empty.
+ *
+ * @param[in] self              The cache pointer.
+ *
+ * @return                      Whether the cache is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, is_empty)(const S3FIFO_CACHE_TYPE *self);
+
+/**
+ * @brief Return whether the cache is full, so putting a new key evicts an
+ *        entry.
+ *
+ * @param[in] self              The cache pointer.
+ *
+ * @return                      Whether the cache is full.
+ */
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, is_full)(const S3FIFO_CACHE_TYPE *self);
+
+/**
+ * @brief Check if the cache contains a key, without counting it as a hit.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ *
+ * @return                      A boolean indicating whether the cache contains the given key.
+ */
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, contains_key)(const S3FIFO_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Get the pointer to the value of a key, and count it as a hit.
+ *
+ * @note The returned pointer stays valid until the entry is evicted or
+ *       deleted.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the cache did not contain the key.
+ */
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(S3FIFO_CACHE_NAME, get)(S3FIFO_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Get the pointer to the value of a key, without counting it as a hit.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key to search for.
+ *
+ * @return                      A pointer to the corresponding value.
+ *  @retval NULL                If the cache did not contain the key.
+ */
+FUNCTION_LINKAGE const VALUE_TYPE *JOIN(S3FIFO_CACHE_NAME, peek)(const S3FIFO_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Put a key and it's value in the cache. If the key is already
+ *        contained, it's value is replaced and it is counted as a hit.
+ *
+ * If the key is new and all the entries are used, entries are evicted or moved
+ * between the queues until an entry is free. This also happens when entries
+ * were deleted, but none of them have reached the front of their queue yet.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ * @param[in] value             The value.
+ * @param[in] on_evict          Function called with the key and value of the evicted entry. May be NULL.
+ * @param[in] context_ptr       Context given to `on_evict`.
+ *
+ * @return                      Whether an entry was evicted.
+ */
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, put)(S3FIFO_CACHE_TYPE *self, KEY_TYPE key, VALUE_TYPE value,
+                                                   void (*on_evict)(void *context_ptr, KEY_TYPE key, VALUE_TYPE value),
+                                                   void *context_ptr);
+
+/**
+ * @brief Delete a key and it's value from the cache.
+ *
+ * The entry is marked as deleted, and is freed once it reaches the front of
+ * it's queue.
+ *
+ * @param[in] self              The cache pointer.
+ * @param[in] key               The key.
+ *
+ * @return A boolean indicating whether the key was previously contained in the
+ *         cache.
+ */
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, delete)(S3FIFO_CACHE_TYPE *self, const KEY_TYPE key);
+
+/**
+ * @brief Clear the cache, including the ghost keys.
+ *
+ * @param[in] self              The cache pointer.
+ */
+FUNCTION_LINKAGE void JOIN(S3FIFO_CACHE_NAME, clear)(S3FIFO_CACHE_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(S3FIFO_CACHE_NAME, reset))(S3FIFO_CACHE_TYPE *self)
+{
+    self->count = 0;
+    self->n_untouched = self->capacity;
+    self->ghost_sequence = 0;
+    JOIN(QUEUE_NAME, clear)(self->small_ptr);
+    JOIN(QUEUE_NAME, clear)(self->main_ptr);
+    JOIN(GHOST_QUEUE_NAME, clear)(self->ghost_ptr);
+}
+/// @endcond
+
+FUNCTION_LINKAGE S3FIFO_CACHE_TYPE *JOIN(S3FIFO_CACHE_NAME, create_custom)(
+    const uint32_t capacity, void *context_ptr, void *(*allocate)(void *context_ptr, size_t alignment, size_t size),
+    void (*deallocate)(void *context_ptr, void *mem))
+{
+    const size_t max_capacity = (SIZE_MAX - offsetof(S3FIFO_CACHE_TYPE, entries)) / sizeof(S3FIFO_CACHE_ENTRY_TYPE);
+
+    if (capacity == 0 || capacity > UINT32_MAX / 4 || capacity > max_capacity) {
+        return NULL;
+    }
+
+    const uint32_t small_capacity = capacity / 10 > 0 ? capacity / 10 : 1;
+    const uint32_t ghost_capacity = capacity - small_capacity > 0 ? capacity - small_capacity : 1;
+    const uint32_t n_keys = capacity + ghost_capacity;
+
+    const size_t size = offsetof(S3FIFO_CACHE_TYPE, entries) + capacity * sizeof(S3FIFO_CACHE_ENTRY_TYPE);
+
+    S3FIFO_CACHE_TYPE *self = (S3FIFO_CACHE_TYPE *)allocate(context_ptr, alignof(S3FIFO_CACHE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->table_ptr = JOIN(TABLE_NAME, create_custom)(n_keys + n_keys / 3, context_ptr, allocate);
+    self->small_ptr = self->table_ptr ? JOIN(QUEUE_NAME, create_custom)(capacity, context_ptr, allocate) : NULL;
+    self->main_ptr = self->small_ptr ? JOIN(QUEUE_NAME, create_custom)(capacity, context_ptr, allocate) : NULL;
+    self->ghost_ptr = self->main_ptr ? JOIN(GHOST_QUEUE_NAME, create_custom)(ghost_capacity, context_ptr, allocate)
+                                     : NULL;
+
+    if (!self->ghost_ptr) {
+        if (self->main_ptr) {
+            JOIN(QUEUE_NAME, destroy_custom)(self->main_ptr, context_ptr, deallocate);
+        }
+        if (self->small_ptr) {
+            JOIN(QUEUE_NAME, destroy_custom)(self->small_ptr, context_ptr, deallocate);
+        }
+        if (self->table_ptr) {
+            JOIN(TABLE_NAME, destroy_custom)(self->table_ptr, context_ptr, deallocate);
+        }
+        deallocate(context_ptr, self);
+        return NULL;
+    }
+
+    self->capacity = capacity;
+    self->small_capacity = small_capacity;
+    self->ghost_capacity = ghost_capacity;
+    self->context_ptr = context_ptr;
+    self->allocate = allocate;
+    self->deallocate = deallocate;
+    JOIN(internal, JOIN(S3FIFO_CACHE_NAME, reset))(self);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(S3FIFO_CACHE_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+
+static inline void JOIN(internal, JOIN(S3FIFO_CACHE_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE S3FIFO_CACHE_TYPE *JOIN(S3FIFO_CACHE_NAME, create)(const uint32_t capacity)
+{
+    return JOIN(S3FIFO_CACHE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(S3FIFO_CACHE_NAME, allocate)),
+                                                  JOIN(internal, JOIN(S3FIFO_CACHE_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(S3FIFO_CACHE_NAME, destroy)(S3FIFO_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(GHOST_QUEUE_NAME, destroy_custom)(self->ghost_ptr, self->context_ptr, self->deallocate);
+    JOIN(QUEUE_NAME, destroy_custom)(self->main_ptr, self->context_ptr, self->deallocate);
+    JOIN(QUEUE_NAME, destroy_custom)(self->small_ptr, self->context_ptr, self->deallocate);
+    JOIN(TABLE_NAME, destroy_custom)(self->table_ptr, self->context_ptr, self->deallocate);
+
+    self->deallocate(self->context_ptr, self);
+}
+
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, is_empty)(const S3FIFO_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, is_full)(const S3FIFO_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline S3FIFO_CACHE_ENTRY_TYPE *JOIN(internal, JOIN(S3FIFO_CACHE_NAME, find))(const S3FIFO_CACHE_TYPE *self,
+                                                                                      const KEY_TYPE key)
+{
+    const uint32_t index = JOIN(TABLE_NAME, get_value)(self->table_ptr, key, S3FIFO_CACHE_GHOST_BIT);
+
+    return (index & S3FIFO_CACHE_GHOST_BIT) == 0 ? (S3FIFO_CACHE_ENTRY_TYPE *)&self->entries[index] : NULL;
+}
+
+static inline void JOIN(internal, JOIN(S3FIFO_CACHE_NAME, hit))(S3FIFO_CACHE_ENTRY_TYPE *entry_ptr)
+{
+    if (entry_ptr->freq < S3FIFO_CACHE_MAX_FREQ) {
+        entry_ptr->freq++;
+    }
+}
+
+// table value of the key enqueued as number `sequence` in the ghost queue. the sequence is taken modulo 2^30, which
+// is more than the number of keys in the ghost queue, and the value is never UINT32_MAX:
+static inline uint32_t JOIN(internal, JOIN(S3FIFO_CACHE_NAME, ghost_value))(const uint32_t sequence)
+{
+    return S3FIFO_CACHE_GHOST_BIT | (sequence & (S3FIFO_CACHE_GHOST_BIT / 2 - 1));
+}
+
+static inline void JOIN(internal, JOIN(S3FIFO_CACHE_NAME, add_ghost))(S3FIFO_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    if (self->ghost_ptr->count == self->ghost_capacity) {
+        const uint32_t sequence = self->ghost_sequence - self->ghost_ptr->count;
+        const KEY_TYPE old_key = JOIN(GHOST_QUEUE_NAME, dequeue)(self->ghost_ptr);
+
+        // the key may have been put again since, or be enqueued again later in the ghost queue:
+        if (JOIN(TABLE_NAME, get_value)(self->table_ptr, old_key, 0) == S3FIFO_CACHE_GHOST_VALUE(sequence)) {
+            JOIN(TABLE_NAME, delete)(self->table_ptr, old_key);
+        }
+    }
+    JOIN(GHOST_QUEUE_NAME, enqueue)(self->ghost_ptr, key);
+    JOIN(TABLE_NAME, update)(self->table_ptr, key, S3FIFO_CACHE_GHOST_VALUE(self->ghost_sequence));
+    self->ghost_sequence++;
+}
+
+// free an entry by moving the entries between the queues, and evicting an entry if no deleted entry is reached first:
+static inline S3FIFO_CACHE_ENTRY_TYPE *JOIN(internal, JOIN(S3FIFO_CACHE_NAME, evict))(
+    S3FIFO_CACHE_TYPE *self, void (*on_evict)(void *context_ptr, KEY_TYPE key, VALUE_TYPE value), void *context_ptr,
+    bool *is_evicted_ptr)
+{
+    while (true) {
+        const bool from_small = self->small_ptr->count >= self->small_capacity || self->main_ptr->count == 0;
+
+        S3FIFO_CACHE_QUEUE_TYPE *queue_ptr = from_small ? self->small_ptr : self->main_ptr;
+        assert(queue_ptr->count > 0);
+
+        const uint32_t index = JOIN(QUEUE_NAME, dequeue)(queue_ptr);
+        S3FIFO_CACHE_ENTRY_TYPE *entry_ptr = &self->entries[index];
+
+        if (entry_ptr->freq == S3FIFO_CACHE_DELETED_FREQ) {
+            return entry_ptr;
+        }
+        if (entry_ptr->freq > 0) {
+            // entries hit in the small queue start over in the main queue:
+            entry_ptr->freq = from_small ? 0 : (uint8_t)(entry_ptr->freq - 1);
+            JOIN(QUEUE_NAME, enqueue)(self->main_ptr, index);
+            continue;
+        }
+
+        if (from_small) {
+            S3FIFO_CACHE_ADD_GHOST(self, entry_ptr->key);
+        }
+        else {
+            const bool is_deleted = JOIN(TABLE_NAME, delete)(self->table_ptr, entry_ptr->key);
+            assert(is_deleted);
+            (void)is_deleted;
+        }
+        if (on_evict) {
+            on_evict(context_ptr, entry_ptr->key, entry_ptr->value);
+        }
+        self->count--;
+        *is_evicted_ptr = true;
+
+        return entry_ptr;
+    }
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, contains_key)(const S3FIFO_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    return S3FIFO_CACHE_FIND(self, key) != NULL;
+}
+
+FUNCTION_LINKAGE VALUE_TYPE *JOIN(S3FIFO_CACHE_NAME, get)(S3FIFO_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    S3FIFO_CACHE_ENTRY_TYPE *entry_ptr = S3FIFO_CACHE_FIND(self, key);
+
+    if (!entry_ptr) {
+        return NULL;
+    }
+    S3FIFO_CACHE_HIT(entry_ptr);
+
+    return &entry_ptr->value;
+}
+
+FUNCTION_LINKAGE const VALUE_TYPE *JOIN(S3FIFO_CACHE_NAME, peek)(const S3FIFO_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    const S3FIFO_CACHE_ENTRY_TYPE *entry_ptr = S3FIFO_CACHE_FIND(self, key);
+
+    return entry_ptr ? &entry_ptr->value : NULL;
+}
+
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, put)(S3FIFO_CACHE_TYPE *self, KEY_TYPE key, VALUE_TYPE value,
+                                                   void (*on_evict)(void *context_ptr, KEY_TYPE key, VALUE_TYPE value),
+                                                   void *context_ptr)
+{
+    assert(self != NULL);
+
+    const uint32_t found_index = JOIN(TABLE_NAME, get_value)(self->table_ptr, key, UINT32_MAX);
+
+    if ((found_index & S3FIFO_CACHE_GHOST_BIT) == 0) {
+        S3FIFO_CACHE_ENTRY_TYPE *entry_ptr = &self->entries[found_index];
+        S3FIFO_CACHE_HIT(entry_ptr);
+        entry_ptr->value = value;
+        return false;
+    }
+
+    S3FIFO_CACHE_ENTRY_TYPE *entry_ptr;
+    bool is_evicted = false;
+
+    if (self->n_untouched > 0) {
+        entry_ptr = &self->entries[self->capacity - self->n_untouched--];
+    }
+    else {
+        entry_ptr = S3FIFO_CACHE_EVICT(self, on_evict, context_ptr, &is_evicted);
+    }
+
+    entry_ptr->key = key;
+    entry_ptr->value = value;
+    entry_ptr->freq = 0;
+
+    const uint32_t index = (uint32_t)(entry_ptr - self->entries);
+
+    // the ghost key may have been dequeued from the ghost queue by the eviction:
+    if (found_index != UINT32_MAX && (!is_evicted || JOIN(TABLE_NAME, contains_key)(self->table_ptr, key))) {
+        JOIN(TABLE_NAME, update)(self->table_ptr, key, index);
+        JOIN(QUEUE_NAME, enqueue)(self->main_ptr, index);
+    }
+    else {
+        JOIN(TABLE_NAME, insert)(self->table_ptr, key, index);
+        JOIN(QUEUE_NAME, enqueue)(self->small_ptr, index);
+    }
+    self->count++;
+
+    return is_evicted;
+}
+
+FUNCTION_LINKAGE bool JOIN(S3FIFO_CACHE_NAME, delete)(S3FIFO_CACHE_TYPE *self, const KEY_TYPE key)
+{
+    assert(self != NULL);
+
+    S3FIFO_CACHE_ENTRY_TYPE *entry_ptr = S3FIFO_CACHE_FIND(self, key);
+
+    if (!entry_ptr) {
+        return false;
+    }
+
+    JOIN(TABLE_NAME, delete)(self->table_ptr, key);
+    entry_ptr->freq = S3FIFO_CACHE_DELETED_FREQ;
+    self->count--;
+
+    return true;
+}
+
+FUNCTION_LINKAGE void JOIN(S3FIFO_CACHE_NAME, clear)(S3FIFO_CACHE_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(TABLE_NAME, clear)(self->table_ptr);
+    JOIN(internal, JOIN(S3FIFO_CACHE_NAME, reset))(self);
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef TABLE_NAME
+#undef QUEUE_NAME
+#undef GHOST_QUEUE_NAME
+#undef KEY_TYPE
+#undef VALUE_TYPE
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef S3FIFO_CACHE_NAME
+#undef S3FIFO_CACHE_TYPE
+#undef S3FIFO_CACHE_ENTRY_TYPE
+#undef S3FIFO_CACHE_TABLE_TYPE
+#undef S3FIFO_CACHE_QUEUE_TYPE
+#undef S3FIFO_CACHE_GHOST_TYPE
+#undef S3FIFO_CACHE_FIND
+#undef S3FIFO_CACHE_ADD_GHOST
+#undef S3FIFO_CACHE_EVICT
+#undef S3FIFO_CACHE_HIT
+#undef S3FIFO_CACHE_GHOST_VALUE
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,349 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file sstr_template.h
+ * @brief Short string key type with inline storage, for hashtable keys
+ *
+ * A short string of `SSTR_SIZE` bytes stores strings of up to `SSTR_SIZE - 1`
+ * bytes inline, followed by zeroes and a length byte. Longer strings are
+ * stored as a pointer and a length, with `SSTR_REF_TAG` as the last byte. The
+ * pointed-to bytes are not copied, and must outlive the short string.
+ *
+ * Every string has exactly one representation, so comparing two inline
+ * strings is comparing `SSTR_SIZE / 8` 64-bit words, and the bytes of the
+ * longer strings are only compared with `memcmp` when both are out-of-line
+ * with the same length. Used as `fhashtable_template.h` keys with
+ * `JOIN(NAME, is_equal)` and `JOIN(NAME, hash)`, probing the slots touches no
+ * memory outside the slots for inline strings.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @def SSTR_REF_TAG
+ * @brief Last byte of a short string, which stores it's string out-of-line.
+ */
+#ifndef SSTR_REF_TAG
+#define SSTR_REF_TAG (UINT8_MAX)
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to short string type and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define SSTR_NAME NAME
+#endif
+
+/**
+ * @def SSTR_SIZE
+ * @brief Size of the short string in bytes. A multiple of 8 between 16 and
+ *        248. `16` by default.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef SSTR_SIZE
+#define SSTR_SIZE 16
+#endif
+#if SSTR_SIZE % 8 != 0 || SSTR_SIZE < 16 || SSTR_SIZE > 248
+#error "SSTR_SIZE must be a multiple of 8 between 16 and 248."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define SSTR_TYPE          struct SSTR_NAME
+#define SSTR_MAX_INLINE    (SSTR_SIZE - 1)
+#define SSTR_TAG(self)     ((uint8_t)(self).chars[SSTR_SIZE - 1])
+#define SSTR_REF_PTR_SIZE  (sizeof(const char *))
+#define SSTR_REF_PTR       JOIN(internal, JOIN(SSTR_NAME, ref_ptr))
+#define SSTR_REF_LENGTH    JOIN(internal, JOIN(SSTR_NAME, ref_length))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct SSTR_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated short string struct type.
+ */
+struct SSTR_NAME {
+    union {
+        char chars[SSTR_SIZE];         ///< The inline bytes or the out-of-line pointer and length, and the last byte.
+        uint64_t words[SSTR_SIZE / 8]; ///< The bytes as 64-bit words.
+    };
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Make a short string from a string of bytes.
+ *
+ * @param[in] chars             The bytes of the string. Must outlive the short string if `length` is more
+ *                              than `SSTR_SIZE - 1`.
+ * @param[in] length            The number of bytes.
+ *
+ * @return                      The short string.
+ */
+FUNCTION_LINKAGE SSTR_TYPE JOIN(SSTR_NAME, from)(const char *chars, const uint32_t length);
+
+/**
+ * @brief Make a short string from a `\0`-terminated string. See `from`.
+ *
+ * @param[in] cstr              The `\0`-terminated string.
+ *
+ * @return                      The short string.
+ */
+FUNCTION_LINKAGE SSTR_TYPE JOIN(SSTR_NAME, from_cstr)(const char *cstr);
+
+/**
+ * @brief Return whether the string of a short string is stored inline.
+ *
+ * @param[in] self              The short string.
+ *
+ * @return                      Whether the string is stored inline.
+ */
+FUNCTION_LINKAGE bool JOIN(SSTR_NAME, is_inline)(const SSTR_TYPE self);
+
+/**
+ * @brief Get the length of a short string.
+ *
+ * @param[in] self              The short string.
+ *
+ * @return                      The number of bytes.
+ */
+FUNCTION_LINKAGE uint32_t JOIN(SSTR_NAME, length)(const SSTR_TYPE self);
+
+/**
+ * @brief Get the bytes of a short string.
+ *
+ * @note The bytes are not `\0`-terminated.
+ *
+ * @param[in] self_ptr          The short string pointer. Must outlive the returned pointer.
+ *
+ * @return                      A pointer to the first byte of the string.
+ */
+FUNCTION_LINKAGE const char *JOIN(SSTR_NAME, chars)(const SSTR_TYPE *self_ptr);
+
+/**
+ * @brief Compare two short strings. To be used as `KEY_IS_EQUAL`.
+ *
+ * @param[in] a                 The short string.
+ * @param[in] b                 The short string.
+ *
+ * @return                      Whether the strings are equal.
+ */
+FUNCTION_LINKAGE bool JOIN(SSTR_NAME, is_equal)(const SSTR_TYPE a, const SSTR_TYPE b);
+
+/**
+ * @brief Hash a short string. To be used as `HASH_FUNCTION`.
+ *
+ * The words of inline strings are mixed together, and the bytes of longer
+ * strings are hashed with murmur3.
+ *
+ * @param[in] self              The short string.
+ *
+ * @return                      A 32-bit hash of the string.
+ */
+FUNCTION_LINKAGE uint32_t JOIN(SSTR_NAME, hash)(const SSTR_TYPE self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <string.h>
+
+#include "murmurhash.h" // murmur3_32
+
+/// @cond DO_NOT_DOCUMENT
+static inline const char *JOIN(internal, JOIN(SSTR_NAME, ref_ptr))(const SSTR_TYPE *self_ptr)
+{
+    const char *ptr;
+    memcpy(&ptr, &self_ptr->chars[0], SSTR_REF_PTR_SIZE);
+    return ptr;
+}
+
+static inline uint32_t JOIN(internal, JOIN(SSTR_NAME, ref_length))(const SSTR_TYPE *self_ptr)
+{
+    uint32_t length;
+    memcpy(&length, &self_ptr->chars[SSTR_REF_PTR_SIZE], sizeof(uint32_t));
+    return length;
+}
+/// @endcond
+
+FUNCTION_LINKAGE SSTR_TYPE JOIN(SSTR_NAME, from)(const char *chars, const uint32_t length)
+{
+    assert(chars != NULL || length == 0);
+
+    SSTR_TYPE self;
+    memset(&self, 0, sizeof(self));
+
+    if (length <= SSTR_MAX_INLINE) {
+        if (length > 0) {
+            memcpy(&self.chars[0], chars, length);
+        }
+        self.chars[SSTR_SIZE - 1] = (char)length;
+    }
+    else {
+        memcpy(&self.chars[0], &chars, SSTR_REF_PTR_SIZE);
+        memcpy(&self.chars[SSTR_REF_PTR_SIZE], &length, sizeof(uint32_t));
+        self.chars[SSTR_SIZE - 1] = (char)SSTR_REF_TAG;
+    }
+    return self;
+}
+
+FUNCTION_LINKAGE SSTR_TYPE JOIN(SSTR_NAME, from_cstr)(const char *cstr)
+{
+    assert(cstr != NULL);
+
+    const size_t length = strlen(cstr);
+
+    assert(length <= UINT32_MAX);
+
+    return JOIN(SSTR_NAME, from)(cstr, (uint32_t)length);
+}
+
+FUNCTION_LINKAGE bool JOIN(SSTR_NAME, is_inline)(const SSTR_TYPE self)
+{
+    return SSTR_TAG(self) != SSTR_REF_TAG;
+}
+
+FUNCTION_LINKAGE uint32_t JOIN(SSTR_NAME, length)(const SSTR_TYPE self)
+{
+    return SSTR_TAG(self) != SSTR_REF_TAG ? SSTR_TAG(self) : SSTR_REF_LENGTH(&self);
+}
+
+FUNCTION_LINKAGE const char *JOIN(SSTR_NAME, chars)(const SSTR_TYPE *self_ptr)
+{
+    assert(self_ptr != NULL);
+
+    return SSTR_TAG(*self_ptr) != SSTR_REF_TAG ? &self_ptr->chars[0] : SSTR_REF_PTR(self_ptr);
+}
+
+FUNCTION_LINKAGE bool JOIN(SSTR_NAME, is_equal)(const SSTR_TYPE a, const SSTR_TYPE b)
+{
+    uint64_t diff = 0;
+    for (size_t i = 0; i < SSTR_SIZE / 8; i++) {
+        diff |= a.words[i] ^ b.words[i];
+    }
+    if (diff == 0) {
+        return true;
+    }
+    if (SSTR_TAG(a) != SSTR_REF_TAG || SSTR_TAG(b) != SSTR_REF_TAG) {
+        return false;
+    }
+
+    const uint32_t length = SSTR_REF_LENGTH(&a);
+
+    return length == SSTR_REF_LENGTH(&b) && memcmp(SSTR_REF_PTR(&a), SSTR_REF_PTR(&b), length) == 0;
+}
+
+FUNCTION_LINKAGE uint32_t JOIN(SSTR_NAME, hash)(const SSTR_TYPE self)
+{
+    if (SSTR_TAG(self) == SSTR_REF_TAG) {
+        return murmur3_32((const uint8_t *)SSTR_REF_PTR(&self), SSTR_REF_LENGTH(&self), 0);
+    }
+
+    uint64_t hash = 0;
+    for (size_t i = 0; i < SSTR_SIZE / 8; i++) {
+        hash = (hash ^ self.words[i]) * UINT64_C(0xbf58476d1ce4e5b9);
+        hash ^= hash >> 31;
+    }
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef SSTR_SIZE
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef SSTR_NAME
+#undef SSTR_TYPE
+#undef SSTR_MAX_INLINE
+#undef SSTR_TAG
+#undef SSTR_REF_PTR_SIZE
+#undef SSTR_REF_PTR
+#undef SSTR_REF_LENGTH
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,638 @@
+// Copyright (c) 2026 abxh
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file strpool_template.h
+ * @brief Fixed-size string interning pool (built on arena)
+ *
+ * The pool copies each distinct string once into an arena, and hands out
+ * `{hash, length, offset}` handles to them, where the offset is relative to
+ * the arena buffer. Interning a string which is already in the pool returns the
+ * same handle, so two handles from the same pool are equal exactly when their
+ * offsets are equal.
+ *
+ * The handles can be used as `fhashtable_template.h` keys with
+ * `STRPOOL_STR_HASH` as `HASH_FUNCTION` and `STRPOOL_STR_IS_EQUAL` as
+ * `KEY_IS_EQUAL`, so probing a table compares and hashes no string bytes.
+ *
+ * The pool finds interned strings with an index of handles, using linear
+ * probing. The hash and length stored in the index reject most mismatches
+ * before the string bytes are compared with `memcmp`. The strings are hashed
+ * with murmur3, 4 bytes at a time.
+ *
+ * The arena is an instance of an `arena_template.h` instantiation, which must
+ * be defined beforehand. The strings are allocated with it's
+ * `allocate_aligned`, and are `\0`-terminated. Deallocating the strings in the
+ * arena (e.g. with `deallocate_all` or `state_restore`) invalidates the pool,
+ * which must then be cleared.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `ARENA_NAME`
+ *
+ * Source(s) used:
+ *  @li https://en.wikipedia.org/wiki/String_interning
+ */
+
+/**
+ * @example fhashtable_example.c
+ * Example of how `strpool_template.h` header file is used in practice.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// macro definitions: {{{
+
+/**
+ * @def PASTE(a,b)
+ * @brief Paste two tokens together.
+ */
+#ifndef PASTE
+#define PASTE(a, b) a##b
+#endif
+
+/**
+ * @def XPASTE(a,b)
+ * @brief First expand tokens, then paste them together.
+ */
+#ifndef XPASTE
+#define XPASTE(a, b) PASTE(a, b)
+#endif
+
+/**
+ * @def JOIN(a,b)
+ * @brief First expand tokens, then paste them together with a _ in between.
+ */
+#ifndef JOIN
+#define JOIN(a, b) XPASTE(a, XPASTE(_, b))
+#endif
+
+/**
+ * @brief Macro to check if a number is a power of two.
+ *
+ * @param[in] X             The number at hand.
+ *
+ * @return                  A boolean value indicating whether the number is a power of two.
+ */
+#ifndef IS_POW2
+#define IS_POW2(X) ((X) != 0 && ((X) & ((X) - 1)) == 0)
+#endif
+
+/**
+ * @def STRPOOL_EMPTY_SLOT_OFFSET
+ * @brief Offset used to indicate an empty slot.
+ */
+#ifndef STRPOOL_EMPTY_SLOT_OFFSET
+#define STRPOOL_EMPTY_SLOT_OFFSET (UINT32_MAX)
+#endif
+
+/**
+ * @def STRPOOL_STR_HASH(str)
+ * @brief Get the hash of a string handle. To be used as `HASH_FUNCTION` of
+ *        tables with string handle keys.
+ *
+ * @param[in] str               String handle.
+ *
+ * @return                      The hash of the string.
+ */
+#ifndef STRPOOL_STR_HASH
+#define STRPOOL_STR_HASH(str) ((str).hash)
+#endif
+
+/**
+ * @def STRPOOL_STR_IS_EQUAL(a, b)
+ * @brief Compare two string handles from the same pool. To be used as
+ *        `KEY_IS_EQUAL` of tables with string handle keys.
+ *
+ * @param[in] a                 String handle.
+ * @param[in] b                 String handle.
+ *
+ * @return                      Whether the strings are equal.
+ */
+#ifndef STRPOOL_STR_IS_EQUAL
+#define STRPOOL_STR_IS_EQUAL(a, b) ((a).offset == (b).offset)
+#endif
+
+/**
+ * @def STRPOOL_FOR_EACH(self, index, str_)
+ *
+ * @brief Iterate over the string handles in the pool in no particular order.
+ *
+ * @warning Modifying the pool under the iteration may result in errors.
+ *
+ * @param[in] self              Pool pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] str_             Current string handle. Should be the generated string handle type.
+ */
+#ifndef STRPOOL_FOR_EACH
+#define STRPOOL_FOR_EACH(self, index, str_)                  \
+    for ((index) = 0; (index) < (self)->capacity; (index)++) \
+        if ((self)->slots[(index)].offset != STRPOOL_EMPTY_SLOT_OFFSET && ((str_) = (self)->slots[(index)], true))
+#endif
+
+/**
+ * @def STRPOOL_CALC_SIZEOF(strpool_name, capacity)
+ *
+ * @brief Calculate the size of the pool struct. No overflow checks.
+ *
+ * @param[in] strpool_name      Defined pool NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#ifndef STRPOOL_CALC_SIZEOF
+#define STRPOOL_CALC_SIZEOF(strpool_name, capacity) \
+    (size_t)(offsetof(struct strpool_name, slots) + capacity * sizeof(((struct strpool_name *)0)->slots[0]))
+#endif
+
+/**
+ * @def NAME
+ * @brief Prefix to pool types and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#error "Must define NAME."
+#define FUNCTION_DEFINITIONS
+#define TYPE_DEFINITIONS
+#else
+#define STRPOOL_NAME NAME
+#endif
+
+/**
+ * @def ARENA_NAME
+ * @brief Name of the `arena_template.h` instantiation the strings are
+ *        allocated with. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef ARENA_NAME
+#error "Must define ARENA_NAME."
+#endif
+
+/**
+ * @def FUNCTION_LINKAGE
+ * @brief Specify function linkage e.g. static inline
+ */
+#ifndef FUNCTION_LINKAGE
+#define FUNCTION_LINKAGE
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define STRPOOL_TYPE       struct STRPOOL_NAME
+#define STRPOOL_STR_TYPE   struct JOIN(STRPOOL_NAME, str)
+#define STRPOOL_ARENA_TYPE struct ARENA_NAME
+#define STRPOOL_INIT       JOIN(STRPOOL_NAME, init)
+#define STRPOOL_PROBE      JOIN(internal, JOIN(STRPOOL_NAME, probe))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+struct JOIN(STRPOOL_NAME, str);
+struct STRPOOL_NAME;
+
+/**
+ * @def TYPE_DEFINITIONS
+ * @brief Define the types
+ */
+#ifdef TYPE_DEFINITIONS
+
+/**
+ * @brief Generated string handle struct type.
+ */
+struct JOIN(STRPOOL_NAME, str) {
+    uint32_t hash;   ///< Hash of the string.
+    uint32_t length; ///< Length of the string in bytes, excluding the `\0`.
+    uint32_t offset; ///< Offset of the string relative to the arena buffer.
+};
+
+/**
+ * @brief Generated pool struct type.
+ */
+struct STRPOOL_NAME {
+    uint32_t count;                ///< Number of strings.
+    uint32_t capacity;             ///< Number of slots in the index.
+    STRPOOL_ARENA_TYPE *arena_ptr; ///< Arena holding the strings.
+    STRPOOL_STR_TYPE slots[];      ///< Index of the string handles.
+};
+
+#endif
+
+// }}}
+
+// function declarations: {{{
+
+/**
+ * @brief Initialize a pool struct, given a (power-of-2) capacity.
+ *
+ * @param[in] self              Pool pointer.
+ * @param[in] pow2_capacity     Power of 2 capacity.
+ * @param[in] arena_ptr         Arena to allocate the strings with.
+ *
+ * @return                      The pool pointer.
+ */
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, init)(STRPOOL_TYPE *self, const uint32_t pow2_capacity,
+                                                        STRPOOL_ARENA_TYPE *arena_ptr);
+
+/**
+ * @brief Create a pool struct with a given capacity with a custom allocator.
+ *
+ * @note The capacity should be a third more than the number of strings
+ *       expected, to keep the probe sequences short.
+ *
+ * @param[in] min_capacity      Maximum number of strings expected to be stored.
+ * @param[in] arena_ptr         Arena to allocate the strings with.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] allocate          Allocate function.
+ *
+ * @return                      A pointer to the pool.
+ * @retval NULL
+ *   @li                        If allocate returns NULL.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
+ *                              overflows.
+ */
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, create_custom)(
+    const uint32_t min_capacity, STRPOOL_ARENA_TYPE *arena_ptr, void *context_ptr,
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
+
+/**
+ * @brief Create a pool struct with a given capacity with malloc().
+ *
+ * @param[in] min_capacity      Maximum number of strings expected to be stored.
+ * @param[in] arena_ptr         Arena to allocate the strings with.
+ *
+ * @return                      A pointer to the pool.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size
+ *                              overflows.
+ */
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, create)(const uint32_t min_capacity, STRPOOL_ARENA_TYPE *arena_ptr);
+
+/**
+ * @brief Destroy a pool struct and free the underlying memory with a custom
+ *        allocator. The strings are left in the arena.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The pool pointer.
+ * @param[in] context_ptr       Allocator context.
+ * @param[in] deallocate        Deallocate function.
+ */
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, destroy_custom)(STRPOOL_TYPE *self, void *context_ptr,
+                                                         void (*deallocate)(void *context_ptr, void *mem));
+
+/**
+ * @brief Destroy a pool struct and free the underlying memory with free(). The
+ *        strings are left in the arena.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The pool pointer.
+ */
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, destroy)(STRPOOL_TYPE *self);
+
+/**
+ * @brief Return whether the pool is empty.
+ *
+ * @param[in] self              The pool pointer.
+ *
+ * @return                      Whether the pool is empty.
+ */
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, is_empty)(const STRPOOL_TYPE *self);
+
+/**
+ * @brief Return whether the pool is full.
+ *
+ * @param[in] self              The pool pointer.
+ *
+ * @return                      Whether the pool is full.
+ */
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, is_full)(const STRPOOL_TYPE *self);
+
+/**
+ * @brief Find the handle of a string in the pool, without interning it.
+ *
+ * @param[in] self              The pool pointer.
+ * @param[in] chars             The bytes of the string.
+ * @param[in] length            The number of bytes.
+ * @param[out] str_ptr          Set to the handle of the string, if found.
+ *
+ * @return                      Whether the string is in the pool.
+ */
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, find)(const STRPOOL_TYPE *self, const char *chars, const uint32_t length,
+                                               STRPOOL_STR_TYPE *str_ptr);
+
+/**
+ * @brief Get the handle of a string, and copy the string into the arena first
+ *        if it's not in the pool.
+ *
+ * @param[in] self              The pool pointer.
+ * @param[in] chars             The bytes of the string.
+ * @param[in] length            The number of bytes.
+ * @param[out] str_ptr          Set to the handle of the string, if interned.
+ *
+ * @return                      Whether the string is interned.
+ * @retval false
+ *   @li                        If the string is not in the pool, and the pool is full.
+ *   @li                        If the arena does not have enough memory for the string, or the string offset
+ *                              would be `STRPOOL_EMPTY_SLOT_OFFSET` or more. The arena is left unchanged.
+ */
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, intern)(STRPOOL_TYPE *self, const char *chars, const uint32_t length,
+                                                 STRPOOL_STR_TYPE *str_ptr);
+
+/**
+ * @brief Intern a `\0`-terminated string. See `intern`.
+ *
+ * @param[in] self              The pool pointer.
+ * @param[in] cstr              The `\0`-terminated string.
+ * @param[out] str_ptr          Set to the handle of the string, if interned.
+ *
+ * @return                      Whether the string is interned.
+ */
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, intern_cstr)(STRPOOL_TYPE *self, const char *cstr, STRPOOL_STR_TYPE *str_ptr);
+
+/**
+ * @brief Get the `\0`-terminated bytes of an interned string.
+ *
+ * @param[in] self              The pool pointer.
+ * @param[in] str               The string handle.
+ *
+ * @return                      A pointer to the first byte of the string.
+ */
+FUNCTION_LINKAGE const char *JOIN(STRPOOL_NAME, chars)(const STRPOOL_TYPE *self, const STRPOOL_STR_TYPE str);
+
+/**
+ * @brief Clear the pool. The strings are left in the arena.
+ *
+ * @param[in] self              The pool pointer.
+ */
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, clear)(STRPOOL_TYPE *self);
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @def FUNCTION_DEFINITIONS
+ * @brief Define the functions
+ */
+#ifdef FUNCTION_DEFINITIONS
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "murmurhash.h"       // murmur3_32
+#include "round_up_pow2_32.h" // round_up_pow2_32
+
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, init)(STRPOOL_TYPE *self, const uint32_t pow2_capacity,
+                                                        STRPOOL_ARENA_TYPE *arena_ptr)
+{
+    assert(self);
+    assert(arena_ptr);
+    assert(IS_POW2(pow2_capacity));
+
+    self->count = 0;
+    self->capacity = pow2_capacity;
+    self->arena_ptr = arena_ptr;
+
+    for (uint32_t i = 0; i < self->capacity; i++) {
+        self->slots[i].offset = STRPOOL_EMPTY_SLOT_OFFSET;
+    }
+
+    return self;
+}
+
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, create_custom)(
+    const uint32_t min_capacity, STRPOOL_ARENA_TYPE *arena_ptr, void *context_ptr,
+    void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    const uint32_t capacity = round_up_pow2_32(min_capacity);
+    const size_t max_capacity = (SIZE_MAX - offsetof(STRPOOL_TYPE, slots)) / sizeof(STRPOOL_STR_TYPE);
+
+    if (capacity > max_capacity) {
+        return NULL;
+    }
+
+    const size_t size = STRPOOL_CALC_SIZEOF(STRPOOL_NAME, capacity);
+
+    STRPOOL_TYPE *self = (STRPOOL_TYPE *)allocate(context_ptr, alignof(STRPOOL_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    STRPOOL_INIT(self, capacity, arena_ptr);
+
+    return self;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *JOIN(internal, JOIN(STRPOOL_NAME, allocate))(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    return malloc(size);
+}
+/// @endcond
+
+FUNCTION_LINKAGE STRPOOL_TYPE *JOIN(STRPOOL_NAME, create)(const uint32_t min_capacity, STRPOOL_ARENA_TYPE *arena_ptr)
+{
+    return JOIN(STRPOOL_NAME, create_custom)(min_capacity, arena_ptr, NULL,
+                                             JOIN(internal, JOIN(STRPOOL_NAME, allocate)));
+}
+
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, destroy_custom)(STRPOOL_TYPE *self, void *context_ptr,
+                                                         void (*deallocate)(void *context_ptr, void *mem))
+{
+    assert(self != NULL);
+
+    deallocate(context_ptr, self);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void JOIN(internal, JOIN(STRPOOL_NAME, deallocate))(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+/// @endcond
+
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, destroy)(STRPOOL_TYPE *self)
+{
+    assert(self != NULL);
+
+    JOIN(STRPOOL_NAME, destroy_custom)(self, NULL, JOIN(internal, JOIN(STRPOOL_NAME, deallocate)));
+}
+
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, is_empty)(const STRPOOL_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, is_full)(const STRPOOL_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/// @cond DO_NOT_DOCUMENT
+// return the index of the slot with the string, or of the empty slot to put it in, or the capacity if neither is found:
+static inline uint32_t JOIN(internal, JOIN(STRPOOL_NAME, probe))(const STRPOOL_TYPE *self, const char *chars,
+                                                                 const uint32_t length, const uint32_t hash)
+{
+    const unsigned char *buf_ptr = self->arena_ptr->buf_ptr;
+    const uint32_t index_mask = self->capacity - 1;
+
+    uint32_t index = hash & index_mask;
+
+    for (uint32_t n = 0; n < self->capacity; n++) {
+        const STRPOOL_STR_TYPE *slot_ptr = &self->slots[index];
+
+        if (slot_ptr->offset == STRPOOL_EMPTY_SLOT_OFFSET) {
+            return index;
+        }
+        if (slot_ptr->hash == hash && slot_ptr->length == length
+            && memcmp(&buf_ptr[slot_ptr->offset], chars, length) == 0) {
+            return index;
+        }
+        index = (index + 1) & index_mask;
+    }
+    return self->capacity;
+}
+/// @endcond
+
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, find)(const STRPOOL_TYPE *self, const char *chars, const uint32_t length,
+                                               STRPOOL_STR_TYPE *str_ptr)
+{
+    assert(self != NULL);
+    assert(chars != NULL);
+    assert(str_ptr != NULL);
+
+    const uint32_t index = STRPOOL_PROBE(self, chars, length, murmur3_32((const uint8_t *)chars, length, 0));
+
+    if (index == self->capacity || self->slots[index].offset == STRPOOL_EMPTY_SLOT_OFFSET) {
+        return false;
+    }
+    *str_ptr = self->slots[index];
+
+    return true;
+}
+
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, intern)(STRPOOL_TYPE *self, const char *chars, const uint32_t length,
+                                                 STRPOOL_STR_TYPE *str_ptr)
+{
+    assert(self != NULL);
+    assert(chars != NULL);
+    assert(str_ptr != NULL);
+
+    const uint32_t hash = murmur3_32((const uint8_t *)chars, length, 0);
+    const uint32_t index = STRPOOL_PROBE(self, chars, length, hash);
+
+    if (index == self->capacity) {
+        return false;
+    }
+    if (self->slots[index].offset != STRPOOL_EMPTY_SLOT_OFFSET) {
+        *str_ptr = self->slots[index];
+        return true;
+    }
+
+    const struct JOIN(ARENA_NAME, state) arena_state = JOIN(ARENA_NAME, state_save)(self->arena_ptr);
+
+    char *dest_ptr = (char *)JOIN(ARENA_NAME, allocate_aligned)(self->arena_ptr, 1, (size_t)length + 1);
+
+    if (!dest_ptr) {
+        return false;
+    }
+
+    const size_t offset = (size_t)((unsigned char *)dest_ptr - self->arena_ptr->buf_ptr);
+
+    if (offset >= STRPOOL_EMPTY_SLOT_OFFSET) {
+        JOIN(ARENA_NAME, state_restore)(arena_state);
+        return false;
+    }
+
+    memcpy(dest_ptr, chars, length);
+
+    self->slots[index].hash = hash;
+    self->slots[index].length = length;
+    self->slots[index].offset = (uint32_t)offset;
+    self->count++;
+
+    *str_ptr = self->slots[index];
+
+    return true;
+}
+
+FUNCTION_LINKAGE bool JOIN(STRPOOL_NAME, intern_cstr)(STRPOOL_TYPE *self, const char *cstr, STRPOOL_STR_TYPE *str_ptr)
+{
+    assert(cstr != NULL);
+
+    const size_t length = strlen(cstr);
+
+    if (length > UINT32_MAX) {
+        return false;
+    }
+    return JOIN(STRPOOL_NAME, intern)(self, cstr, (uint32_t)length, str_ptr);
+}
+
+FUNCTION_LINKAGE const char *JOIN(STRPOOL_NAME, chars)(const STRPOOL_TYPE *self, const STRPOOL_STR_TYPE str)
+{
+    assert(self != NULL);
+    assert(str.offset != STRPOOL_EMPTY_SLOT_OFFSET);
+
+    return (const char *)&self->arena_ptr->buf_ptr[str.offset];
+}
+
+FUNCTION_LINKAGE void JOIN(STRPOOL_NAME, clear)(STRPOOL_TYPE *self)
+{
+    assert(self != NULL);
+
+    STRPOOL_INIT(self, self->capacity, self->arena_ptr);
+}
+
+#endif
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef ARENA_NAME
+#undef FUNCTION_LINKAGE
+#undef FUNCTION_DEFINITIONS
+#undef TYPE_DEFINITIONS
+
+#undef STRPOOL_NAME
+#undef STRPOOL_TYPE
+#undef STRPOOL_STR_TYPE
+#undef STRPOOL_ARENA_TYPE
+#undef STRPOOL_INIT
+#undef STRPOOL_PROBE
+
+// }}}
+
+#ifdef __cplusplus
+}
+#endif
+
+// vim: ft=c fdm=marker
@@ -3,14 +3,59 @@
 
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 
 #include "murmurhash.h"
 
-#define NAME               uint_ht
+#define NAME                             uint_ht
+#define KEY_TYPE                         uint64_t
+#define VALUE_TYPE                       uint64_t
+#define KEY_IS_EQUAL(a, b)               ((a) == (b))
+#define HASH_FUNCTION(key)               (murmur3_32((uint8_t *)&(key), sizeof(KEY_TYPE), 0))
+#define COMBINE_VALUES(old_value, value) ((old_value) + (value))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME                             uint_ctrl_ht
+#define KEY_TYPE                         uint64_t
+#define VALUE_TYPE                       uint64_t
+#define KEY_IS_EQUAL(a, b)               ((a) == (b))
+#define HASH_FUNCTION(key)               (murmur3_32((uint8_t *)&(key), sizeof(KEY_TYPE), 0))
+#define COMBINE_VALUES(old_value, value) ((old_value) + (value))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+#define NAME               uint_set
+#define KEY_TYPE           uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) (murmur3_32((uint8_t *)&(key), sizeof(KEY_TYPE), 0))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashset_template.h"
+
+#define NAME               uint_oht
+#define KEY_TYPE           uint64_t
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) (murmur3_32((uint8_t *)&(key), sizeof(KEY_TYPE), 0))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "ohashtable_template.h"
+
+#define NAME               uint_bcht
 #define KEY_TYPE           uint64_t
 #define VALUE_TYPE         uint64_t
 #define KEY_IS_EQUAL(a, b) ((a) == (b))
@@ -18,9 +63,100 @@
 #define TYPE_DEFINITIONS
 #define FUNCTION_DEFINITIONS
 #define FUNCTION_LINKAGE static inline
+#include "bchashtable_template.h"
+
+#include "fnvhash.h"
+
+#define NAME               str_ht
+#define KEY_TYPE           char *
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) (strcmp((a), (b)) == 0)
+#define HASH_FUNCTION(key) (fnvhash_32_str(key))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME sstr16
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "sstr_template.h"
+
+#define NAME               sstr_ht
+#define KEY_TYPE           struct sstr16
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) sstr16_is_equal(a, b)
+#define HASH_FUNCTION(key) sstr16_hash(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#include "inthash.h"
+
+#define NAME               uint_fib_ht
+#define KEY_TYPE           uint64_t
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) (inthash_fibonacci_32(key))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               uint_moremur_ht
+#define KEY_TYPE           uint64_t
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)inthash_moremur(key))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
 #include "fhashtable_template.h"
 
 void benchmark_uint_ht(size_t n)
+{
+    struct uint_ht *ht_p = uint_ht_create(n);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = rand();
+        uint_ht_upsert(ht_p, key, 1);
+    }
+    uint_ht_destroy(ht_p);
+}
+
+void benchmark_uint_ctrl_ht(size_t n)
+{
+    struct uint_ctrl_ht *ht_p = uint_ctrl_ht_create(n);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = rand();
+        uint_ctrl_ht_upsert(ht_p, key, 1);
+    }
+    uint_ctrl_ht_destroy(ht_p);
+}
+
+uint64_t lookup_uint_ht(const struct uint_ht *ht_p, const std::vector<uint64_t> &keys)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        sum += uint_ht_get_value(ht_p, keys[i], 0);
+    }
+    return sum;
+}
+
+uint64_t lookup_uint_ht_batch(const struct uint_ht *ht_p, const std::vector<uint64_t> &keys)
+{
+    std::vector<uint64_t> values(keys.size());
+    uint_ht_get_value_batch(ht_p, (uint32_t)keys.size(), keys.data(), 0, values.data());
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+void benchmark_uint_ht_two_probes(size_t n)
 {
     struct uint_ht *ht_p = uint_ht_create(n);
     for (size_t i = 0; i < n; i++) {
@@ -69,11 +205,387 @@ int main(void)
         benchmark_std_unordered_map(N);
         auto c_end2 = high_resolution_clock::now();
 
+        srand(time(NULL));
+        auto c_start3 = high_resolution_clock::now();
+        benchmark_uint_ctrl_ht(N);
+        auto c_end3 = high_resolution_clock::now();
+
+        srand(time(NULL));
+        auto c_start4 = high_resolution_clock::now();
+        benchmark_uint_ht_two_probes(N);
+        auto c_end4 = high_resolution_clock::now();
+
         std::cout << "time elapsed for " << N << " elements:" << std::endl;
         std::cout << " custom hashtable: " << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs"
                   << std::endl;
         std::cout << " c++ unordered map: " << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs"
                   << std::endl;
+        std::cout << " custom hashtable (control bytes): "
+                  << duration_cast<microseconds>(c_end3 - c_start3).count() << " μs" << std::endl;
+        std::cout << " custom hashtable (get_value_mut + update): "
+                  << duration_cast<microseconds>(c_end4 - c_start4).count() << " μs" << std::endl;
+    }
+
+    // lookups only, about half of which are hits:
+    for (size_t N = 1000000; N <= 10000000; N *= 10) {
+        srand(time(NULL));
+        struct uint_ht *ht_p = uint_ht_create(N);
+        for (size_t i = 0; i < N - N / 4; i++) {
+            uint_ht_update(ht_p, (uint64_t)rand() % (2 * N), i);
+        }
+        std::vector<uint64_t> keys(N);
+        for (size_t i = 0; i < N; i++) {
+            keys[i] = (uint64_t)rand() % (2 * N);
+        }
+
+        auto c_start1 = high_resolution_clock::now();
+        const uint64_t sum1 = lookup_uint_ht(ht_p, keys);
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        const uint64_t sum2 = lookup_uint_ht_batch(ht_p, keys);
+        auto c_end2 = high_resolution_clock::now();
+
+        if (sum1 != sum2) {
+            std::cerr << "batched lookups differ from single lookups" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for " << N << " lookups:" << std::endl;
+        std::cout << " custom hashtable (get_value): " << duration_cast<microseconds>(c_end1 - c_start1).count()
+                  << " μs" << std::endl;
+        std::cout << " custom hashtable (get_value_batch): "
+                  << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs" << std::endl;
+
+        uint_ht_destroy(ht_p);
+    }
+
+    // building from arrays of distinct keys:
+    for (size_t N = 1000000; N <= 10000000; N *= 10) {
+        std::vector<uint64_t> keys(N);
+        std::vector<uint64_t> values(N, 1);
+        for (size_t i = 0; i < N; i++) {
+            keys[i] = (uint64_t)i * 0x9E3779B97F4A7C15;
+        }
+        struct uint_ht *inserted_p = uint_ht_create(N);
+        struct uint_ht *built_p = uint_ht_create(N);
+
+        auto c_start1 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_insert(inserted_p, keys[i], values[i]);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        const bool is_built = uint_ht_build_from_arrays(built_p, keys.data(), values.data(), (uint32_t)N);
+        auto c_end2 = high_resolution_clock::now();
+
+        if (!is_built || built_p->count != inserted_p->count) {
+            std::cerr << "building from arrays differs from inserting" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for building from " << N << " elements:" << std::endl;
+        std::cout << " custom hashtable (insert): " << duration_cast<microseconds>(c_end1 - c_start1).count()
+                  << " μs" << std::endl;
+        std::cout << " custom hashtable (build_from_arrays): "
+                  << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs" << std::endl;
+
+        uint_ht_destroy(inserted_p);
+        uint_ht_destroy(built_p);
+    }
+
+    // copying a snapshot to the same and to twice the capacity:
+    for (size_t N = 1000000; N <= 10000000; N *= 10) {
+        struct uint_ht *src_p = uint_ht_create(N);
+        struct uint_ht *inserted_p = uint_ht_create(2 * N);
+        struct uint_ht *same_p = uint_ht_create(N);
+        struct uint_ht *doubled_p = uint_ht_create(2 * N);
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_insert(src_p, (uint64_t)i * 0x9E3779B97F4A7C15, 1);
+        }
+
+        uint32_t index;
+        uint64_t key, value;
+        auto c_start1 = high_resolution_clock::now();
+        FHASHTABLE_FOR_EACH(src_p, index, key, value)
+        {
+            uint_ht_insert(inserted_p, key, value);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        uint_ht_copy(same_p, src_p);
+        auto c_end2 = high_resolution_clock::now();
+
+        auto c_start3 = high_resolution_clock::now();
+        uint_ht_copy(doubled_p, src_p);
+        auto c_end3 = high_resolution_clock::now();
+
+        if (same_p->count != src_p->count || doubled_p->count != inserted_p->count) {
+            std::cerr << "copying differs from inserting" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for copying " << src_p->count << " elements:" << std::endl;
+        std::cout << " custom hashtable (insert into 2x capacity): "
+                  << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs" << std::endl;
+        std::cout << " custom hashtable (copy to same capacity): "
+                  << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs" << std::endl;
+        std::cout << " custom hashtable (copy to 2x capacity): "
+                  << duration_cast<microseconds>(c_end3 - c_start3).count() << " μs" << std::endl;
+
+        uint_ht_destroy(src_p);
+        uint_ht_destroy(inserted_p);
+        uint_ht_destroy(same_p);
+        uint_ht_destroy(doubled_p);
+    }
+
+    // deduplicating keys with a hashset and with a hashtable with unused values:
+    for (size_t N = 1000000; N <= 10000000; N *= 10) {
+        std::vector<uint64_t> keys(N);
+        for (size_t i = 0; i < N; i++) {
+            keys[i] = (uint64_t)(rand() % (N / 2)) * 0x9E3779B97F4A7C15;
+        }
+        struct uint_ht *ht_p = uint_ht_create(N / 2);
+        struct uint_set *set_p = uint_set_create(N / 2);
+
+        auto c_start1 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_update(ht_p, keys[i], 0);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_set_insert(set_p, keys[i]);
+        }
+        auto c_end2 = high_resolution_clock::now();
+
+        if (set_p->count != ht_p->count) {
+            std::cerr << "deduplicating with the hashset differs from the hashtable" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for deduplicating " << N << " elements:" << std::endl;
+        std::cout << " custom hashtable (" << sizeof(struct uint_ht_slot)
+                  << " byte slots): " << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs"
+                  << std::endl;
+        std::cout << " custom hashset (" << sizeof(struct uint_set_slot)
+                  << " byte slots): " << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs"
+                  << std::endl;
+
+        uint_ht_destroy(ht_p);
+        uint_set_destroy(set_p);
+    }
+
+    // iterating over a hashtable filled to 75%, 100 times:
+    for (size_t N = 1000; N <= 1000000; N *= 1000) {
+        struct uint_ht *ht_p = uint_ht_create(N + N / 3);
+        struct uint_oht *oht_p = uint_oht_create(N + N / 3);
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_insert(ht_p, (uint64_t)i * 0x9E3779B97F4A7C15, i);
+            uint_oht_insert(oht_p, (uint64_t)i * 0x9E3779B97F4A7C15, i);
+        }
+
+        uint32_t index;
+        uint64_t key, value;
+        uint64_t sum1 = 0, sum2 = 0;
+
+        auto c_start1 = high_resolution_clock::now();
+        for (int k = 0; k < 100; k++) {
+            FHASHTABLE_FOR_EACH(ht_p, index, key, value)
+            {
+                sum1 += key ^ value;
+            }
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        for (int k = 0; k < 100; k++) {
+            OHASHTABLE_FOR_EACH(oht_p, index, key, value)
+            {
+                sum2 += key ^ value;
+            }
+        }
+        auto c_end2 = high_resolution_clock::now();
+
+        if (sum1 != sum2) {
+            std::cerr << "iterating the ordered hashtable differs from the hashtable" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for iterating over " << N << " elements 100 times:" << std::endl;
+        std::cout << " custom hashtable (FHASHTABLE_FOR_EACH): "
+                  << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs" << std::endl;
+        std::cout << " custom ordered hashtable (OHASHTABLE_FOR_EACH): "
+                  << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs" << std::endl;
+
+        uint_ht_destroy(ht_p);
+        uint_oht_destroy(oht_p);
+    }
+
+    // looking up present and missing keys at a 90% load factor:
+    for (size_t capacity = 1 << 16; capacity <= 1 << 22; capacity <<= 6) {
+        const size_t N = capacity * 9 / 10;
+        struct uint_ht *ht_p = uint_ht_create(capacity);
+        struct uint_bcht *bcht_p = uint_bcht_create(capacity);
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_insert(ht_p, (uint64_t)i * 0x9E3779B97F4A7C15, i);
+            if (!uint_bcht_insert(bcht_p, (uint64_t)i * 0x9E3779B97F4A7C15, i)) {
+                std::cerr << "the cuckoo hashtable filled up" << std::endl;
+                return 1;
+            }
+        }
+        std::vector<uint64_t> keys(2 * N);
+        for (size_t i = 0; i < 2 * N; i++) {
+            keys[i] = (uint64_t)(rand() % (2 * N)) * 0x9E3779B97F4A7C15;
+        }
+
+        uint64_t sum1 = 0, sum2 = 0;
+
+        auto c_start1 = high_resolution_clock::now();
+        for (size_t i = 0; i < keys.size(); i++) {
+            sum1 += uint_ht_get_value(ht_p, keys[i], 1);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        for (size_t i = 0; i < keys.size(); i++) {
+            sum2 += uint_bcht_get_value(bcht_p, keys[i], 1);
+        }
+        auto c_end2 = high_resolution_clock::now();
+
+        if (sum1 != sum2) {
+            std::cerr << "looking up in the cuckoo hashtable differs from the hashtable" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for " << keys.size() << " lookups, half of them missing, at 90% load:" << std::endl;
+        std::cout << " custom hashtable: " << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs"
+                  << std::endl;
+        std::cout << " custom cuckoo hashtable: " << duration_cast<microseconds>(c_end2 - c_start2).count() << " μs"
+                  << std::endl;
+
+        uint_ht_destroy(ht_p);
+        uint_bcht_destroy(bcht_p);
+    }
+
+    // looking up short string keys, stored as pointers and inline:
+    for (size_t N = 1 << 16; N <= 1 << 20; N <<= 2) {
+        std::vector<char *> keys(N), key_copies(N);
+        char buf[16];
+        for (size_t i = 0; i < N; i++) {
+            snprintf(buf, sizeof(buf), "metric.%zu", i);
+            keys[i] = strdup(buf);
+            key_copies[i] = strdup(buf);
+        }
+        struct str_ht *str_ht_p = str_ht_create(N * 4 / 3);
+        struct sstr_ht *sstr_ht_p = sstr_ht_create(N * 4 / 3);
+        for (size_t i = 0; i < N; i++) {
+            str_ht_insert(str_ht_p, keys[i], i);
+            sstr_ht_insert(sstr_ht_p, sstr16_from_cstr(keys[i]), i);
+        }
+        // the queries are kept in the same form as the keys:
+        std::vector<char *> str_queries(2 * N);
+        std::vector<struct sstr16> sstr_queries(2 * N);
+        for (size_t i = 0; i < 2 * N; i++) {
+            const size_t index = (size_t)rand() % N;
+            str_queries[i] = key_copies[index];
+            sstr_queries[i] = sstr16_from_cstr(key_copies[index]);
+        }
+
+        uint64_t sum1 = 0, sum2 = 0;
+
+        auto c_start1 = high_resolution_clock::now();
+        for (size_t i = 0; i < str_queries.size(); i++) {
+            sum1 += str_ht_get_value(str_ht_p, str_queries[i], 0);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        for (size_t i = 0; i < sstr_queries.size(); i++) {
+            sum2 += sstr_ht_get_value(sstr_ht_p, sstr_queries[i], 0);
+        }
+        auto c_end2 = high_resolution_clock::now();
+
+        if (sum1 != sum2) {
+            std::cerr << "looking up inline string keys differs from pointer string keys" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for " << str_queries.size() << " lookups of " << N << " short string keys:"
+                  << std::endl;
+        std::cout << " custom hashtable (char * keys): " << duration_cast<microseconds>(c_end1 - c_start1).count()
+                  << " μs" << std::endl;
+        std::cout << " custom hashtable (inline keys): " << duration_cast<microseconds>(c_end2 - c_start2).count()
+                  << " μs" << std::endl;
+
+        str_ht_destroy(str_ht_p);
+        sstr_ht_destroy(sstr_ht_p);
+        for (size_t i = 0; i < N; i++) {
+            free(keys[i]);
+            free(key_copies[i]);
+        }
+    }
+
+    // hashing integer keys with murmur3 and with the integer hash functions, for random and sequential keys:
+    for (int sequential = 0; sequential <= 1; sequential++) {
+        const size_t N = 1 << 20;
+        std::vector<uint64_t> keys(N);
+        for (size_t i = 0; i < N; i++) {
+            keys[i] = sequential ? i : ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+        }
+        struct uint_ht *ht_p = uint_ht_create(N * 4 / 3);
+        struct uint_fib_ht *fib_ht_p = uint_fib_ht_create(N * 4 / 3);
+        struct uint_moremur_ht *moremur_ht_p = uint_moremur_ht_create(N * 4 / 3);
+
+        uint64_t sum1 = 0, sum2 = 0, sum3 = 0;
+
+        auto c_start1 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_ht_update(ht_p, keys[i], i);
+        }
+        for (size_t i = 0; i < N; i++) {
+            sum1 += uint_ht_get_value(ht_p, keys[i], 0);
+        }
+        auto c_end1 = high_resolution_clock::now();
+
+        auto c_start2 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_fib_ht_update(fib_ht_p, keys[i], i);
+        }
+        for (size_t i = 0; i < N; i++) {
+            sum2 += uint_fib_ht_get_value(fib_ht_p, keys[i], 0);
+        }
+        auto c_end2 = high_resolution_clock::now();
+
+        auto c_start3 = high_resolution_clock::now();
+        for (size_t i = 0; i < N; i++) {
+            uint_moremur_ht_update(moremur_ht_p, keys[i], i);
+        }
+        for (size_t i = 0; i < N; i++) {
+            sum3 += uint_moremur_ht_get_value(moremur_ht_p, keys[i], 0);
+        }
+        auto c_end3 = high_resolution_clock::now();
+
+        if (sum1 != sum2 || sum1 != sum3) {
+            std::cerr << "the integer hash functions give different results" << std::endl;
+            return 1;
+        }
+
+        std::cout << "time elapsed for " << N << " updates and lookups of " << (sequential ? "sequential" : "random")
+                  << " integer keys:" << std::endl;
+        std::cout << " custom hashtable (murmur3): " << duration_cast<microseconds>(c_end1 - c_start1).count()
+                  << " μs" << std::endl;
+        std::cout << " custom hashtable (fibonacci): " << duration_cast<microseconds>(c_end2 - c_start2).count()
+                  << " μs" << std::endl;
+        std::cout << " custom hashtable (moremur): " << duration_cast<microseconds>(c_end3 - c_start3).count()
+                  << " μs" << std::endl;
+
+        uint_ht_destroy(ht_p);
+        uint_fib_ht_destroy(fib_ht_p);
+        uint_moremur_ht_destroy(moremur_ht_p);
     }
 
     return 0;
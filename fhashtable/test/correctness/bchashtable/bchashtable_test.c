@@ -0,0 +1,187 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 16
+    - N := 1e+3
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - is_empty + is_full
+    - contains_key + get_value + BCHASHTABLE_FOR_EACH
+
+    Mutating operation types:
+    - insert (also until it fails)
+    - update
+    - get_value_mut
+    - delete
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Hashtables:
+    - murmur3 hash
+    - all keys with the same hash (2 buckets at most)
+
+    Inserting until it fails reaches a load factor of at least 90%, and every
+    inserted key can still be found.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "murmurhash.h"
+
+#define NAME               int_to_int_bcht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) murmur3_32((uint8_t *)&(key), sizeof(int), 0)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "bchashtable_template.h"
+
+// all keys have the same hash:
+#define NAME               int_to_int_collide_bcht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) * 0U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "bchashtable_template.h"
+
+#define insert_delete_and_compare(BCHT, n)                                         \
+    do {                                                                           \
+        struct BCHT *ht_p = JOIN(BCHT, create)(2 * (n) + 1);                       \
+        if (!ht_p) {                                                               \
+            assert(false);                                                         \
+        }                                                                          \
+        assert(JOIN(BCHT, is_empty)(ht_p));                                        \
+        for (int i = 0; i < (n); i++) {                                            \
+            assert(JOIN(BCHT, insert)(ht_p, 3 * i, i));                            \
+        }                                                                          \
+        assert(ht_p->count == (uint32_t)(n));                                      \
+        for (int i = 0; i < 3 * (n) + 3; i++) {                                    \
+            const bool expected = i % 3 == 0 && i < 3 * (n);                       \
+            assert(JOIN(BCHT, contains_key)(ht_p, i) == expected);                 \
+            assert(JOIN(BCHT, get_value)(ht_p, i, -1) == (expected ? i / 3 : -1)); \
+        }                                                                          \
+                                                                                   \
+        uint32_t index;                                                            \
+        int key, value;                                                            \
+        int count = 0;                                                             \
+        BCHASHTABLE_FOR_EACH(ht_p, index, key, value)                              \
+        {                                                                          \
+            assert(key % 3 == 0 && value == key / 3);                              \
+            count++;                                                               \
+        }                                                                          \
+        assert(count == (n));                                                      \
+                                                                                   \
+        for (int i = 0; i < (n); i += 2) {                                         \
+            assert(JOIN(BCHT, delete)(ht_p, 3 * i));                               \
+            assert(!JOIN(BCHT, delete)(ht_p, 3 * i));                              \
+        }                                                                          \
+        assert(!JOIN(BCHT, delete)(ht_p, 1));                                      \
+        assert(ht_p->count == (uint32_t)((n) / 2));                                \
+        for (int i = 0; i < (n); i++) {                                            \
+            assert(JOIN(BCHT, contains_key)(ht_p, 3 * i) == (i % 2 == 1));         \
+        }                                                                          \
+                                                                                   \
+        for (int i = 1; i < (n); i += 2) {                                         \
+            assert(JOIN(BCHT, update)(ht_p, 3 * i, -i));                           \
+            int *value_p = JOIN(BCHT, get_value_mut)(ht_p, 3 * i);                 \
+            if (!value_p) {                                                        \
+                assert(false);                                                     \
+            }                                                                      \
+            *value_p -= 1;                                                         \
+        }                                                                          \
+        assert(JOIN(BCHT, get_value_mut)(ht_p, 1) == NULL);                        \
+        for (int i = 1; i < (n); i += 2) {                                         \
+            assert(JOIN(BCHT, get_value)(ht_p, 3 * i, 0) == -i - 1);               \
+        }                                                                          \
+                                                                                   \
+        JOIN(BCHT, clear)(ht_p);                                                   \
+        assert(JOIN(BCHT, is_empty)(ht_p));                                        \
+        for (int i = 0; i < (n); i++) {                                            \
+            assert(!JOIN(BCHT, contains_key)(ht_p, 3 * i));                        \
+        }                                                                          \
+                                                                                   \
+        JOIN(BCHT, destroy)(ht_p);                                                 \
+    } while (0)
+
+// returns the number of keys inserted before inserting failed:
+#define insert_until_full(BCHT, capacity, n_inserted_ptr)                  \
+    do {                                                                   \
+        struct BCHT *ht_p = JOIN(BCHT, create)(capacity);                  \
+        if (!ht_p) {                                                       \
+            assert(false);                                                 \
+        }                                                                  \
+        int n = 0;                                                         \
+        while (JOIN(BCHT, update)(ht_p, n, -n)) {                          \
+            assert(ht_p->count == (uint32_t)(n + 1));                      \
+            n++;                                                           \
+        }                                                                  \
+        /* the failed insert left the hashtable unchanged: */              \
+        assert(ht_p->count == (uint32_t)n);                                \
+        for (int i = 0; i <= n; i++) {                                     \
+            assert(JOIN(BCHT, get_value)(ht_p, i, 1) == (i < n ? -i : 1)); \
+        }                                                                  \
+        /* deleting any key makes room again: */                           \
+        if (n > 0) {                                                       \
+            assert(JOIN(BCHT, delete)(ht_p, n / 2));                       \
+            assert(JOIN(BCHT, insert)(ht_p, n / 2, 0));                    \
+            assert(JOIN(BCHT, contains_key)(ht_p, n / 2));                 \
+        }                                                                  \
+        *(n_inserted_ptr) = n;                                             \
+        JOIN(BCHT, destroy)(ht_p);                                         \
+    } while (0)
+
+int main(void)
+{
+    insert_delete_and_compare(int_to_int_bcht, 0);
+    insert_delete_and_compare(int_to_int_bcht, 1);
+    insert_delete_and_compare(int_to_int_bcht, 16);
+    insert_delete_and_compare(int_to_int_bcht, 1000);
+    insert_delete_and_compare(int_to_int_bcht, 100000);
+
+    insert_delete_and_compare(int_to_int_collide_bcht, 0);
+    insert_delete_and_compare(int_to_int_collide_bcht, 1);
+
+    {
+        int n_inserted;
+        insert_until_full(int_to_int_bcht, 1 << 10, &n_inserted);
+        assert(n_inserted >= (1 << 10) * 9 / 10);
+
+        insert_until_full(int_to_int_bcht, 1 << 16, &n_inserted);
+        assert(n_inserted >= (1 << 16) * 9 / 10);
+
+        insert_until_full(int_to_int_bcht, 1 << 20, &n_inserted);
+        assert(n_inserted >= (1 << 20) * 9 / 10);
+
+        // a single bucket can be filled up completely:
+        insert_until_full(int_to_int_bcht, 1, &n_inserted);
+        assert(n_inserted == BCHASHTABLE_BUCKET_SIZE);
+
+        // keys with the same hash share 2 buckets:
+        insert_until_full(int_to_int_collide_bcht, 1 << 10, &n_inserted);
+        assert(n_inserted == 2 * BCHASHTABLE_BUCKET_SIZE);
+    }
+
+    assert(int_to_int_bcht_create(0) == NULL);
+    assert(int_to_int_bcht_create(UINT32_MAX / 2 + 2) == NULL);
+    {
+        struct int_to_int_bcht *ht_p = int_to_int_bcht_create(1);
+        if (!ht_p) {
+            assert(false);
+        }
+        assert(ht_p->capacity == BCHASHTABLE_BUCKET_SIZE);
+        int_to_int_bcht_destroy(ht_p);
+    }
+}
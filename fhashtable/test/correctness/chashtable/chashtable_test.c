@@ -0,0 +1,386 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 1e+3
+    - N := 1e+5 (split over 8 threads)
+
+    Non-mutating operation types / properties:
+    - count
+    - contains_key + get_value
+    - get_shard_stats
+
+    Mutating operation types:
+    - insert
+    - update
+    - delete
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - create_custom (with an allocator that fails after a limit)
+    - destroy
+
+    Underlying tables:
+    - default layout
+    - FHASHTABLE_CONTROL_BYTES
+
+    Operations are compared against a plain array indexed by key. Concurrent
+    writers work on disjoint key ranges, while readers look up keys that are
+    never written.
+*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_cht
+#define TABLE_NAME         int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "chashtable_template.h"
+
+#define NAME               int_to_int_ctrl_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define FHASHTABLE_CONTROL_BYTES
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_ctrl_cht
+#define TABLE_NAME         int_to_int_ctrl_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "chashtable_template.h"
+
+struct limited_allocator {
+    size_t n_allocations_left;
+};
+
+static void *limited_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    struct limited_allocator *allocator_ptr = context_ptr;
+    if (allocator_ptr->n_allocations_left == 0) {
+        return NULL;
+    }
+    allocator_ptr->n_allocations_left--;
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static void limited_deallocate(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+
+static struct int_to_int_cht_shard_stats sum_stats(struct int_to_int_cht *ht_p)
+{
+    struct int_to_int_cht_shard_stats sum = {0};
+    for (uint32_t i = 0; i < ht_p->n_shards; i++) {
+        const struct int_to_int_cht_shard_stats stats = int_to_int_cht_get_shard_stats(ht_p, i);
+        sum.count += stats.count;
+        sum.capacity += stats.capacity;
+        sum.n_reads += stats.n_reads;
+        sum.n_writes += stats.n_writes;
+        sum.n_contended_reads += stats.n_contended_reads;
+        sum.n_contended_writes += stats.n_contended_writes;
+        sum.n_grows += stats.n_grows;
+    }
+    return sum;
+}
+
+void int_int_test(void)
+{
+    // N = 0
+    {
+        struct int_to_int_cht *ht_p = int_to_int_cht_create(4, 0);
+        if (ht_p) {
+            assert(false);
+        }
+    }
+    // N = 1, a single shard growing on the second insertion
+    {
+        struct int_to_int_cht *ht_p = int_to_int_cht_create(1, 1);
+        if (!ht_p) {
+            assert(false);
+        }
+        assert((uintptr_t)&ht_p->shards[0] % CHASHTABLE_CACHE_LINE_SIZE == 0);
+        assert(int_to_int_cht_count(ht_p) == 0);
+        assert(!int_to_int_cht_contains_key(ht_p, 42));
+        assert(int_to_int_cht_get_value(ht_p, 42, -1) == -1);
+
+        assert(int_to_int_cht_insert(ht_p, 42, 69));
+        assert(ht_p->shards[0].table_ptr->capacity == 1);
+        assert(int_to_int_cht_insert(ht_p, 69, 42));
+        assert(ht_p->shards[0].table_ptr->capacity == 2);
+        assert(int_to_int_cht_count(ht_p) == 2);
+
+        assert(int_to_int_cht_get_value(ht_p, 42, -1) == 69);
+        assert(int_to_int_cht_get_value(ht_p, 69, -1) == 42);
+
+        assert(int_to_int_cht_update(ht_p, 42, 1));
+        assert(int_to_int_cht_get_value(ht_p, 42, -1) == 1);
+        assert(int_to_int_cht_count(ht_p) == 2);
+
+        assert(int_to_int_cht_delete(ht_p, 42));
+        assert(!int_to_int_cht_delete(ht_p, 42));
+        assert(int_to_int_cht_delete(ht_p, 69));
+        assert(int_to_int_cht_count(ht_p) == 0);
+
+        const struct int_to_int_cht_shard_stats stats = int_to_int_cht_get_shard_stats(ht_p, 0);
+        assert(stats.count == 0);
+        assert(stats.capacity == 2);
+        assert(stats.n_reads == 5);
+        assert(stats.n_writes == 6);
+        assert(stats.n_contended_reads == 0);
+        assert(stats.n_contended_writes == 0);
+        assert(stats.n_grows == 1);
+
+        int_to_int_cht_destroy(ht_p);
+    }
+    // N = 1e+3, spread over the shards
+    {
+        const int n = 1000;
+        struct int_to_int_cht *ht_p = int_to_int_cht_create(16, 64);
+        if (!ht_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < ht_p->n_shards; i++) {
+            assert((uintptr_t)&ht_p->shards[i] % CHASHTABLE_CACHE_LINE_SIZE == 0);
+            assert(ht_p->shards[i].table_ptr->capacity == 4);
+        }
+        for (int i = 0; i < n; i++) {
+            assert(int_to_int_cht_insert(ht_p, i, -i));
+        }
+        assert(int_to_int_cht_count(ht_p) == (uint32_t)n);
+
+        struct int_to_int_cht_shard_stats sum = sum_stats(ht_p);
+        assert(sum.count == (uint32_t)n);
+        assert(sum.n_writes == (uint32_t)n);
+        assert(sum.n_grows > 0);
+        for (uint32_t i = 0; i < ht_p->n_shards; i++) {
+            // roughly n / 16 keys each:
+            const struct int_to_int_cht_shard_stats stats = int_to_int_cht_get_shard_stats(ht_p, i);
+            assert(stats.count > 0);
+            assert(stats.count < (uint32_t)n / 4);
+        }
+
+        for (int i = 0; i < n; i += 2) {
+            assert(int_to_int_cht_delete(ht_p, i));
+        }
+        for (int i = 0; i < n; i++) {
+            assert(int_to_int_cht_contains_key(ht_p, i) == (i % 2 == 1));
+            assert(int_to_int_cht_get_value(ht_p, i, 1) == (i % 2 == 1 ? -i : 1));
+        }
+        assert(int_to_int_cht_count(ht_p) == (uint32_t)n / 2);
+
+        int_to_int_cht_clear(ht_p);
+        assert(int_to_int_cht_count(ht_p) == 0);
+        assert(!int_to_int_cht_contains_key(ht_p, 1));
+
+        sum = sum_stats(ht_p);
+        assert(sum.n_reads == 2 * (uint32_t)n + 1);
+        assert(sum.n_writes == (uint32_t)n + (uint32_t)n / 2 + ht_p->n_shards);
+
+        int_to_int_cht_destroy(ht_p);
+    }
+    // allocation failure: shards grow while possible, then fill up
+    {
+        struct limited_allocator allocator = {.n_allocations_left = 4};
+        struct int_to_int_cht *ht_p =
+            int_to_int_cht_create_custom(2, 8, &allocator, limited_allocate, limited_deallocate);
+        if (!ht_p) {
+            assert(false);
+        }
+        // two shards of capacity 4, one of them can grow to 8:
+        int i = 0;
+        while (int_to_int_cht_update(ht_p, i, i)) {
+            i++;
+        }
+        assert(!int_to_int_cht_insert(ht_p, i, i));
+        assert(int_to_int_cht_count(ht_p) <= 12);
+        assert(int_to_int_cht_count(ht_p) >= 5);
+        assert(sum_stats(ht_p).n_grows == 1);
+        for (int j = 0; j < i; j++) {
+            assert(int_to_int_cht_get_value(ht_p, j, -1) == j);
+        }
+        int_to_int_cht_destroy(ht_p);
+    }
+    // allocation failure on creation
+    {
+        struct limited_allocator allocator = {.n_allocations_left = 3};
+        struct int_to_int_cht *ht_p =
+            int_to_int_cht_create_custom(4, 8, &allocator, limited_allocate, limited_deallocate);
+        if (ht_p) {
+            assert(false);
+        }
+    }
+}
+
+#define N_THREADS        (8)
+#define N_KEYS_PER_THREAD (12500)
+#define N_READER_KEYS    (1000)
+
+struct worker_args {
+    struct int_to_int_ctrl_cht *ht_p;
+    int thread_index;
+};
+
+static void *worker(void *args_ptr)
+{
+    const struct worker_args *args = args_ptr;
+    struct int_to_int_ctrl_cht *ht_p = args->ht_p;
+
+    const int begin = N_READER_KEYS + args->thread_index * N_KEYS_PER_THREAD;
+    const int end = begin + N_KEYS_PER_THREAD;
+
+    for (int key = begin; key < end; key++) {
+        assert(int_to_int_ctrl_cht_insert(ht_p, key, key));
+        assert(int_to_int_ctrl_cht_update(ht_p, key, -key));
+
+        // keys below N_READER_KEYS are never modified while the threads run:
+        const int reader_key = key % N_READER_KEYS;
+        assert(int_to_int_ctrl_cht_get_value(ht_p, reader_key, 0) == reader_key + 1);
+    }
+    for (int key = begin; key < end; key++) {
+        assert(int_to_int_ctrl_cht_get_value(ht_p, key, 0) == -key);
+    }
+    for (int key = begin; key < end; key += 2) {
+        assert(int_to_int_ctrl_cht_delete(ht_p, key));
+    }
+    return NULL;
+}
+
+void concurrent_test(void)
+{
+    // N = 1e+5
+    struct int_to_int_ctrl_cht *ht_p = int_to_int_ctrl_cht_create(4, 1);
+    if (!ht_p) {
+        assert(false);
+    }
+    for (int key = 0; key < N_READER_KEYS; key++) {
+        assert(int_to_int_ctrl_cht_insert(ht_p, key, key + 1));
+    }
+
+    pthread_t threads[N_THREADS];
+    struct worker_args args[N_THREADS];
+    for (int i = 0; i < N_THREADS; i++) {
+        args[i] = (struct worker_args){.ht_p = ht_p, .thread_index = i};
+        if (pthread_create(&threads[i], NULL, worker, &args[i]) != 0) {
+            assert(false);
+        }
+    }
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    const uint32_t n_written = N_THREADS * N_KEYS_PER_THREAD;
+    assert(int_to_int_ctrl_cht_count(ht_p) == N_READER_KEYS + n_written / 2);
+    for (int key = 0; key < N_READER_KEYS + (int)n_written; key++) {
+        const int expected_value = key < N_READER_KEYS ? key + 1 : (key - N_READER_KEYS) % 2 == 0 ? 0 : -key;
+        assert(int_to_int_ctrl_cht_get_value(ht_p, key, 0) == expected_value);
+    }
+
+    uint64_t n_reads = 0;
+    uint64_t n_writes = 0;
+    for (uint32_t i = 0; i < ht_p->n_shards; i++) {
+        const struct int_to_int_ctrl_cht_shard_stats stats = int_to_int_ctrl_cht_get_shard_stats(ht_p, i);
+        assert(stats.n_contended_reads <= stats.n_reads);
+        assert(stats.n_contended_writes <= stats.n_writes);
+        n_reads += stats.n_reads;
+        n_writes += stats.n_writes;
+    }
+    assert(n_reads == 2 * n_written + N_READER_KEYS + n_written);
+    assert(n_writes == N_READER_KEYS + 2 * n_written + n_written / 2);
+
+    int_to_int_ctrl_cht_destroy(ht_p);
+}
+
+#define compare_with_array(cht_name, n_ops, key_range)                                   \
+    do {                                                                                 \
+        struct cht_name *ht_p = JOIN(cht_name, create)(8, 1);                            \
+        if (!ht_p) {                                                                     \
+            assert(false);                                                               \
+        }                                                                                \
+        int *values = malloc(sizeof(int) * (key_range));                                 \
+        bool *exists = calloc((key_range), sizeof(bool));                                \
+        uint32_t count = 0;                                                              \
+                                                                                         \
+        srand(42);                                                                       \
+        for (int op = 0; op < (n_ops); op++) {                                           \
+            const int key = rand() % (key_range);                                        \
+            const int value = rand();                                                    \
+            switch (rand() % 4) {                                                        \
+            case 0:                                                                      \
+            case 1:                                                                      \
+                assert(JOIN(cht_name, update)(ht_p, key, value));                        \
+                count += !exists[key];                                                   \
+                exists[key] = true;                                                      \
+                values[key] = value;                                                     \
+                break;                                                                   \
+            case 2:                                                                      \
+                assert(JOIN(cht_name, delete)(ht_p, key) == exists[key]);                \
+                count -= exists[key];                                                    \
+                exists[key] = false;                                                     \
+                break;                                                                   \
+            case 3:                                                                      \
+                assert(JOIN(cht_name, contains_key)(ht_p, key) == exists[key]);          \
+                if (exists[key]) {                                                       \
+                    assert(JOIN(cht_name, get_value)(ht_p, key, -1) == values[key]);     \
+                }                                                                        \
+                break;                                                                   \
+            }                                                                            \
+        }                                                                                \
+        assert(JOIN(cht_name, count)(ht_p) == count);                                    \
+        for (int key = 0; key < (key_range); key++) {                                    \
+            const int expected_value = exists[key] ? values[key] : -1;                   \
+            assert(JOIN(cht_name, get_value)(ht_p, key, -1) == expected_value);          \
+        }                                                                                \
+                                                                                         \
+        free(exists);                                                                    \
+        free(values);                                                                    \
+        JOIN(cht_name, destroy)(ht_p);                                                   \
+    } while (0)
+
+void random_ops_test(void)
+{
+    // N = 1e+5
+    compare_with_array(int_to_int_cht, 100000, 50000);
+    compare_with_array(int_to_int_ctrl_cht, 100000, 50000);
+}
+
+int main(void)
+{
+    int_int_test();
+    concurrent_test();
+    random_ops_test();
+
+    printf("chashtable test succeeded.\n");
+
+    return 0;
+}
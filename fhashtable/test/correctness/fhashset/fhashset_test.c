@@ -0,0 +1,230 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 16
+    - N := 1e+3
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - is_empty + is_full
+    - contains + FHASHSET_FOR_EACH
+
+    Mutating operation types:
+    - insert (also of contained keys)
+    - delete
+    - clear
+    - copy (to the same and a larger capacity)
+
+    Set operations:
+    - intersect_count
+    - union_into (also into a destination that gets full)
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Hashsets:
+    - default layout
+    - FHASHSET_LARGE_CAPACITY
+    - all keys with the same hash
+
+    A slot of an `uint64_t` set takes 16 bytes.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_set
+#define KEY_TYPE           int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashset_template.h"
+
+#define NAME               int_large_set
+#define KEY_TYPE           int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((size_t)fnvhash_32((uint8_t *)&(key), sizeof(int)) * 0x9E3779B97F4A7C15ULL)
+#define FHASHSET_LARGE_CAPACITY
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashset_template.h"
+
+// all keys have the same hash:
+#define NAME               int_collide_set
+#define KEY_TYPE           int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) * 0U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashset_template.h"
+
+#define NAME               u64_set
+#define KEY_TYPE           uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(uint64_t))
+#define TYPE_DEFINITIONS
+#include "fhashset_template.h"
+
+#define insert_delete_and_compare(SET, size_type, n)                                     \
+    do {                                                                                 \
+        struct SET *set_p = JOIN(SET, create)((n) + 1);                                  \
+        if (!set_p) {                                                                    \
+            assert(false);                                                               \
+        }                                                                                \
+        assert(JOIN(SET, is_empty)(set_p));                                              \
+        for (int i = 0; i < (n); i++) {                                                  \
+            assert(JOIN(SET, insert)(set_p, 3 * i));                                     \
+            assert(!JOIN(SET, insert)(set_p, 3 * i));                                    \
+        }                                                                                \
+        assert(set_p->count == (size_type)(n));                                          \
+        assert(JOIN(SET, is_empty)(set_p) == ((n) == 0));                                \
+        for (int i = 0; i < 3 * (n) + 3; i++) {                                          \
+            assert(JOIN(SET, contains)(set_p, i) == (i % 3 == 0 && i < 3 * (n)));        \
+        }                                                                                \
+                                                                                         \
+        size_type index;                                                                 \
+        int key;                                                                         \
+        int count = 0;                                                                   \
+        FHASHSET_FOR_EACH(set_p, index, key)                                             \
+        {                                                                                \
+            assert(key % 3 == 0 && key < 3 * (n));                                       \
+            count++;                                                                     \
+        }                                                                                \
+        assert(count == (n));                                                            \
+                                                                                         \
+        /* copy to the same and to a larger capacity: */                                 \
+        for (size_type factor = 1; factor <= 4; factor *= 2) {                           \
+            struct SET *copy_p = JOIN(SET, create)(set_p->capacity * factor);            \
+            if (!copy_p) {                                                               \
+                assert(false);                                                           \
+            }                                                                            \
+            JOIN(SET, copy)(copy_p, set_p);                                              \
+            assert(copy_p->count == set_p->count);                                       \
+            for (int i = 0; i < 3 * (n) + 3; i++) {                                      \
+                assert(JOIN(SET, contains)(copy_p, i) == JOIN(SET, contains)(set_p, i)); \
+            }                                                                            \
+            JOIN(SET, destroy)(copy_p);                                                  \
+        }                                                                                \
+                                                                                         \
+        for (int i = 0; i < (n); i += 2) {                                               \
+            assert(JOIN(SET, delete)(set_p, 3 * i));                                     \
+            assert(!JOIN(SET, delete)(set_p, 3 * i));                                    \
+        }                                                                                \
+        assert(!JOIN(SET, delete)(set_p, 1));                                            \
+        assert(set_p->count == (size_type)((n) / 2));                                    \
+        for (int i = 0; i < (n); i++) {                                                  \
+            assert(JOIN(SET, contains)(set_p, 3 * i) == (i % 2 == 1));                   \
+        }                                                                                \
+                                                                                         \
+        JOIN(SET, clear)(set_p);                                                         \
+        assert(JOIN(SET, is_empty)(set_p));                                              \
+        for (int i = 0; i < (n); i++) {                                                  \
+            assert(!JOIN(SET, contains)(set_p, 3 * i));                                  \
+        }                                                                                \
+                                                                                         \
+        JOIN(SET, destroy)(set_p);                                                       \
+    } while (0)
+
+#define set_operations_and_compare(SET, size_type, n)                        \
+    do {                                                                     \
+        /* multiples of 2 and multiples of 3 below 6n: */                    \
+        struct SET *a_p = JOIN(SET, create)(3 * (n) + 1);                    \
+        struct SET *b_p = JOIN(SET, create)(2 * (n) + 1);                    \
+        if (!a_p || !b_p) {                                                  \
+            assert(false);                                                   \
+        }                                                                    \
+        for (int i = 0; i < 6 * (n); i++) {                                  \
+            if (i % 2 == 0) {                                                \
+                JOIN(SET, insert)(a_p, i);                                   \
+            }                                                                \
+            if (i % 3 == 0) {                                                \
+                JOIN(SET, insert)(b_p, i);                                   \
+            }                                                                \
+        }                                                                    \
+        assert(JOIN(SET, intersect_count)(a_p, b_p) == (size_type)(n));      \
+        assert(JOIN(SET, intersect_count)(b_p, a_p) == (size_type)(n));      \
+        assert(JOIN(SET, intersect_count)(a_p, a_p) == a_p->count);          \
+                                                                             \
+        struct SET *union_p = JOIN(SET, create)(4 * (n) + 1);                \
+        if (!union_p) {                                                      \
+            assert(false);                                                   \
+        }                                                                    \
+        assert(JOIN(SET, union_into)(union_p, a_p));                         \
+        assert(JOIN(SET, union_into)(union_p, b_p));                         \
+        assert(union_p->count == (size_type)(4 * (n)));                      \
+        for (int i = 0; i < 6 * (n) + 1; i++) {                              \
+            const bool expected = i < 6 * (n) && (i % 2 == 0 || i % 3 == 0); \
+            assert(JOIN(SET, contains)(union_p, i) == expected);             \
+        }                                                                    \
+        JOIN(SET, destroy)(union_p);                                         \
+                                                                             \
+        /* the union does not fit when b has keys that a has not: */         \
+        struct SET *full_p = JOIN(SET, create)(a_p->capacity);               \
+        if (!full_p) {                                                       \
+            assert(false);                                                   \
+        }                                                                    \
+        for (int i = 0; full_p->count < full_p->capacity; i++) {             \
+            JOIN(SET, insert)(full_p, 2 * i);                                \
+        }                                                                    \
+        assert(JOIN(SET, union_into)(full_p, b_p) == ((n) == 0));            \
+        assert(JOIN(SET, is_full)(full_p));                                  \
+        JOIN(SET, destroy)(full_p);                                          \
+                                                                             \
+        JOIN(SET, destroy)(a_p);                                             \
+        JOIN(SET, destroy)(b_p);                                             \
+    } while (0)
+
+int main(void)
+{
+    insert_delete_and_compare(int_set, uint32_t, 0);
+    insert_delete_and_compare(int_set, uint32_t, 1);
+    insert_delete_and_compare(int_set, uint32_t, 16);
+    insert_delete_and_compare(int_set, uint32_t, 1000);
+    insert_delete_and_compare(int_set, uint32_t, 100000);
+
+    insert_delete_and_compare(int_large_set, size_t, 0);
+    insert_delete_and_compare(int_large_set, size_t, 1000);
+    insert_delete_and_compare(int_large_set, size_t, 100000);
+
+    insert_delete_and_compare(int_collide_set, uint32_t, 16);
+    insert_delete_and_compare(int_collide_set, uint32_t, 1000);
+
+    set_operations_and_compare(int_set, uint32_t, 0);
+    set_operations_and_compare(int_set, uint32_t, 1);
+    set_operations_and_compare(int_set, uint32_t, 16);
+    set_operations_and_compare(int_set, uint32_t, 1000);
+    set_operations_and_compare(int_set, uint32_t, 100000);
+
+    set_operations_and_compare(int_large_set, size_t, 1000);
+    set_operations_and_compare(int_collide_set, uint32_t, 100);
+
+    assert(sizeof(struct u64_set_slot) == 16);
+
+    // inserting past the capacity rounds up to the next power of 2:
+    {
+        struct int_set *set_p = int_set_create(3);
+        if (!set_p) {
+            assert(false);
+        }
+        assert(set_p->capacity == 4);
+        for (int i = 0; i < 4; i++) {
+            assert(int_set_insert(set_p, i));
+        }
+        assert(int_set_is_full(set_p));
+        assert(!int_set_insert(set_p, 0));
+        int_set_destroy(set_p);
+    }
+
+    assert(int_set_create(0) == NULL);
+    assert(int_set_create(UINT32_MAX / 2 + 2) == NULL);
+}
@@ -12,11 +12,14 @@
     - is_empty
     - is_full
     - contains_key + get_value + get_value_mut / search + fhashtable_for_each
+    - contains_key_batch + get_value_batch + get_value_mut_batch
     - calc_sizeof (this is indirectly tested for with `create`)
 
     Mutating operation types:
     - insert
     - update
+    - get_or_insert
+    - upsert (COMBINE_VALUES)
     - delete
     - clear
 
@@ -42,9 +45,55 @@
     - <50%
     - <75%
     - <100%
+
+    Layouts (compared against the default layout):
+    - FHASHTABLE_CONTROL_BYTES
+    - FHASHTABLE_FINGERPRINT (+ copy with and without reusing stored hashes)
+    - FHASHTABLE_FINGERPRINT + FHASHTABLE_CONTROL_BYTES
+    - FHASHTABLE_LAYOUT_SOA (+ FHASHTABLE_SOA_FOR_EACH, mixed key / value alignments)
+    - FHASHTABLE_LAYOUT_SOA + FHASHTABLE_FINGERPRINT + FHASHTABLE_CONTROL_BYTES
+    - FHASHTABLE_LARGE_CAPACITY (+ all of the above, allocation size beyond UINT32_MAX)
+
+    Persistence (FHASHTABLE_PERSIST):
+    - save_to_fd + map_from_file (read-only / writable) + unmap
+    - default layout, FHASHTABLE_LAYOUT_SOA + FHASHTABLE_FINGERPRINT + FHASHTABLE_CONTROL_BYTES
+    - rejected files: other hash id, other layout, truncated, not a hashtable
+
+    Probe counters (FHASHTABLE_STATS):
+    - get_stats + reset_stats, counted by hand for a clustered hash function
+    - compared against the default layout, with and without FHASHTABLE_CONTROL_BYTES
+
+    Bulk build (build_from_arrays):
+    - same slots taken as inserting one by one, for all layouts
+    - keys wrapping around the end of the slots, full tables
+    - build_from_arrays_custom with a failing allocator
+
+    Parallel operations (FHASHTABLE_PARALLEL):
+    - parallel_for_each_range (+ FHASHTABLE_FOR_EACH_RANGE) summed per thread
+    - parallel_copy to the same / a larger capacity, parallel_clear, parallel_init
+    - 1 to more than FHASHTABLE_PARALLEL_MAX_THREADS threads, fewer slots than threads
+    - clusters crossing the ranges, keys wrapping around the end of the slots
+
+    Occupancy bitmap (FHASHTABLE_OCCUPANCY_BITMAP):
+    - FHASHTABLE_BITMAP_FOR_EACH / FHASHTABLE_SOA_BITMAP_FOR_EACH against a reference hashtable after random
+      inserts / updates / deletes, dense and sparse
+    - clear, copy, build_from_arrays, parallel operations, save_to_fd + map_from_file
+
+    Copy (copy):
+    - same capacity, twice the capacity (one pass) and four times the capacity
+    - same slots taken as inserting one by one, sources with deleted keys
+    - clustered hashes, keys wrapping around the end of the slots, full sources
+    - all layouts, with and without reusing the stored hashes, FHASHTABLE_STATS
+
+    Multimap (FHASHTABLE_MULTIMAP):
+    - insert_multi + equal_range (+ FHASHTABLE_EQUAL_RANGE_FOR_EACH / FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH) + count_key
+      against the values inserted per key, after random inserts / updates / deletes / delete_all
+    - clustered hashes with several keys per ideal slot, keys wrapping around the end of the slots, full tables
+    - copy to the same / twice / four times the capacity, parallel_copy
 */
 
 #include <assert.h>
+#include <stdalign.h>
 #include <stdio.h>
 
 #include "fnvhash.h"
@@ -448,9 +497,1556 @@ void struct_key_value_test()
     }
 }
 
+#define NAME               int_to_int_ctrl_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+#define NAME               bd_ctrl_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE000003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+#define compare_with_default_layout(ht_name, capacity, n_ops, key_range)                               \
+    __extension__({                                                                                    \
+        struct int_to_int_ht *expected_p = int_to_int_ht_create(capacity);                             \
+        struct ht_name *actual_p = JOIN(ht_name, create)(capacity);                                    \
+        assert(expected_p && actual_p);                                                                \
+                                                                                                       \
+        for (int i = 0; i < (n_ops); i++) {                                                            \
+            const int key = rand() % (key_range);                                                      \
+            const int value = rand();                                                                  \
+            const bool has_key = int_to_int_ht_contains_key(expected_p, key);                          \
+            const bool is_full = int_to_int_ht_is_full(expected_p);                                    \
+            switch (rand() % 4) {                                                                      \
+            case 0:                                                                                    \
+                if (has_key || !is_full) {                                                             \
+                    int_to_int_ht_update(expected_p, key, value);                                      \
+                    JOIN(ht_name, update)(actual_p, key, value);                                       \
+                }                                                                                      \
+                break;                                                                                 \
+            case 1:                                                                                    \
+                if (!has_key && !is_full) {                                                            \
+                    int_to_int_ht_insert(expected_p, key, value);                                      \
+                    JOIN(ht_name, insert)(actual_p, key, value);                                       \
+                }                                                                                      \
+                break;                                                                                 \
+            case 2:                                                                                    \
+                assert(int_to_int_ht_delete(expected_p, key) == JOIN(ht_name, delete)(actual_p, key)); \
+                break;                                                                                 \
+            default:                                                                                   \
+                assert(has_key == JOIN(ht_name, contains_key)(actual_p, key));                         \
+                assert(int_to_int_ht_get_value(expected_p, key, -1)                                    \
+                       == JOIN(ht_name, get_value)(actual_p, key, -1));                                \
+                break;                                                                                 \
+            }                                                                                          \
+            assert(expected_p->count == actual_p->count);                                              \
+        }                                                                                              \
+        for (int key = 0; key < (key_range); key++) {                                                  \
+            assert(int_to_int_ht_get_value(expected_p, key, -1)                                        \
+                   == JOIN(ht_name, get_value)(actual_p, key, -1));                                    \
+        }                                                                                              \
+                                                                                                       \
+        int_to_int_ht_destroy(expected_p);                                                             \
+        JOIN(ht_name, destroy)(actual_p);                                                              \
+    })
+
+void control_bytes_test()
+{
+    // N = 1, 16, 1e+3, 1e+5 at various loads
+    {
+        srand(42);
+        compare_with_default_layout(int_to_int_ctrl_ht, 1, 100, 4);
+        compare_with_default_layout(int_to_int_ctrl_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_ctrl_ht, 16, 10000, 100);
+        compare_with_default_layout(int_to_int_ctrl_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_ctrl_ht, 1000, 100000, 5000);
+        compare_with_default_layout(int_to_int_ctrl_ht, 100000, 1000000, 200000);
+    }
+    // N = 1e+3, clustered hashes with shared tags, full table
+    {
+        compare_with_default_layout(bd_ctrl_ht, 16, 10000, 64);
+        compare_with_default_layout(bd_ctrl_ht, 1000, 100000, 2000);
+
+        struct bd_ctrl_ht *ht_p = bd_ctrl_ht_create(1024);
+        for (int i = 0; i < 1024; i++) {
+            bd_ctrl_ht_insert(ht_p, i, -i);
+        }
+        assert(bd_ctrl_ht_is_full(ht_p));
+        for (int i = 0; i < 2048; i++) {
+            assert(bd_ctrl_ht_get_value(ht_p, i, 1) == (i < 1024 ? -i : 1));
+        }
+        for (int i = 0; i < 1024; i += 2) {
+            assert(bd_ctrl_ht_delete(ht_p, i));
+        }
+        for (int i = 0; i < 1024; i++) {
+            assert(bd_ctrl_ht_contains_key(ht_p, i) == (i % 2 == 1));
+        }
+        bd_ctrl_ht_clear(ht_p);
+        assert(!bd_ctrl_ht_contains_key(ht_p, 1));
+        bd_ctrl_ht_destroy(ht_p);
+    }
+}
+
+#define NAME               int_to_int_fp_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_FINGERPRINT
+#include "fhashtable_template.h"
+
+#define NAME               bd_fp_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_FINGERPRINT
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_fp_ctrl_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+#define copy_and_compare(ht_name, src_capacity, dest_capacity, n)               \
+    __extension__({                                                             \
+        struct ht_name *src_p = JOIN(ht_name, create)(src_capacity);            \
+        struct ht_name *dest_p = JOIN(ht_name, create)(dest_capacity);          \
+        assert(src_p && dest_p);                                                \
+                                                                                \
+        for (int i = 0; i < (n); i++) {                                         \
+            JOIN(ht_name, insert)(src_p, i * 7, i);                             \
+        }                                                                       \
+        JOIN(ht_name, copy)(dest_p, src_p);                                     \
+                                                                                \
+        assert(dest_p->count == (uint32_t)(n));                                 \
+        for (int i = 0; i < 7 * (n); i++) {                                     \
+            const int expected_value = i % 7 == 0 ? i / 7 : -1;                 \
+            assert(JOIN(ht_name, get_value)(dest_p, i, -1) == expected_value);  \
+        }                                                                       \
+        for (int i = 0; i < (n); i += 2) {                                      \
+            assert(JOIN(ht_name, delete)(dest_p, i * 7));                       \
+        }                                                                       \
+        for (int i = 0; i < (n); i++) {                                         \
+            assert(JOIN(ht_name, contains_key)(dest_p, i * 7) == (i % 2 == 1)); \
+        }                                                                       \
+                                                                                \
+        JOIN(ht_name, destroy)(src_p);                                          \
+        JOIN(ht_name, destroy)(dest_p);                                         \
+    })
+
+void fingerprint_test()
+{
+    // N = 1, 16, 1e+3, 1e+5 at various loads
+    {
+        srand(42);
+        compare_with_default_layout(int_to_int_fp_ht, 1, 100, 4);
+        compare_with_default_layout(int_to_int_fp_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_fp_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_fp_ht, 1000, 100000, 5000);
+        compare_with_default_layout(int_to_int_fp_ht, 100000, 1000000, 200000);
+
+        compare_with_default_layout(int_to_int_fp_ctrl_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_fp_ctrl_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_fp_ctrl_ht, 100000, 1000000, 200000);
+    }
+    // N = 1e+3, clustered hashes with shared fingerprints, full table
+    {
+        compare_with_default_layout(bd_fp_ht, 16, 10000, 64);
+        compare_with_default_layout(bd_fp_ht, 1000, 100000, 2000);
+
+        struct bd_fp_ht *ht_p = bd_fp_ht_create(1024);
+        for (int i = 0; i < 1024; i++) {
+            bd_fp_ht_insert(ht_p, i, -i);
+        }
+        assert(bd_fp_ht_is_full(ht_p));
+        for (int i = 0; i < 2048; i++) {
+            assert(bd_fp_ht_get_value(ht_p, i, 1) == (i < 1024 ? -i : 1));
+        }
+        for (int i = 0; i < 1024; i += 2) {
+            assert(bd_fp_ht_delete(ht_p, i));
+        }
+        for (int i = 0; i < 1024; i++) {
+            assert(bd_fp_ht_contains_key(ht_p, i) == (i % 2 == 1));
+        }
+        bd_fp_ht_destroy(ht_p);
+    }
+    // copy: same capacity and large source reuse the stored hashes, otherwise rehash
+    {
+        copy_and_compare(int_to_int_fp_ht, 1024, 1024, 700);
+        copy_and_compare(int_to_int_fp_ht, 1024, 4096, 700);
+        copy_and_compare(int_to_int_fp_ht, 1 << 16, 1 << 17, 40000);
+        copy_and_compare(int_to_int_fp_ctrl_ht, 1 << 16, 1 << 17, 40000);
+        copy_and_compare(bd_fp_ht, 1024, 1024, 700);
+        copy_and_compare(bd_fp_ht, 1024, 2048, 700);
+    }
+}
+
+#define compare_batch_with_single(ht_name, capacity, n_keys, key_range)           \
+    __extension__({                                                               \
+        const uint32_t n = (n_keys);                                              \
+        struct ht_name *ht_p = JOIN(ht_name, create)(capacity);                   \
+        assert(ht_p);                                                             \
+        while (!JOIN(ht_name, is_full)(ht_p)) {                                   \
+            JOIN(ht_name, update)(ht_p, rand() % (key_range), rand());            \
+        }                                                                         \
+                                                                                  \
+        int *keys = malloc(sizeof(int) * n + 1);                                  \
+        int *values = malloc(sizeof(int) * n + 1);                                \
+        int **value_ptrs = malloc(sizeof(int *) * n + 1);                         \
+        bool *results = malloc(sizeof(bool) * n + 1);                             \
+        for (uint32_t i = 0; i < n; i++) {                                        \
+            keys[i] = rand() % (2 * (key_range));                                 \
+        }                                                                         \
+                                                                                  \
+        JOIN(ht_name, contains_key_batch)(ht_p, n, keys, results);                \
+        JOIN(ht_name, get_value_batch)(ht_p, n, keys, -1, values);                \
+        JOIN(ht_name, get_value_mut_batch)(ht_p, n, keys, value_ptrs);            \
+        for (uint32_t i = 0; i < n; i++) {                                        \
+            assert(results[i] == JOIN(ht_name, contains_key)(ht_p, keys[i]));     \
+            assert(values[i] == JOIN(ht_name, get_value)(ht_p, keys[i], -1));     \
+            assert(value_ptrs[i] == JOIN(ht_name, get_value_mut)(ht_p, keys[i])); \
+        }                                                                         \
+                                                                                  \
+        free(keys);                                                               \
+        free(values);                                                             \
+        free(value_ptrs);                                                         \
+        free(results);                                                            \
+        JOIN(ht_name, destroy)(ht_p);                                             \
+    })
+
+void batch_test()
+{
+    srand(42);
+
+    // N = 0 keys
+    compare_batch_with_single(int_to_int_ht, 16, 0, 100);
+
+    // N = 1, 16, 1e+3, 1e+5 keys, which are not all multiples of the batch size
+    compare_batch_with_single(int_to_int_ht, 1, 1, 4);
+    compare_batch_with_single(int_to_int_ht, 16, FHASHTABLE_BATCH_SIZE, 100);
+    compare_batch_with_single(int_to_int_ht, 1000, 1000, 5000);
+    compare_batch_with_single(int_to_int_ht, 100000, 100003, 1000000);
+
+    compare_batch_with_single(int_to_int_ctrl_ht, 1000, 1000, 5000);
+    compare_batch_with_single(bd_ctrl_ht, 1000, 1000, 5000);
+    compare_batch_with_single(int_to_int_fp_ht, 1000, 1000, 5000);
+    compare_batch_with_single(int_to_int_fp_ctrl_ht, 100000, 100003, 1000000);
+}
+
+#define NAME                             counter_ht
+#define KEY_TYPE                         int
+#define VALUE_TYPE                       int
+#define KEY_IS_EQUAL(a, b)               ((a) == (b))
+#define HASH_FUNCTION(key)               fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define COMBINE_VALUES(old_value, value) ((old_value) + (value))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME                             bd_counter_ht
+#define KEY_TYPE                         int
+#define VALUE_TYPE                       int
+#define KEY_IS_EQUAL(a, b)               ((a) == (b))
+#define HASH_FUNCTION(key)               ((uint32_t)(key) & 0xFE010003U)
+#define COMBINE_VALUES(old_value, value) ((old_value) + (value))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+#define count_and_compare(ht_name, capacity, n_ops, key_range)                 \
+    __extension__({                                                            \
+        struct ht_name *ht_p = JOIN(ht_name, create)(capacity);                \
+        int *counts = calloc((key_range), sizeof(int));                        \
+        assert(ht_p && counts);                                                \
+                                                                               \
+        for (int i = 0; i < (n_ops); i++) {                                    \
+            const int key = rand() % (key_range);                              \
+            int *value_ptr = JOIN(ht_name, upsert)(ht_p, key, 1);              \
+            if (value_ptr == NULL) {                                           \
+                assert(counts[key] == 0 && JOIN(ht_name, is_full)(ht_p));      \
+                continue;                                                      \
+            }                                                                  \
+            counts[key]++;                                                     \
+            assert(*value_ptr == counts[key]);                                 \
+        }                                                                      \
+        for (int key = 0; key < (key_range); key++) {                          \
+            const int expected_value = counts[key] != 0 ? counts[key] : -1;    \
+            assert(JOIN(ht_name, get_value)(ht_p, key, -1) == expected_value); \
+        }                                                                      \
+                                                                               \
+        free(counts);                                                          \
+        JOIN(ht_name, destroy)(ht_p);                                          \
+    })
+
+void entry_test()
+{
+    // N = 1
+    {
+        struct counter_ht *ht_p = counter_ht_create(1);
+        bool inserted;
+
+        int *value_ptr = counter_ht_get_or_insert(ht_p, 42, 69, &inserted);
+        assert(inserted && *value_ptr == 69);
+        assert(ht_p->count == 1);
+
+        value_ptr = counter_ht_get_or_insert(ht_p, 42, 0, &inserted);
+        assert(!inserted && *value_ptr == 69);
+        *value_ptr = 1;
+        assert(counter_ht_get_value(ht_p, 42, -1) == 1);
+
+        assert(counter_ht_get_or_insert(ht_p, 69, 0, &inserted) == NULL);
+        assert(counter_ht_upsert(ht_p, 69, 1) == NULL);
+        assert(*counter_ht_upsert(ht_p, 42, 2) == 3);
+        assert(ht_p->count == 1);
+
+        counter_ht_destroy(ht_p);
+    }
+    // N = 16, 1e+3, 1e+5 at various loads, counting
+    {
+        srand(42);
+        count_and_compare(counter_ht, 16, 1000, 8);
+        count_and_compare(counter_ht, 16, 1000, 100);
+        count_and_compare(counter_ht, 1000, 100000, 1000);
+        count_and_compare(counter_ht, 100000, 1000000, 90000);
+        count_and_compare(bd_counter_ht, 16, 1000, 100);
+        count_and_compare(bd_counter_ht, 1000, 100000, 1000);
+        count_and_compare(bd_counter_ht, 1000, 100000, 5000);
+    }
+    // get_or_insert keeps the other keys intact, when displacing slots
+    {
+        struct bd_counter_ht *ht_p = bd_counter_ht_create(1024);
+        bool inserted;
+        for (int i = 0; i < 1024; i++) {
+            int *value_ptr = bd_counter_ht_get_or_insert(ht_p, i, -i, &inserted);
+            assert(inserted && *value_ptr == -i);
+        }
+        for (int i = 0; i < 1024; i++) {
+            assert(*bd_counter_ht_get_or_insert(ht_p, i, 0, &inserted) == -i);
+            assert(!inserted);
+        }
+        assert(bd_counter_ht_get_or_insert(ht_p, 1024, 0, &inserted) == NULL);
+        bd_counter_ht_destroy(ht_p);
+    }
+}
+
+#define NAME               int_to_int_soa_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#include "fhashtable_template.h"
+
+#define NAME               bd_soa_ctrl_fp_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+typedef struct {
+    double x, y, z;
+    char tag;
+} big_value;
+
+#define NAME               char_to_big_soa_ht
+#define KEY_TYPE           char
+#define VALUE_TYPE         big_value
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(char))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+void soa_layout_test()
+{
+    // N = 1, 16, 1e+3, 1e+5 at various loads
+    {
+        srand(42);
+        compare_with_default_layout(int_to_int_soa_ht, 1, 100, 4);
+        compare_with_default_layout(int_to_int_soa_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_soa_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_soa_ht, 100000, 1000000, 200000);
+        compare_with_default_layout(bd_soa_ctrl_fp_ht, 16, 10000, 64);
+        compare_with_default_layout(bd_soa_ctrl_fp_ht, 1000, 100000, 2000);
+
+        copy_and_compare(int_to_int_soa_ht, 1024, 4096, 700);
+        copy_and_compare(bd_soa_ctrl_fp_ht, 1024, 1024, 700);
+        copy_and_compare(bd_soa_ctrl_fp_ht, 1024, 2048, 700);
+        compare_batch_with_single(int_to_int_soa_ht, 1000, 1000, 5000);
+    }
+    // N = 128, keys and values of different size and alignment, iteration
+    {
+        struct char_to_big_soa_ht *ht_p = char_to_big_soa_ht_create(128);
+        assert(ht_p);
+        assert((uintptr_t)ht_p->values % alignof(big_value) == 0);
+
+        for (int i = 0; i < 128; i++) {
+            const big_value value = {.x = i, .y = -i, .z = 2 * i, .tag = (char)i};
+            char_to_big_soa_ht_insert(ht_p, (char)i, value);
+        }
+        assert(char_to_big_soa_ht_is_full(ht_p));
+
+        for (int i = 0; i < 128; i += 2) {
+            assert(char_to_big_soa_ht_delete(ht_p, (char)i));
+        }
+
+        uint32_t index;
+        char key;
+        big_value value;
+        uint32_t count = 0;
+        FHASHTABLE_SOA_FOR_EACH(ht_p, index, key, value)
+        {
+            assert(key % 2 == 1);
+            assert(value.x == key && value.y == -key && value.z == 2 * key && value.tag == key);
+            count++;
+        }
+        assert(count == 64);
+
+        struct char_to_big_soa_ht *ht_copy_p = char_to_big_soa_ht_create(256);
+        char_to_big_soa_ht_copy(ht_copy_p, ht_p);
+        for (int i = 0; i < 128; i++) {
+            const big_value *value_ptr = char_to_big_soa_ht_get_value_mut(ht_copy_p, (char)i);
+            assert((value_ptr != NULL) == (i % 2 == 1));
+            assert(value_ptr == NULL || value_ptr->tag == (char)i);
+        }
+
+        char_to_big_soa_ht_destroy(ht_copy_p);
+        char_to_big_soa_ht_destroy(ht_p);
+    }
+}
+
+#define NAME               int_to_int_large_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((size_t)fnvhash_32((uint8_t *)&(key), sizeof(int)) * (size_t)UINT64_C(0x9E3779B97F4A7C15))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LARGE_CAPACITY
+#include "fhashtable_template.h"
+
+#define NAME               bd_large_soa_ctrl_fp_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((size_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LARGE_CAPACITY
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#include "fhashtable_template.h"
+
+static size_t requested_size;
+
+static void *record_size_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    requested_size = size;
+    return NULL;
+}
+
+void large_capacity_test()
+{
+    // N = 1, 16, 1e+3, 1e+5 at various loads
+    {
+        srand(42);
+        compare_with_default_layout(int_to_int_large_ht, 1, 100, 4);
+        compare_with_default_layout(int_to_int_large_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_large_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_large_ht, 100000, 1000000, 200000);
+        compare_with_default_layout(bd_large_soa_ctrl_fp_ht, 16, 10000, 64);
+        compare_with_default_layout(bd_large_soa_ctrl_fp_ht, 1000, 100000, 2000);
+
+        copy_and_compare(int_to_int_large_ht, 1024, 4096, 700);
+        copy_and_compare(bd_large_soa_ctrl_fp_ht, 1024, 1024, 700);
+        copy_and_compare(bd_large_soa_ctrl_fp_ht, 1 << 16, 1 << 17, 40000);
+        compare_batch_with_single(int_to_int_large_ht, 1000, 1000, 5000);
+        compare_batch_with_single(bd_large_soa_ctrl_fp_ht, 1000, 1000, 5000);
+    }
+    // N = UINT32_MAX + 2, only the requested allocation size is checked
+    {
+        requested_size = 0;
+        assert(int_to_int_ht_create_custom(UINT32_MAX / 2 + 1, NULL, record_size_allocate) == NULL);
+        assert(requested_size == 0);
+
+        if (SIZE_MAX > UINT32_MAX) {
+            const size_t min_capacity = (size_t)UINT32_MAX + 2;
+            assert(int_to_int_large_ht_create_custom(min_capacity, NULL, record_size_allocate) == NULL);
+            assert(requested_size >= 2 * ((size_t)UINT32_MAX + 1) * sizeof(struct int_to_int_large_ht_slot));
+        }
+    }
+}
+
+#define NAME               int_to_int_persist_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_PERSIST
+#define FHASHTABLE_HASH_ID 1
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_persist_other_hash_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) murmur3_32((uint8_t *)&(key), sizeof(int), 0)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_PERSIST
+#define FHASHTABLE_HASH_ID 2
+#include "fhashtable_template.h"
+
+#define NAME               bd_soa_ctrl_fp_persist_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_PERSIST
+#define FHASHTABLE_HASH_ID 1
+#include "fhashtable_template.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#define save_map_and_compare(name, n, key_range, path)                   \
+    do {                                                                 \
+        struct name *ht_p = JOIN(name, create)((n));                     \
+        assert(ht_p);                                                    \
+        for (int i = 0; i < (int)(n) * 3 / 4; i++) {                     \
+            JOIN(name, update)(ht_p, rand() % (key_range), i);           \
+        }                                                                \
+                                                                         \
+        const int fd = mkstemp((path));                                  \
+        assert(fd >= 0);                                                 \
+        assert(JOIN(name, save_to_fd)(ht_p, fd));                        \
+        close(fd);                                                       \
+                                                                         \
+        struct name *ro_ht_p = JOIN(name, map_from_file)((path), false); \
+        assert(ro_ht_p);                                                 \
+        assert(ro_ht_p->count == ht_p->count);                           \
+        assert(ro_ht_p->capacity == ht_p->capacity);                     \
+        for (int key = 0; key < (key_range); key++) {                    \
+            assert(JOIN(name, get_value)(ro_ht_p, key, -1)               \
+                   == JOIN(name, get_value)(ht_p, key, -1));             \
+        }                                                                \
+                                                                         \
+        struct name *rw_ht_p = JOIN(name, map_from_file)((path), true);  \
+        assert(rw_ht_p);                                                 \
+        for (int key = 0; key < (key_range); key += 2) {                 \
+            const bool has_deleted = JOIN(name, delete)(ht_p, key);      \
+            assert(JOIN(name, delete)(rw_ht_p, key) == has_deleted);     \
+        }                                                                \
+        JOIN(name, update)(rw_ht_p, (key_range), 42);                    \
+        JOIN(name, update)(ht_p, (key_range), 42);                       \
+        for (int key = 0; key <= (key_range); key++) {                   \
+            assert(JOIN(name, get_value)(rw_ht_p, key, -1)               \
+                   == JOIN(name, get_value)(ht_p, key, -1));             \
+        }                                                                \
+        /* the file and other mappings are not modified: */              \
+        assert(!JOIN(name, contains_key)(ro_ht_p, (key_range)));         \
+                                                                         \
+        JOIN(name, unmap)(rw_ht_p);                                      \
+        JOIN(name, unmap)(ro_ht_p);                                      \
+        JOIN(name, destroy)(ht_p);                                       \
+    } while (0)
+
+void persist_test()
+{
+    // N = 16, 1e+3, 1e+5
+    {
+        srand(42);
+        char path_16[] = "/tmp/fhashtable_test_XXXXXX";
+        save_map_and_compare(int_to_int_persist_ht, 16, 32, path_16);
+        unlink(path_16);
+
+        char path_1000[] = "/tmp/fhashtable_test_XXXXXX";
+        save_map_and_compare(bd_soa_ctrl_fp_persist_ht, 1000, 2000, path_1000);
+        unlink(path_1000);
+
+        char path_100000[] = "/tmp/fhashtable_test_XXXXXX";
+        save_map_and_compare(int_to_int_persist_ht, 100000, 200000, path_100000);
+
+        // only the matching instantiation maps the file:
+        assert(int_to_int_persist_other_hash_ht_map_from_file(path_100000, false) == NULL);
+        assert(bd_soa_ctrl_fp_persist_ht_map_from_file(path_100000, false) == NULL);
+
+        struct int_to_int_persist_ht *ht_p = int_to_int_persist_ht_map_from_file(path_100000, false);
+        assert(ht_p);
+        int_to_int_persist_ht_unmap(ht_p);
+
+        assert(truncate(path_100000, 4096) == 0);
+        assert(int_to_int_persist_ht_map_from_file(path_100000, false) == NULL);
+        assert(truncate(path_100000, 0) == 0);
+        assert(int_to_int_persist_ht_map_from_file(path_100000, false) == NULL);
+        unlink(path_100000);
+
+        assert(int_to_int_persist_ht_map_from_file(path_100000, false) == NULL);
+        assert(int_to_int_persist_ht_map_from_file("fhashtable_test.c", false) == NULL);
+    }
+}
+
+#define NAME               int_to_int_stats_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_STATS
+#include "fhashtable_template.h"
+
+#define NAME               tens_stats_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) / 10U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_STATS
+#include "fhashtable_template.h"
+
+#define NAME               bd_ctrl_stats_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE000003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_STATS
+#include "fhashtable_template.h"
+
+// the offsets are the distances without FHASHTABLE_FINGERPRINT:
+#define max_offset_of(ht_p)                                                          \
+    __extension__({                                                                  \
+        uint32_t res = 0;                                                            \
+        for (size_t i = 0; i < (ht_p)->capacity; i++) {                              \
+            if ((ht_p)->slots[i].offset != FHASHTABLE_EMPTY_SLOT_OFFSET) {           \
+                res = (ht_p)->slots[i].offset > res ? (ht_p)->slots[i].offset : res; \
+            }                                                                        \
+        }                                                                            \
+        res;                                                                         \
+    })
+
+void stats_test()
+{
+    // N = 16, counted by hand
+    {
+        struct tens_stats_ht *ht_p = tens_stats_ht_create(16);
+        assert(ht_p);
+
+        // the keys 0-9 have the ideal slot 0, and 10-19 the ideal slot 1:
+        tens_stats_ht_insert(ht_p, 0, 0);
+        tens_stats_ht_insert(ht_p, 1, 1);
+        tens_stats_ht_insert(ht_p, 2, 2);
+        tens_stats_ht_insert(ht_p, 10, 10);
+        tens_stats_ht_reset_stats(ht_p);
+
+        struct fhashtable_stats stats = tens_stats_ht_get_stats(ht_p);
+        assert(stats.n_lookups == 0 && stats.n_inserts == 0);
+        assert(stats.max_offset == 2);
+
+        // 3 displaces 10 at slot 3:
+        tens_stats_ht_update(ht_p, 3, 3);
+        stats = tens_stats_ht_get_stats(ht_p);
+        assert(stats.n_inserts == 1);
+        assert(stats.n_insert_swaps == 1);
+        assert(stats.max_offset == 3);
+        assert(stats.n_lookups == 1 && stats.n_lookup_probes == 4);
+
+        tens_stats_ht_reset_stats(ht_p);
+        assert(tens_stats_ht_get_value(ht_p, 2, -1) == 2);
+        assert(tens_stats_ht_get_value(ht_p, 10, -1) == 10);
+        assert(!tens_stats_ht_contains_key(ht_p, 90));
+        stats = tens_stats_ht_get_stats(ht_p);
+        assert(stats.n_lookups == 3);
+        assert(stats.n_lookup_probes == 3 + 4 + 1);
+        assert(stats.probe_length_histogram[0] == 1);
+        assert(stats.probe_length_histogram[2] == 1);
+        assert(stats.probe_length_histogram[3] == 1);
+
+        // 1, 2, 3 and 10 are moved back:
+        tens_stats_ht_reset_stats(ht_p);
+        assert(tens_stats_ht_delete(ht_p, 0));
+        stats = tens_stats_ht_get_stats(ht_p);
+        assert(stats.n_deletes == 1);
+        assert(stats.n_backshifts == 4);
+        assert(stats.max_offset == 3);
+        tens_stats_ht_reset_stats(ht_p);
+        assert(tens_stats_ht_get_stats(ht_p).max_offset == 2);
+
+        tens_stats_ht_clear(ht_p);
+        assert(tens_stats_ht_get_stats(ht_p).max_offset == 0);
+        tens_stats_ht_destroy(ht_p);
+    }
+    // N = 32, lookups longer than the histogram
+    {
+        struct tens_stats_ht *ht_p = tens_stats_ht_create(32);
+        assert(ht_p);
+
+        for (int i = 0; i < 20; i++) {
+            tens_stats_ht_insert(ht_p, i, i);
+        }
+        tens_stats_ht_reset_stats(ht_p);
+        assert(tens_stats_ht_get_stats(ht_p).max_offset == 18);
+        assert(tens_stats_ht_get_stats(ht_p).max_offset == max_offset_of(ht_p));
+
+        assert(!tens_stats_ht_contains_key(ht_p, 25));
+        const struct fhashtable_stats stats = tens_stats_ht_get_stats(ht_p);
+        assert(stats.n_lookup_probes == 19);
+        assert(stats.probe_length_histogram[FHASHTABLE_STATS_HISTOGRAM_SIZE - 1] == 1);
+
+        tens_stats_ht_destroy(ht_p);
+    }
+    // N = 16, 1e+3, 1e+5 at various loads
+    {
+        srand(42);
+        compare_with_default_layout(int_to_int_stats_ht, 16, 10000, 20);
+        compare_with_default_layout(int_to_int_stats_ht, 1000, 100000, 800);
+        compare_with_default_layout(int_to_int_stats_ht, 100000, 1000000, 200000);
+        compare_with_default_layout(bd_ctrl_stats_ht, 16, 10000, 64);
+        compare_with_default_layout(bd_ctrl_stats_ht, 1000, 100000, 2000);
+    }
+    // N = 1e+3, clustered hashes with control bytes, stopping at the largest offset
+    {
+        struct bd_ctrl_stats_ht *ht_p = bd_ctrl_stats_ht_create(1024);
+        assert(ht_p);
+
+        for (int i = 0; i < 768; i++) {
+            bd_ctrl_stats_ht_insert(ht_p, i, -i);
+        }
+        for (int i = 0; i < 768; i += 2) {
+            assert(bd_ctrl_stats_ht_delete(ht_p, i));
+        }
+        assert(bd_ctrl_stats_ht_get_stats(ht_p).max_offset >= max_offset_of(ht_p));
+        bd_ctrl_stats_ht_reset_stats(ht_p);
+        assert(bd_ctrl_stats_ht_get_stats(ht_p).max_offset == max_offset_of(ht_p));
+
+        for (int i = 0; i < 2048; i++) {
+            assert(bd_ctrl_stats_ht_get_value(ht_p, i, 1) == (i < 768 && i % 2 == 1 ? -i : 1));
+        }
+        const struct fhashtable_stats stats = bd_ctrl_stats_ht_get_stats(ht_p);
+        assert(stats.n_lookups == 2048);
+        assert(stats.n_lookup_probes >= stats.n_lookups);
+
+        bd_ctrl_stats_ht_destroy(ht_p);
+    }
+}
+
+// all keys have the last slot as ideal slot:
+#define NAME               last_slot_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) (UINT32_MAX)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define build_and_compare(ht_name, for_each, capacity, n)                                   \
+    __extension__({                                                                         \
+        struct ht_name *built_p = JOIN(ht_name, create)(capacity);                          \
+        struct ht_name *inserted_p = JOIN(ht_name, create)(capacity);                       \
+        int *keys = malloc(sizeof(int) * ((n) + 1));                                        \
+        int *values = malloc(sizeof(int) * ((n) + 1));                                      \
+        bool *is_taken = malloc(sizeof(bool) * (capacity));                                 \
+        assert(built_p && inserted_p && keys && values && is_taken);                        \
+                                                                                            \
+        /* distinct keys, as an odd factor is invertible modulo a power of two: */          \
+        for (int i = 0; i < (n); i++) {                                                     \
+            keys[i] = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(capacity) - 1U));     \
+            values[i] = -i;                                                                 \
+            JOIN(ht_name, insert)(inserted_p, keys[i], values[i]);                          \
+        }                                                                                   \
+        assert(JOIN(ht_name, build_from_arrays)(built_p, keys, values, (n)));               \
+        assert(built_p->count == inserted_p->count);                                        \
+                                                                                            \
+        /* the same slots are taken, but tied keys may be ordered differently: */           \
+        size_t index;                                                                       \
+        int key, value;                                                                     \
+        for (int i = 0; i < (capacity); i++) {                                              \
+            is_taken[i] = false;                                                            \
+        }                                                                                   \
+        for_each(inserted_p, index, key, value)                                             \
+        {                                                                                   \
+            is_taken[index] = true;                                                         \
+        }                                                                                   \
+        for_each(built_p, index, key, value)                                                \
+        {                                                                                   \
+            assert(is_taken[index]);                                                        \
+            assert(JOIN(ht_name, get_value)(inserted_p, key, 1) == value);                  \
+        }                                                                                   \
+        for (int i = 0; i < (n); i += 2) {                                                  \
+            assert(JOIN(ht_name, delete)(built_p, keys[i]));                                \
+        }                                                                                   \
+        for (int i = 0; i < (n); i++) {                                                     \
+            assert(JOIN(ht_name, get_value)(built_p, keys[i], 1) == (i % 2 == 1 ? -i : 1)); \
+        }                                                                                   \
+                                                                                            \
+        free(keys);                                                                         \
+        free(values);                                                                       \
+        free(is_taken);                                                                     \
+        JOIN(ht_name, destroy)(built_p);                                                    \
+        JOIN(ht_name, destroy)(inserted_p);                                                 \
+    })
+
+void build_test()
+{
+    // N = 0, 1, 16, 1e+3, 1e+5 at various loads
+    {
+        build_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1, 0);
+        build_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1, 1);
+        build_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 16, 16);
+        build_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1024, 700);
+        build_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1 << 17, 100000);
+
+        build_and_compare(bd_fp_ht, FHASHTABLE_FOR_EACH, 1024, 1024);
+        build_and_compare(int_to_int_ctrl_ht, FHASHTABLE_FOR_EACH, 1024, 700);
+        build_and_compare(bd_ctrl_ht, FHASHTABLE_FOR_EACH, 1024, 1000);
+        build_and_compare(int_to_int_fp_ht, FHASHTABLE_FOR_EACH, 1024, 700);
+        build_and_compare(int_to_int_fp_ctrl_ht, FHASHTABLE_FOR_EACH, 1024, 1024);
+        build_and_compare(int_to_int_soa_ht, FHASHTABLE_SOA_FOR_EACH, 1024, 700);
+        build_and_compare(bd_soa_ctrl_fp_ht, FHASHTABLE_SOA_FOR_EACH, 1024, 1000);
+        build_and_compare(int_to_int_large_ht, FHASHTABLE_FOR_EACH, 1024, 700);
+        build_and_compare(bd_large_soa_ctrl_fp_ht, FHASHTABLE_SOA_FOR_EACH, 1024, 1000);
+        build_and_compare(bd_ctrl_stats_ht, FHASHTABLE_FOR_EACH, 1024, 1000);
+    }
+    // N = 16, 1e+3, all keys wrapping around the end
+    {
+        build_and_compare(last_slot_ht, FHASHTABLE_FOR_EACH, 16, 16);
+        build_and_compare(last_slot_ht, FHASHTABLE_FOR_EACH, 1024, 1000);
+    }
+    // N = 16, failing allocation
+    {
+        struct int_to_int_ht *ht_p = int_to_int_ht_create(16);
+        assert(ht_p);
+
+        const int keys[] = {1, 2, 3};
+        const int values[] = {4, 5, 6};
+        assert(!int_to_int_ht_build_from_arrays_custom(ht_p, keys, values, 3, NULL, record_size_allocate, NULL));
+        assert(int_to_int_ht_is_empty(ht_p));
+        assert(int_to_int_ht_build_from_arrays(ht_p, keys, values, 3));
+        assert(int_to_int_ht_get_value(ht_p, 3, 0) == 6);
+
+        int_to_int_ht_destroy(ht_p);
+    }
+}
+
+#define NAME               int_to_int_par_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_PARALLEL
+#include "fhashtable_template.h"
+
+#define NAME               bd_soa_ctrl_fp_stats_par_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_STATS
+#define FHASHTABLE_PARALLEL
+#include "fhashtable_template.h"
+
+#define NAME               last_slot_large_par_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) (SIZE_MAX)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LARGE_CAPACITY
+#define FHASHTABLE_PARALLEL
+#include "fhashtable_template.h"
+
+struct range_sums {
+    const void *ht_p;
+    long long key_sums[FHASHTABLE_PARALLEL_MAX_THREADS];
+    size_t counts[FHASHTABLE_PARALLEL_MAX_THREADS];
+};
+
+#define define_sum_range(ht_name, for_each_range, size_type)                                                     \
+    static void JOIN(ht_name, sum_range)(void *context_ptr, size_t thread_index, size_type begin, size_type end) \
+    {                                                                                                            \
+        struct range_sums *sums_p = context_ptr;                                                                 \
+        const struct ht_name *ht_p = sums_p->ht_p;                                                               \
+        size_type index;                                                                                         \
+        int key, value;                                                                                          \
+        for_each_range(ht_p, index, begin, end, key, value)                                                      \
+        {                                                                                                        \
+            assert(value == -key);                                                                               \
+            sums_p->key_sums[thread_index] += key;                                                               \
+            sums_p->counts[thread_index]++;                                                                      \
+        }                                                                                                        \
+    }
+
+define_sum_range(int_to_int_par_ht, FHASHTABLE_FOR_EACH_RANGE, uint32_t)
+define_sum_range(bd_soa_ctrl_fp_stats_par_ht, FHASHTABLE_SOA_FOR_EACH_RANGE, uint32_t)
+define_sum_range(last_slot_large_par_ht, FHASHTABLE_FOR_EACH_RANGE, size_t)
+
+#define parallel_copy_and_compare(ht_name, src_capacity, dest_capacity, n, n_threads)                         \
+    __extension__({                                                                                           \
+        struct ht_name *src_p = JOIN(ht_name, create)(src_capacity);                                          \
+        struct ht_name *dest_p = JOIN(ht_name, create)(dest_capacity);                                        \
+        assert(src_p && dest_p);                                                                              \
+                                                                                                              \
+        long long key_sum = 0;                                                                                \
+        for (int i = 0; i < (n); i++) {                                                                       \
+            const int key = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U));             \
+            JOIN(ht_name, insert)(src_p, key, -key);                                                          \
+            key_sum += key;                                                                                   \
+        }                                                                                                     \
+                                                                                                              \
+        struct range_sums sums = {.ht_p = src_p};                                                             \
+        JOIN(ht_name, parallel_for_each_range)(src_p, (n_threads), JOIN(ht_name, sum_range), &sums);          \
+        long long summed = 0;                                                                                 \
+        size_t counted = 0;                                                                                   \
+        for (int t = 0; t < FHASHTABLE_PARALLEL_MAX_THREADS; t++) {                                           \
+            summed += sums.key_sums[t];                                                                       \
+            counted += sums.counts[t];                                                                        \
+        }                                                                                                     \
+        assert(summed == key_sum);                                                                            \
+        assert(counted == (size_t)(n));                                                                       \
+                                                                                                              \
+        JOIN(ht_name, parallel_copy)(dest_p, src_p, (n_threads));                                             \
+        assert(dest_p->count == src_p->count);                                                                \
+        for (int i = 0; i < (n); i++) {                                                                       \
+            const int key = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U));             \
+            assert(JOIN(ht_name, get_value)(dest_p, key, 1) == -key);                                         \
+        }                                                                                                     \
+        for (int i = 0; i < (n); i += 2) {                                                                    \
+            const int key = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U));             \
+            assert(JOIN(ht_name, delete)(dest_p, key));                                                       \
+        }                                                                                                     \
+        for (int i = 0; i < (n); i++) {                                                                       \
+            const int key = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U));             \
+            assert(JOIN(ht_name, get_value)(dest_p, key, 1) == (i % 2 == 1 ? -key : 1));                      \
+        }                                                                                                     \
+                                                                                                              \
+        JOIN(ht_name, parallel_clear)(dest_p, (n_threads));                                                   \
+        assert(JOIN(ht_name, is_empty)(dest_p));                                                              \
+        struct range_sums cleared_sums = {.ht_p = dest_p};                                                    \
+        JOIN(ht_name, parallel_for_each_range)(dest_p, (n_threads), JOIN(ht_name, sum_range), &cleared_sums); \
+        for (int t = 0; t < FHASHTABLE_PARALLEL_MAX_THREADS; t++) {                                           \
+            assert(cleared_sums.counts[t] == 0);                                                              \
+        }                                                                                                     \
+        JOIN(ht_name, parallel_copy)(dest_p, src_p, (n_threads));                                             \
+        assert(dest_p->count == src_p->count);                                                                \
+                                                                                                              \
+        JOIN(ht_name, destroy)(src_p);                                                                        \
+        JOIN(ht_name, destroy)(dest_p);                                                                       \
+    })
+
+void parallel_test()
+{
+    const size_t thread_counts[] = {1, 3, 8, 2 * FHASHTABLE_PARALLEL_MAX_THREADS};
+
+    for (size_t c = 0; c < sizeof(thread_counts) / sizeof(thread_counts[0]); c++) {
+        const size_t n_threads = thread_counts[c];
+
+        // N = 0, 1, 16, 1e+3, 1e+5 at various loads, to the same and larger capacities
+        parallel_copy_and_compare(int_to_int_par_ht, 1, 1, 0, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 1, 4, 1, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 16, 16, 16, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 1024, 1024, 1000, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 1024, 2048, 1024, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 1 << 17, 1 << 18, 100000, n_threads);
+        parallel_copy_and_compare(int_to_int_par_ht, 1 << 17, 1 << 20, 100000, n_threads);
+
+        // long clusters crossing the ranges:
+        parallel_copy_and_compare(bd_soa_ctrl_fp_stats_par_ht, 1024, 1024, 1000, n_threads);
+        parallel_copy_and_compare(bd_soa_ctrl_fp_stats_par_ht, 1024, 4096, 1024, n_threads);
+        parallel_copy_and_compare(bd_soa_ctrl_fp_stats_par_ht, 1 << 14, 1 << 15, 10000, n_threads);
+
+        // all keys wrapping around the end:
+        parallel_copy_and_compare(last_slot_large_par_ht, 16, 16, 16, n_threads);
+        parallel_copy_and_compare(last_slot_large_par_ht, 256, 1024, 200, n_threads);
+    }
+    // parallel_init matches init
+    {
+        struct bd_soa_ctrl_fp_stats_par_ht *ht_p = bd_soa_ctrl_fp_stats_par_ht_create(1024);
+        assert(ht_p);
+
+        for (int i = 0; i < 1000; i++) {
+            bd_soa_ctrl_fp_stats_par_ht_insert(ht_p, i, -i);
+        }
+        assert(bd_soa_ctrl_fp_stats_par_ht_parallel_init(ht_p, 1024, 8) == ht_p);
+        assert(bd_soa_ctrl_fp_stats_par_ht_is_empty(ht_p));
+        assert(bd_soa_ctrl_fp_stats_par_ht_get_stats(ht_p).n_inserts == 0);
+        for (int i = 0; i < 1000; i++) {
+            assert(!bd_soa_ctrl_fp_stats_par_ht_contains_key(ht_p, i));
+            bd_soa_ctrl_fp_stats_par_ht_insert(ht_p, i, -i);
+        }
+        assert(bd_soa_ctrl_fp_stats_par_ht_get_value(ht_p, 999, 1) == -999);
+
+        bd_soa_ctrl_fp_stats_par_ht_destroy(ht_p);
+    }
+}
+
+#define NAME               int_to_int_bitmap_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_PERSIST
+#include "fhashtable_template.h"
+
+#define NAME               bd_soa_ctrl_fp_bitmap_par_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_OCCUPANCY_BITMAP
+#define FHASHTABLE_PARALLEL
+#include "fhashtable_template.h"
+
+define_sum_range(bd_soa_ctrl_fp_bitmap_par_ht, FHASHTABLE_SOA_FOR_EACH_RANGE, uint32_t)
+
+#define mutate_and_compare(ht_name, bitmap_for_each, for_each, min_capacity, n_ops, key_range)        \
+    __extension__({                                                                                   \
+        struct ht_name *ht_p = JOIN(ht_name, create)(min_capacity);                                   \
+        struct int_to_int_ht *ref_ht_p = int_to_int_ht_create(min_capacity);                          \
+        assert(ht_p && ref_ht_p);                                                                     \
+                                                                                                      \
+        for (int i = 0; i < (n_ops); i++) {                                                           \
+            const int key = rand() % (key_range);                                                     \
+            if (rand() % 3 == 0) {                                                                    \
+                assert(JOIN(ht_name, delete)(ht_p, key) == int_to_int_ht_delete(ref_ht_p, key));      \
+            }                                                                                         \
+            else if (!JOIN(ht_name, is_full)(ht_p) || JOIN(ht_name, contains_key)(ht_p, key)) {       \
+                JOIN(ht_name, update)(ht_p, key, i);                                                  \
+                int_to_int_ht_update(ref_ht_p, key, i);                                               \
+            }                                                                                         \
+        }                                                                                             \
+                                                                                                      \
+        /* the bitmap matches the slot offsets: */                                                    \
+        uint32_t index, n_visited = 0, n_slots = 0;                                                   \
+        int key, value;                                                                               \
+        bitmap_for_each(ht_p, index, key, value)                                                      \
+        {                                                                                             \
+            assert(int_to_int_ht_get_value(ref_ht_p, key, -1) == value);                              \
+            n_visited++;                                                                              \
+        }                                                                                             \
+        for_each(ht_p, index, key, value)                                                             \
+        {                                                                                             \
+            n_slots++;                                                                                \
+        }                                                                                             \
+        assert(n_visited == ht_p->count && n_slots == ht_p->count && ht_p->count == ref_ht_p->count); \
+                                                                                                      \
+        JOIN(ht_name, clear)(ht_p);                                                                   \
+        assert(JOIN(ht_name, is_empty)(ht_p));                                                        \
+        for_each(ht_p, index, key, value)                                                             \
+        {                                                                                             \
+            assert(false);                                                                            \
+        }                                                                                             \
+        for (uint32_t w = 0; w < OCCUPANCY_BITMAP_N_WORDS(ht_p->capacity); w++) {                     \
+            assert(ht_p->occupied[w] == 0);                                                           \
+        }                                                                                             \
+        for (int k = 0; k < (key_range); k++) {                                                       \
+            assert(!JOIN(ht_name, contains_key)(ht_p, k));                                            \
+        }                                                                                             \
+        JOIN(ht_name, insert)(ht_p, 7, 8);                                                            \
+        assert(JOIN(ht_name, get_value)(ht_p, 7, 0) == 8);                                            \
+                                                                                                      \
+        JOIN(ht_name, destroy)(ht_p);                                                                 \
+        int_to_int_ht_destroy(ref_ht_p);                                                              \
+    })
+
+void occupancy_bitmap_test()
+{
+    srand(42);
+
+    // N = 1, 16, 1e+3, 1e+5 at various loads, sparse
+    {
+        mutate_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, FHASHTABLE_FOR_EACH, 1, 10, 2);
+        mutate_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, FHASHTABLE_FOR_EACH, 16, 100, 20);
+        mutate_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, FHASHTABLE_FOR_EACH, 1024, 5000, 1500);
+        mutate_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, FHASHTABLE_FOR_EACH, 1 << 17, 200,
+                           1 << 20);
+        mutate_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, FHASHTABLE_SOA_BITMAP_FOR_EACH, FHASHTABLE_SOA_FOR_EACH, 16,
+                           100, 20);
+        mutate_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, FHASHTABLE_SOA_BITMAP_FOR_EACH, FHASHTABLE_SOA_FOR_EACH, 1024,
+                           5000, 1500);
+    }
+    // copy to a larger capacity
+    {
+        struct int_to_int_bitmap_ht *src_p = int_to_int_bitmap_ht_create(256);
+        struct int_to_int_bitmap_ht *dest_p = int_to_int_bitmap_ht_create(1024);
+        assert(src_p && dest_p);
+
+        for (int i = 0; i < 200; i++) {
+            int_to_int_bitmap_ht_insert(src_p, i, -i);
+        }
+        int_to_int_bitmap_ht_copy(dest_p, src_p);
+        assert(dest_p->count == 200);
+        for (int i = 0; i < 200; i++) {
+            assert(int_to_int_bitmap_ht_get_value(dest_p, i, 1) == -i);
+        }
+
+        int_to_int_bitmap_ht_destroy(src_p);
+        int_to_int_bitmap_ht_destroy(dest_p);
+    }
+    // build_from_arrays and the parallel operations
+    {
+        build_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, 1024, 700);
+        build_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, FHASHTABLE_SOA_BITMAP_FOR_EACH, 1024, 1000);
+
+        parallel_copy_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, 16, 16, 16, 8);
+        parallel_copy_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, 1024, 1024, 1000, 8);
+        parallel_copy_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, 1024, 4096, 1024, 8);
+        parallel_copy_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, 1 << 14, 1 << 15, 10000, 3);
+
+        struct bd_soa_ctrl_fp_bitmap_par_ht *ht_p = bd_soa_ctrl_fp_bitmap_par_ht_create(1024);
+        assert(ht_p);
+        for (int i = 0; i < 1000; i++) {
+            bd_soa_ctrl_fp_bitmap_par_ht_insert(ht_p, i, -i);
+        }
+        assert(bd_soa_ctrl_fp_bitmap_par_ht_parallel_init(ht_p, 1024, 8) == ht_p);
+        uint32_t index;
+        int key, value;
+        FHASHTABLE_SOA_BITMAP_FOR_EACH(ht_p, index, key, value)
+        {
+            (void)key;
+            (void)value;
+            assert(false);
+        }
+        for (int i = 0; i < 1000; i++) {
+            assert(!bd_soa_ctrl_fp_bitmap_par_ht_contains_key(ht_p, i));
+        }
+        bd_soa_ctrl_fp_bitmap_par_ht_destroy(ht_p);
+    }
+    // save and map
+    {
+        char path[] = "/tmp/fhashtable_test_XXXXXX";
+        save_map_and_compare(int_to_int_bitmap_ht, 1000, 2000, path);
+
+        struct int_to_int_bitmap_ht *ht_p = int_to_int_bitmap_ht_map_from_file(path, false);
+        assert(ht_p);
+        assert(int_to_int_persist_ht_map_from_file(path, false) == NULL);
+
+        uint32_t index, count = 0;
+        int key, value;
+        FHASHTABLE_BITMAP_FOR_EACH(ht_p, index, key, value)
+        {
+            assert(int_to_int_bitmap_ht_get_value(ht_p, key, -1) == value);
+            count++;
+        }
+        assert(count == ht_p->count);
+
+        int_to_int_bitmap_ht_unmap(ht_p);
+        unlink(path);
+    }
+}
+
+#define copy_grow_and_compare(ht_name, for_each, src_capacity, dest_capacity, n)                \
+    __extension__({                                                                             \
+        struct ht_name *src_p = JOIN(ht_name, create)(src_capacity);                            \
+        struct ht_name *dest_p = JOIN(ht_name, create)(dest_capacity);                          \
+        struct ht_name *inserted_p = JOIN(ht_name, create)(dest_capacity);                      \
+        bool *is_taken = malloc(sizeof(bool) * (dest_capacity));                                \
+        assert(src_p && dest_p && inserted_p && is_taken);                                      \
+                                                                                                \
+        /* every fifth key is deleted from the source again: */                                 \
+        for (int i = 0; i < (n); i++) {                                                         \
+            const int k = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U)); \
+            JOIN(ht_name, insert)(src_p, k, -i);                                                \
+        }                                                                                       \
+        for (int i = 0; i < (n); i++) {                                                         \
+            const int k = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U)); \
+            if (i % 5 == 0) {                                                                   \
+                assert(JOIN(ht_name, delete)(src_p, k));                                        \
+            }                                                                                   \
+            else {                                                                              \
+                JOIN(ht_name, insert)(inserted_p, k, -i);                                       \
+            }                                                                                   \
+        }                                                                                       \
+        JOIN(ht_name, copy)(dest_p, src_p);                                                     \
+        assert(dest_p->count == src_p->count);                                                  \
+                                                                                                \
+        /* the same slots are taken, but tied keys may be ordered differently: */               \
+        size_t index;                                                                           \
+        int key, value;                                                                         \
+        for (size_t i = 0; i < (dest_capacity); i++) {                                          \
+            is_taken[i] = false;                                                                \
+        }                                                                                       \
+        for_each(inserted_p, index, key, value)                                                 \
+        {                                                                                       \
+            is_taken[index] = true;                                                             \
+        }                                                                                       \
+        for_each(dest_p, index, key, value)                                                     \
+        {                                                                                       \
+            assert(is_taken[index]);                                                            \
+            assert(JOIN(ht_name, get_value)(inserted_p, key, 1) == value);                      \
+        }                                                                                       \
+        for (int i = 0; i < (n); i++) {                                                         \
+            const int k = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U)); \
+            assert(JOIN(ht_name, get_value)(dest_p, k, 1) == (i % 5 == 0 ? 1 : -i));            \
+            if (i % 2 == 0) {                                                                   \
+                assert(JOIN(ht_name, delete)(dest_p, k) == (i % 5 != 0));                       \
+            }                                                                                   \
+        }                                                                                       \
+        for (int i = 0; i < (n); i++) {                                                         \
+            const int k = (int)(((unsigned)i * 40503U) & (8U * (unsigned)(src_capacity) - 1U)); \
+            assert(JOIN(ht_name, contains_key)(dest_p, k) == (i % 2 == 1 && i % 5 != 0));       \
+        }                                                                                       \
+                                                                                                \
+        free(is_taken);                                                                         \
+        JOIN(ht_name, destroy)(src_p);                                                          \
+        JOIN(ht_name, destroy)(dest_p);                                                         \
+        JOIN(ht_name, destroy)(inserted_p);                                                     \
+    })
+
+void copy_test()
+{
+    // N = 1, 16, 1e+3 to the same, twice and four times the capacity
+    {
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1, 1, 1);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1, 2, 1);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 16, 16, 16);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 16, 32, 16);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1024, 1024, 1000);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1024, 2048, 1000);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1024, 2048, 1024);
+        copy_grow_and_compare(int_to_int_ht, FHASHTABLE_FOR_EACH, 1024, 4096, 1000);
+    }
+    // clustered hashes, keys wrapping around the end of the slots
+    {
+        copy_grow_and_compare(tens_stats_ht, FHASHTABLE_FOR_EACH, 64, 128, 64);
+        copy_grow_and_compare(last_slot_ht, FHASHTABLE_FOR_EACH, 16, 32, 16);
+        copy_grow_and_compare(last_slot_ht, FHASHTABLE_FOR_EACH, 256, 512, 200);
+        copy_grow_and_compare(bd_ctrl_ht, FHASHTABLE_FOR_EACH, 1024, 2048, 1024);
+        copy_grow_and_compare(bd_fp_ht, FHASHTABLE_FOR_EACH, 1024, 1024, 1024);
+        copy_grow_and_compare(bd_fp_ht, FHASHTABLE_FOR_EACH, 1024, 2048, 1024);
+    }
+    // other layouts, the stored hashes are reused from 65536 slots on
+    {
+        copy_grow_and_compare(int_to_int_fp_ctrl_ht, FHASHTABLE_FOR_EACH, 1 << 16, 1 << 17, 60000);
+        copy_grow_and_compare(int_to_int_soa_ht, FHASHTABLE_SOA_FOR_EACH, 1024, 2048, 1000);
+        copy_grow_and_compare(bd_soa_ctrl_fp_ht, FHASHTABLE_SOA_FOR_EACH, 1024, 1024, 1000);
+        copy_grow_and_compare(bd_soa_ctrl_fp_ht, FHASHTABLE_SOA_FOR_EACH, 1 << 16, 1 << 17, 2000);
+        copy_grow_and_compare(int_to_int_large_ht, FHASHTABLE_FOR_EACH, 1024, 2048, 1000);
+        copy_grow_and_compare(bd_large_soa_ctrl_fp_ht, FHASHTABLE_SOA_FOR_EACH, 1 << 16, 1 << 17, 2000);
+        copy_grow_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, 1024, 1024, 1000);
+        copy_grow_and_compare(int_to_int_bitmap_ht, FHASHTABLE_BITMAP_FOR_EACH, 1024, 2048, 1000);
+        copy_grow_and_compare(bd_soa_ctrl_fp_bitmap_par_ht, FHASHTABLE_SOA_BITMAP_FOR_EACH, 1024, 2048, 1024);
+    }
+    // FHASHTABLE_STATS: the copied keys count as inserts
+    {
+        struct int_to_int_stats_ht *src_p = int_to_int_stats_ht_create(1024);
+        struct int_to_int_stats_ht *same_p = int_to_int_stats_ht_create(1024);
+        struct int_to_int_stats_ht *doubled_p = int_to_int_stats_ht_create(2048);
+        assert(src_p && same_p && doubled_p);
+
+        for (int i = 0; i < 1000; i++) {
+            int_to_int_stats_ht_insert(src_p, i, i);
+        }
+        int_to_int_stats_ht_copy(same_p, src_p);
+        int_to_int_stats_ht_copy(doubled_p, src_p);
+
+        const struct fhashtable_stats same_stats = int_to_int_stats_ht_get_stats(same_p);
+        const struct fhashtable_stats doubled_stats = int_to_int_stats_ht_get_stats(doubled_p);
+        assert(same_stats.n_inserts == 1000 && doubled_stats.n_inserts == 1000);
+        assert(same_stats.max_offset == max_offset_of(src_p));
+        assert(doubled_stats.max_offset == max_offset_of(doubled_p));
+        assert(doubled_stats.max_offset <= same_stats.max_offset);
+
+        int_to_int_stats_ht_destroy(src_p);
+        int_to_int_stats_ht_destroy(same_p);
+        int_to_int_stats_ht_destroy(doubled_p);
+    }
+}
+
+#define NAME               int_to_int_multi_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) / 4 * 7 + 13)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_MULTIMAP
+#include "fhashtable_template.h"
+
+#define NAME               bd_soa_ctrl_fp_multi_par_ht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) & 0xFE010003U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_LAYOUT_SOA
+#define FHASHTABLE_FINGERPRINT
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_PARALLEL
+#define FHASHTABLE_MULTIMAP
+#include "fhashtable_template.h"
+
+// the key of each value inserted, or -1 once it's deleted, and the number of values per key:
+static int multi_value_keys[20000];
+static bool multi_value_seen[20000];
+static uint32_t multi_key_counts[2000];
+
+#define multimap_compare(ht_name, equal_range_for_each, ht_p, n_values, key_range)        \
+    __extension__({                                                                       \
+        uint32_t total = 0;                                                               \
+        for (int v = 0; v < (n_values); v++) {                                            \
+            multi_value_seen[v] = false;                                                  \
+        }                                                                                 \
+        for (int k = 0; k < (key_range); k++) {                                           \
+            uint32_t first_index = 0, r;                                                  \
+            int value;                                                                    \
+            const uint32_t n = JOIN(ht_name, equal_range)((ht_p), k, &first_index);       \
+            assert(n == multi_key_counts[k] && JOIN(ht_name, count_key)((ht_p), k) == n); \
+            assert(JOIN(ht_name, contains_key)((ht_p), k) == (n > 0));                    \
+            equal_range_for_each((ht_p), r, first_index, n, value)                        \
+            {                                                                             \
+                assert(value >= 0 && value < (n_values));                                 \
+                assert(multi_value_keys[value] == k && !multi_value_seen[value]);         \
+                multi_value_seen[value] = true;                                           \
+            }                                                                             \
+            total += n;                                                                   \
+        }                                                                                 \
+        assert(total == (ht_p)->count);                                                   \
+    })
+
+#define multimap_mutate_and_compare(ht_name, equal_range_for_each, ht_p, n_ops, key_range)       \
+    __extension__({                                                                              \
+        for (int k = 0; k < (key_range); k++) {                                                  \
+            multi_key_counts[k] = 0;                                                             \
+        }                                                                                        \
+                                                                                                 \
+        for (int i = 0; i < (n_ops); i++) {                                                      \
+            const int key = rand() % (key_range);                                                \
+            multi_value_keys[i] = -1;                                                            \
+            switch (rand() % 8) {                                                                \
+            case 0: {                                                                            \
+                /* the first value of the key is deleted: */                                     \
+                const int value = JOIN(ht_name, get_value)(ht_p, key, -1);                       \
+                assert(JOIN(ht_name, delete)(ht_p, key) == (value != -1));                       \
+                if (value != -1) {                                                               \
+                    multi_value_keys[value] = -1;                                                \
+                    multi_key_counts[key]--;                                                     \
+                }                                                                                \
+            } break;                                                                             \
+            case 1: {                                                                            \
+                uint32_t first_index = 0, j;                                                     \
+                int value;                                                                       \
+                const uint32_t n = JOIN(ht_name, equal_range)(ht_p, key, &first_index);          \
+                equal_range_for_each(ht_p, j, first_index, n, value)                             \
+                {                                                                                \
+                    multi_value_keys[value] = -1;                                                \
+                }                                                                                \
+                assert(JOIN(ht_name, delete_all)(ht_p, key) == n && n == multi_key_counts[key]); \
+                assert(!JOIN(ht_name, contains_key)(ht_p, key));                                 \
+                multi_key_counts[key] = 0;                                                       \
+            } break;                                                                             \
+            case 2: {                                                                            \
+                /* the first value of the key is replaced: */                                    \
+                const int value = JOIN(ht_name, get_value)(ht_p, key, -1);                       \
+                if (value != -1) {                                                               \
+                    multi_value_keys[value] = -1;                                                \
+                }                                                                                \
+                else if (JOIN(ht_name, is_full)(ht_p)) {                                         \
+                    break;                                                                       \
+                }                                                                                \
+                else {                                                                           \
+                    multi_key_counts[key]++;                                                     \
+                }                                                                                \
+                JOIN(ht_name, update)(ht_p, key, i);                                             \
+                multi_value_keys[i] = key;                                                       \
+            } break;                                                                             \
+            default:                                                                             \
+                if (!JOIN(ht_name, is_full)(ht_p)) {                                             \
+                    JOIN(ht_name, insert_multi)(ht_p, key, i);                                   \
+                    multi_value_keys[i] = key;                                                   \
+                    multi_key_counts[key]++;                                                     \
+                }                                                                                \
+            }                                                                                    \
+            if (i % ((n_ops) / 16 + 1) == 0) {                                                   \
+                multimap_compare(ht_name, equal_range_for_each, ht_p, i + 1, key_range);         \
+            }                                                                                    \
+        }                                                                                        \
+        multimap_compare(ht_name, equal_range_for_each, ht_p, n_ops, key_range);                 \
+                                                                                                 \
+        /* the copies keep the values of a key together: */                                      \
+        for (uint32_t factor = 1; factor <= 4; factor *= 2) {                                    \
+            struct ht_name *dest_p = JOIN(ht_name, create)(ht_p->capacity * factor);             \
+            assert(dest_p);                                                                      \
+            JOIN(ht_name, copy)(dest_p, ht_p);                                                   \
+            multimap_compare(ht_name, equal_range_for_each, dest_p, n_ops, key_range);           \
+            JOIN(ht_name, destroy)(dest_p);                                                      \
+        }                                                                                        \
+    })
+
+void multimap_test()
+{
+    srand(7);
+
+    // N = 1, 16, 1e+3, 1e+4 with a few keys per ideal slot
+    {
+        const uint32_t capacities[4] = {1, 16, 1024, 8192};
+        const int n_ops[4] = {50, 1000, 5000, 20000};
+        const int key_ranges[4] = {2, 20, 300, 2000};
+
+        for (int t = 0; t < 4; t++) {
+            struct int_to_int_multi_ht *ht_p = int_to_int_multi_ht_create(capacities[t]);
+            assert(ht_p);
+            multimap_mutate_and_compare(int_to_int_multi_ht, FHASHTABLE_EQUAL_RANGE_FOR_EACH, ht_p, n_ops[t],
+                                        key_ranges[t]);
+            int_to_int_multi_ht_destroy(ht_p);
+        }
+    }
+    // other layouts, large clusters
+    {
+        struct bd_soa_ctrl_fp_multi_par_ht *ht_p = bd_soa_ctrl_fp_multi_par_ht_create(16);
+        assert(ht_p);
+        multimap_mutate_and_compare(bd_soa_ctrl_fp_multi_par_ht, FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH, ht_p, 1000, 40);
+        bd_soa_ctrl_fp_multi_par_ht_destroy(ht_p);
+
+        ht_p = bd_soa_ctrl_fp_multi_par_ht_create(1024);
+        assert(ht_p);
+        multimap_mutate_and_compare(bd_soa_ctrl_fp_multi_par_ht, FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH, ht_p, 8000, 1500);
+
+        // parallel_copy, with clusters crossing the ranges:
+        for (uint32_t factor = 1; factor <= 4; factor *= 2) {
+            struct bd_soa_ctrl_fp_multi_par_ht *dest_p = bd_soa_ctrl_fp_multi_par_ht_create(ht_p->capacity * factor);
+            assert(dest_p);
+            bd_soa_ctrl_fp_multi_par_ht_parallel_copy(dest_p, ht_p, 8);
+            multimap_compare(bd_soa_ctrl_fp_multi_par_ht, FHASHTABLE_SOA_EQUAL_RANGE_FOR_EACH, dest_p, 8000, 1500);
+            bd_soa_ctrl_fp_multi_par_ht_destroy(dest_p);
+        }
+        bd_soa_ctrl_fp_multi_par_ht_destroy(ht_p);
+    }
+    // a key stored in every slot, wrapping around the end of the slots
+    {
+        struct int_to_int_multi_ht *ht_p = int_to_int_multi_ht_create(16);
+        assert(ht_p);
+
+        for (int i = 0; i < 16; i++) {
+            int_to_int_multi_ht_insert_multi(ht_p, 28, i);
+        }
+        assert(int_to_int_multi_ht_is_full(ht_p) && int_to_int_multi_ht_count_key(ht_p, 28) == 16);
+        assert(int_to_int_multi_ht_count_key(ht_p, 29) == 0);
+
+        uint32_t first_index = 0, i;
+        int value, sum = 0;
+        assert(int_to_int_multi_ht_equal_range(ht_p, 28, &first_index) == 16 && first_index == 14);
+        FHASHTABLE_EQUAL_RANGE_FOR_EACH(ht_p, i, first_index, 16, value)
+        {
+            sum += value;
+        }
+        assert(sum == 15 * 16 / 2);
+
+        assert(int_to_int_multi_ht_delete(ht_p, 28) && int_to_int_multi_ht_count_key(ht_p, 28) == 15);
+        assert(int_to_int_multi_ht_delete_all(ht_p, 28) == 15 && int_to_int_multi_ht_is_empty(ht_p));
+        assert(int_to_int_multi_ht_delete_all(ht_p, 28) == 0);
+
+        int_to_int_multi_ht_destroy(ht_p);
+    }
+}
+
 int main(void)
 {
     int_int_full_test();
     bad_hash_func_test();
     struct_key_value_test();
+    control_bytes_test();
+    fingerprint_test();
+    batch_test();
+    entry_test();
+    soa_layout_test();
+    large_capacity_test();
+    persist_test();
+    stats_test();
+    build_test();
+    parallel_test();
+    occupancy_bitmap_test();
+    copy_test();
+    multimap_test();
 }
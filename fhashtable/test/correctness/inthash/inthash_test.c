@@ -0,0 +1,180 @@
+/*
+    Hash functions:
+    - inthash_fibonacci_32
+    - inthash_fmix32
+    - inthash_fmix64
+    - inthash_splitmix64
+    - inthash_moremur
+
+    Test cases:
+    - reference values (splitmix64 outputs, murmur3 / moremur finalizers)
+    - the lower bytes of the Fibonacci hash are the upper bytes of the product
+    - distinct (untruncated) hashes for N := 1e+5 sequential keys
+    - even spread over 1024 ideal slots and 128 control tags, for sequential
+      and strided keys
+
+    The hashes are also used as the hash functions of fhashtables, with
+    N := 1e+5 sequential keys at 75% load.
+*/
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "inthash.h"
+
+#define NAME               fib_ht
+#define KEY_TYPE           uint64_t
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) inthash_fibonacci_32(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_CONTROL_BYTES
+#define FHASHTABLE_STATS
+#include "fhashtable_template.h"
+
+#define NAME               moremur_ht
+#define KEY_TYPE           uint64_t
+#define VALUE_TYPE         uint64_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)inthash_moremur(key))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#define FHASHTABLE_STATS
+#include "fhashtable_template.h"
+
+#define N 100000
+
+static uint64_t hashes[N];
+
+static int compare_hashes(const void *a, const void *b)
+{
+    const uint64_t x = *(const uint64_t *)a;
+    const uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// every key is i * stride, and the ideal slots and control tags should each be hit about equally often:
+#define check_spread(hash_32, stride)                            \
+    do {                                                         \
+        static uint32_t slot_counts[1024];                       \
+        static uint32_t tag_counts[128];                         \
+        for (uint32_t j = 0; j < 1024; j++) {                    \
+            slot_counts[j] = 0;                                  \
+        }                                                        \
+        for (uint32_t j = 0; j < 128; j++) {                     \
+            tag_counts[j] = 0;                                   \
+        }                                                        \
+        for (uint64_t i = 0; i < 1024 * 64; i++) {               \
+            const uint32_t hash = hash_32(i * (stride));         \
+            slot_counts[hash & 1023]++;                          \
+            tag_counts[hash >> 25]++;                            \
+        }                                                        \
+        for (uint32_t j = 0; j < 1024; j++) {                    \
+            assert(slot_counts[j] > 16 && slot_counts[j] < 128); \
+        }                                                        \
+        for (uint32_t j = 0; j < 128; j++) {                     \
+            assert(tag_counts[j] > 256 && tag_counts[j] < 1024); \
+        }                                                        \
+    } while (0)
+
+#define check_distinct(hash)                                \
+    do {                                                    \
+        for (uint64_t i = 0; i < N; i++) {                  \
+            hashes[i] = hash(i);                            \
+        }                                                   \
+        qsort(hashes, N, sizeof(uint64_t), compare_hashes); \
+        for (uint32_t i = 1; i < N; i++) {                  \
+            assert(hashes[i - 1] != hashes[i]);             \
+        }                                                   \
+    } while (0)
+
+#define insert_and_compare(ht_name)                                \
+    do {                                                           \
+        struct ht_name *ht_p = JOIN(ht_name, create)(N + N / 3);   \
+        if (!ht_p) {                                               \
+            assert(false);                                         \
+        }                                                          \
+        for (uint64_t i = 0; i < N; i++) {                         \
+            JOIN(ht_name, insert)(ht_p, i, i + 1);                 \
+        }                                                          \
+        for (uint64_t i = 0; i < N; i++) {                         \
+            assert(JOIN(ht_name, get_value)(ht_p, i, 0) == i + 1); \
+        }                                                          \
+        assert(!JOIN(ht_name, contains_key)(ht_p, N));             \
+        /* no key is far from it's ideal slot: */                  \
+        assert(JOIN(ht_name, get_stats)(ht_p).max_offset < 64);    \
+        JOIN(ht_name, destroy)(ht_p);                              \
+    } while (0)
+
+static inline uint32_t fmix32_32(const uint64_t key)
+{
+    return inthash_fmix32((uint32_t)key);
+}
+
+static inline uint32_t fmix64_32(const uint64_t key)
+{
+    return (uint32_t)inthash_fmix64(key);
+}
+
+static inline uint32_t splitmix64_32(const uint64_t key)
+{
+    return (uint32_t)inthash_splitmix64(key);
+}
+
+static inline uint32_t moremur_32(const uint64_t key)
+{
+    return (uint32_t)inthash_moremur(key);
+}
+
+int main(void)
+{
+    // reference values:
+    {
+        assert(inthash_splitmix64(0) == UINT64_C(0xE220A8397B1DCDAF));
+        assert(inthash_splitmix64(INTHASH_GOLDEN_RATIO_64) == UINT64_C(0x6E789E6AA1B965F4));
+        assert(inthash_fmix64(0) == 0 && inthash_fmix64(1) == UINT64_C(0xB456BCFC34C2CB2C));
+        assert(inthash_moremur(0) == 0 && inthash_moremur(1) == UINT64_C(0x3C02AA47758292BD));
+        assert(inthash_fmix32(0) == 0 && inthash_fmix32(1) == UINT32_C(0x514E28B7));
+    }
+    // the lower bytes of the Fibonacci hash are the upper bytes of the product:
+    {
+        for (uint64_t key = 0; key < 1000; key++) {
+            const uint64_t product = (key * 12345 + 678) * INTHASH_GOLDEN_RATIO_64;
+            const uint32_t hash = inthash_fibonacci_32(key * 12345 + 678);
+            assert((hash & 0xFF) == product >> 56);
+            assert((hash & 0xFFFF) == (((product >> 56) & 0xFF) | ((product >> 40) & 0xFF00)));
+            assert(hash >> 24 == ((product >> 32) & 0xFF));
+        }
+    }
+    // distinct hashes for sequential keys
+    {
+        check_distinct(inthash_fibonacci_32);
+        check_distinct(fmix32_32);
+        check_distinct(inthash_fmix64);
+        check_distinct(inthash_splitmix64);
+        check_distinct(inthash_moremur);
+    }
+    // even spread for sequential and strided keys
+    {
+        check_spread(inthash_fibonacci_32, 1);
+        check_spread(inthash_fibonacci_32, 8);
+        check_spread(inthash_fibonacci_32, 4096);
+        check_spread(fmix32_32, 1);
+        check_spread(fmix32_32, 4096);
+        check_spread(fmix64_32, 1);
+        check_spread(fmix64_32, UINT64_C(1) << 32);
+        check_spread(splitmix64_32, 1);
+        check_spread(splitmix64_32, UINT64_C(1) << 32);
+        check_spread(moremur_32, 1);
+        check_spread(moremur_32, UINT64_C(1) << 32);
+    }
+    // used as hash functions of fhashtables
+    {
+        insert_and_compare(fib_ht);
+        insert_and_compare(moremur_ht);
+    }
+}
@@ -0,0 +1,210 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 1e+3
+    - N := 1e+5 (split over 8 threads)
+
+    Non-mutating operation types / properties:
+    - count
+    - is_full
+    - contains_key + get_value + LFHASHTABLE_FOR_EACH
+
+    Mutating operation types:
+    - insert
+    - update
+    - add
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Concurrent threads count the same keys with add, and race to insert the
+    same keys, where each key must be inserted by exactly one thread.
+*/
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               u64_counter
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(uint64_t))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "lfhashtable_template.h"
+
+// all keys with the same index, to test the probing:
+#define NAME               u64_collide_counter
+#define HASH_FUNCTION(key) ((uint32_t)(key) * 0U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "lfhashtable_template.h"
+
+void single_thread_test(void)
+{
+    // N = 0
+    {
+        struct u64_counter *ht_p = u64_counter_create(0);
+        if (ht_p) {
+            assert(false);
+        }
+    }
+    // N = 1
+    {
+        struct u64_counter *ht_p = u64_counter_create(1);
+        if (!ht_p) {
+            assert(false);
+        }
+        assert(u64_counter_count(ht_p) == 0);
+        assert(!u64_counter_is_full(ht_p));
+        assert(!u64_counter_contains_key(ht_p, 42));
+        assert(u64_counter_get_value(ht_p, 42, 7) == 7);
+
+        assert(u64_counter_insert(ht_p, 42, 69));
+        assert(!u64_counter_insert(ht_p, 42, 1));
+        assert(u64_counter_get_value(ht_p, 42, 7) == 69);
+        assert(u64_counter_is_full(ht_p));
+
+        assert(!u64_counter_insert(ht_p, 0, 1));
+        assert(!u64_counter_update(ht_p, 0, 1));
+        assert(!u64_counter_add(ht_p, 0, 1));
+        assert(!u64_counter_contains_key(ht_p, 0));
+
+        assert(u64_counter_add(ht_p, 42, 1));
+        assert(u64_counter_get_value(ht_p, 42, 7) == 70);
+        assert(u64_counter_update(ht_p, 42, 0));
+        assert(u64_counter_get_value(ht_p, 42, 7) == 0);
+        assert(u64_counter_count(ht_p) == 1);
+
+        u64_counter_clear(ht_p);
+        assert(u64_counter_count(ht_p) == 0);
+        assert(!u64_counter_contains_key(ht_p, 42));
+        assert(u64_counter_add(ht_p, 0, 5));
+        assert(u64_counter_get_value(ht_p, 0, 7) == 5);
+
+        u64_counter_destroy(ht_p);
+    }
+    // N = 1e+3
+    {
+        const uint64_t n = 1000;
+        struct u64_collide_counter *ht_p = u64_collide_counter_create((uint32_t)n);
+        if (!ht_p) {
+            assert(false);
+        }
+        for (uint64_t i = 0; i < n; i++) {
+            if (i % 2 == 0) {
+                assert(u64_collide_counter_insert(ht_p, i, i));
+            }
+            else {
+                assert(u64_collide_counter_add(ht_p, i, i));
+            }
+            assert(u64_collide_counter_add(ht_p, i, 1));
+        }
+        assert(u64_collide_counter_count(ht_p) == n);
+        for (uint64_t i = 0; i < 2 * n; i++) {
+            assert(u64_collide_counter_contains_key(ht_p, i) == (i < n));
+            assert(u64_collide_counter_get_value(ht_p, i, 0) == (i < n ? i + 1 : 0));
+        }
+
+        uint32_t index;
+        uint64_t key, value;
+        uint64_t count = 0;
+        LFHASHTABLE_FOR_EACH(ht_p, index, key, value)
+        {
+            assert(value == key + 1);
+            count++;
+        }
+        assert(count == n);
+
+        u64_collide_counter_destroy(ht_p);
+    }
+}
+
+#define N_THREADS     (8)
+#define N_KEYS        (12500)
+#define N_REPETITIONS (4)
+
+static void *count_worker(void *args_ptr)
+{
+    struct u64_counter *ht_p = args_ptr;
+
+    for (int repetition = 0; repetition < N_REPETITIONS; repetition++) {
+        for (uint64_t key = 0; key < N_KEYS; key++) {
+            assert(u64_counter_add(ht_p, key, 1));
+            assert(u64_counter_get_value(ht_p, key, 0) <= N_THREADS * N_REPETITIONS);
+        }
+    }
+    return NULL;
+}
+
+static void *dedup_worker(void *args_ptr)
+{
+    struct u64_counter *ht_p = args_ptr;
+
+    uint64_t n_inserted = 0;
+    for (uint64_t key = 0; key < N_KEYS; key++) {
+        n_inserted += u64_counter_insert(ht_p, key * N_KEYS, key);
+        assert(u64_counter_contains_key(ht_p, key * N_KEYS));
+    }
+    return (void *)(uintptr_t)n_inserted;
+}
+
+void concurrent_test(void)
+{
+    // N = 1e+5
+    struct u64_counter *ht_p = u64_counter_create(2 * N_KEYS);
+    if (!ht_p) {
+        assert(false);
+    }
+    pthread_t threads[N_THREADS];
+
+    for (int i = 0; i < N_THREADS; i++) {
+        if (pthread_create(&threads[i], NULL, count_worker, ht_p) != 0) {
+            assert(false);
+        }
+    }
+    for (int i = 0; i < N_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assert(u64_counter_count(ht_p) == N_KEYS);
+    for (uint64_t key = 0; key < N_KEYS; key++) {
+        assert(u64_counter_get_value(ht_p, key, 0) == N_THREADS * N_REPETITIONS);
+    }
+
+    u64_counter_clear(ht_p);
+
+    for (int i = 0; i < N_THREADS; i++) {
+        if (pthread_create(&threads[i], NULL, dedup_worker, ht_p) != 0) {
+            assert(false);
+        }
+    }
+    uint64_t n_inserted = 0;
+    for (int i = 0; i < N_THREADS; i++) {
+        void *res;
+        pthread_join(threads[i], &res);
+        n_inserted += (uintptr_t)res;
+    }
+    assert(n_inserted == N_KEYS);
+    assert(u64_counter_count(ht_p) == N_KEYS);
+    for (uint64_t key = 0; key < N_KEYS; key++) {
+        assert(u64_counter_get_value(ht_p, key * N_KEYS, N_KEYS) == key);
+    }
+
+    u64_counter_destroy(ht_p);
+}
+
+int main(void)
+{
+    single_thread_test();
+    concurrent_test();
+
+    printf("lfhashtable test succeeded.\n");
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+    Test cases (capacity C, number of operations N):
+    - C := 1, N := 1e+3
+    - C := 16, N := 1e+3
+    - C := 1e+3, N := 1e+5
+
+    Operations compared against an array of keys, from the most to the least
+    recently used:
+    - get (moves the key to the front)
+    - peek (keeps the order)
+    - put (moves the key to the front, and evicts the last key when full)
+    - delete
+    - contains_key + .count + is_empty + is_full
+    - LRU_CACHE_FOR_EACH
+
+    Evictions are recorded with the `on_evict` callback.
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - create_custom (with an allocator that fails after a limit)
+    - clear
+    - destroy
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_index_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         uint32_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME int_list
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "list_template.h"
+
+#define NAME       int_to_int_lru
+#define TABLE_NAME int_to_index_table
+#define LIST_NAME  int_list
+#define KEY_TYPE   int
+#define VALUE_TYPE int
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "lru_cache_template.h"
+
+struct limited_allocator {
+    size_t n_allocations_left;
+};
+
+static void *limited_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)alignment;
+    struct limited_allocator *allocator_ptr = context_ptr;
+    if (allocator_ptr->n_allocations_left == 0) {
+        return NULL;
+    }
+    allocator_ptr->n_allocations_left--;
+    return malloc(size);
+}
+
+static void limited_deallocate(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+
+struct eviction_record {
+    int n_evicted;
+    int last_key;
+    int last_value;
+};
+
+static void record_eviction(void *context_ptr, int key, int value)
+{
+    struct eviction_record *record_ptr = context_ptr;
+    record_ptr->n_evicted++;
+    record_ptr->last_key = key;
+    record_ptr->last_value = value;
+}
+
+// the keys from the most to the least recently used, and their values:
+struct model {
+    int count;
+    int keys[1000];
+    int values[1000];
+};
+
+static int model_find(const struct model *model_ptr, int key)
+{
+    for (int i = 0; i < model_ptr->count; i++) {
+        if (model_ptr->keys[i] == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void model_remove(struct model *model_ptr, int i)
+{
+    memmove(&model_ptr->keys[i], &model_ptr->keys[i + 1], (size_t)(model_ptr->count - i - 1) * sizeof(int));
+    memmove(&model_ptr->values[i], &model_ptr->values[i + 1], (size_t)(model_ptr->count - i - 1) * sizeof(int));
+    model_ptr->count--;
+}
+
+static void model_push_front(struct model *model_ptr, int key, int value)
+{
+    memmove(&model_ptr->keys[1], &model_ptr->keys[0], (size_t)model_ptr->count * sizeof(int));
+    memmove(&model_ptr->values[1], &model_ptr->values[0], (size_t)model_ptr->count * sizeof(int));
+    model_ptr->keys[0] = key;
+    model_ptr->values[0] = value;
+    model_ptr->count++;
+}
+
+static void operate_and_compare(const uint32_t capacity, const int n)
+{
+    static struct model model;
+    model.count = 0;
+
+    struct int_to_int_lru *cache_p = int_to_int_lru_create(capacity);
+    if (!cache_p) {
+        assert(false);
+    }
+    assert(int_to_int_lru_is_empty(cache_p));
+
+    struct eviction_record record = {0};
+    const int key_range = (int)capacity * 2;
+
+    srand(capacity);
+    for (int k = 0; k < n; k++) {
+        const int key = rand() % key_range;
+        const int i = model_find(&model, key);
+
+        switch (rand() % 4) {
+        case 0: {
+            int *value_p = int_to_int_lru_get(cache_p, key);
+            assert((value_p != NULL) == (i != -1));
+            if (value_p) {
+                assert(*value_p == model.values[i]);
+                const int value = model.values[i];
+                model_remove(&model, i);
+                model_push_front(&model, key, value);
+            }
+        } break;
+        case 1: {
+            const int *value_p = int_to_int_lru_peek(cache_p, key);
+            assert((value_p != NULL) == (i != -1));
+            assert(!value_p || *value_p == model.values[i]);
+        } break;
+        case 2: {
+            const int n_evicted = record.n_evicted;
+            const bool is_evicted = int_to_int_lru_put(cache_p, key, k, record_eviction, &record);
+            if (i != -1) {
+                model_remove(&model, i);
+            }
+            else if (model.count == (int)capacity) {
+                assert(record.last_key == model.keys[model.count - 1]);
+                assert(record.last_value == model.values[model.count - 1]);
+                model_remove(&model, model.count - 1);
+            }
+            assert(is_evicted == (record.n_evicted == n_evicted + 1));
+            assert(record.n_evicted - n_evicted <= 1);
+            model_push_front(&model, key, k);
+        } break;
+        case 3: {
+            assert(int_to_int_lru_delete(cache_p, key) == (i != -1));
+            if (i != -1) {
+                model_remove(&model, i);
+            }
+        } break;
+        }
+
+        assert(cache_p->count == (uint32_t)model.count);
+        assert(int_to_int_lru_is_full(cache_p) == (model.count == (int)capacity));
+        assert(int_to_int_lru_contains_key(cache_p, key) == (model_find(&model, key) != -1));
+    }
+
+    struct int_to_int_lru_entry *entry_p;
+    int count = 0;
+    LRU_CACHE_FOR_EACH(cache_p, entry_p)
+    {
+        assert(entry_p->key == model.keys[count] && entry_p->value == model.values[count]);
+        count++;
+    }
+    assert(count == model.count);
+
+    int_to_int_lru_clear(cache_p);
+    assert(int_to_int_lru_is_empty(cache_p));
+    for (int key = 0; key < key_range; key++) {
+        assert(!int_to_int_lru_contains_key(cache_p, key));
+    }
+    // the cleared cache can be filled again:
+    for (uint32_t key = 0; key < capacity; key++) {
+        assert(!int_to_int_lru_put(cache_p, (int)key, 0, NULL, NULL));
+    }
+    assert(int_to_int_lru_is_full(cache_p));
+
+    int_to_int_lru_destroy(cache_p);
+}
+
+int main(void)
+{
+    operate_and_compare(1, 1000);
+    operate_and_compare(16, 1000);
+    operate_and_compare(1000, 100000);
+
+    {
+        struct int_to_int_lru *cache_p = int_to_int_lru_create(3);
+        if (!cache_p) {
+            assert(false);
+        }
+        struct eviction_record record = {0};
+        int_to_int_lru_put(cache_p, 1, 10, record_eviction, &record);
+        int_to_int_lru_put(cache_p, 2, 20, record_eviction, &record);
+        int_to_int_lru_put(cache_p, 3, 30, record_eviction, &record);
+
+        // peeking does not save 1 from eviction, getting saves it:
+        assert(*int_to_int_lru_peek(cache_p, 1) == 10);
+        assert(int_to_int_lru_put(cache_p, 4, 40, record_eviction, &record));
+        assert(record.n_evicted == 1 && record.last_key == 1 && record.last_value == 10);
+
+        assert(*int_to_int_lru_get(cache_p, 2) == 20);
+        assert(int_to_int_lru_put(cache_p, 5, 50, record_eviction, &record));
+        assert(record.n_evicted == 2 && record.last_key == 3 && record.last_value == 30);
+
+        // putting a contained key replaces it's value without evicting:
+        assert(!int_to_int_lru_put(cache_p, 2, 21, record_eviction, &record));
+        assert(record.n_evicted == 2 && *int_to_int_lru_peek(cache_p, 2) == 21);
+
+        int_to_int_lru_destroy(cache_p);
+    }
+
+    assert(int_to_int_lru_create(0) == NULL);
+    {
+        struct limited_allocator allocator = {.n_allocations_left = 0};
+        assert(int_to_int_lru_create_custom(16, &allocator, limited_allocate, limited_deallocate) == NULL);
+
+        // the table can not be allocated:
+        allocator.n_allocations_left = 1;
+        assert(int_to_int_lru_create_custom(16, &allocator, limited_allocate, limited_deallocate) == NULL);
+
+        allocator.n_allocations_left = 2;
+        struct int_to_int_lru *cache_p =
+            int_to_int_lru_create_custom(16, &allocator, limited_allocate, limited_deallocate);
+        if (!cache_p) {
+            assert(false);
+        }
+        // no allocations on the hot path:
+        for (int i = 0; i < 1000; i++) {
+            int_to_int_lru_put(cache_p, i, i, NULL, NULL);
+        }
+        assert(allocator.n_allocations_left == 0);
+        int_to_int_lru_destroy(cache_p);
+    }
+}
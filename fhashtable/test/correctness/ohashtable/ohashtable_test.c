@@ -0,0 +1,198 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 16
+    - N := 1e+3
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - is_empty + is_full
+    - contains_key + get_value + OHASHTABLE_FOR_EACH (in insertion order)
+
+    Mutating operation types:
+    - insert (also into a full range of entries with deleted entries)
+    - update (keeps the place in the insertion order)
+    - get_value_mut
+    - delete
+    - clear
+    - copy (to a smaller, the same and a larger capacity)
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Index widths:
+    - 8 bits (N <= 128)
+    - 16 bits (N <= 32768)
+    - 32 bits
+
+    Hashtables:
+    - default hash
+    - all keys with the same hash
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_int_oht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "ohashtable_template.h"
+
+// all keys have the same hash:
+#define NAME               int_to_int_collide_oht
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) * 0U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "ohashtable_template.h"
+
+// the keys are 3 * i with the value i, and keys with an even i are deleted, so the odd i's are left in order:
+#define insert_delete_and_compare(OHT, n)                                                          \
+    do {                                                                                           \
+        struct OHT *ht_p = JOIN(OHT, create)((n) + 1);                                             \
+        if (!ht_p) {                                                                               \
+            assert(false);                                                                         \
+        }                                                                                          \
+        assert(ht_p->index_width == OHASHTABLE_INDEX_WIDTH(ht_p->capacity));                       \
+        assert(JOIN(OHT, is_empty)(ht_p));                                                         \
+        for (int i = 0; i < (n); i++) {                                                            \
+            JOIN(OHT, insert)(ht_p, 3 * i, i);                                                     \
+        }                                                                                          \
+        assert(ht_p->count == (uint32_t)(n));                                                      \
+        for (int i = 0; i < 3 * (n) + 3; i++) {                                                    \
+            const bool expected = i % 3 == 0 && i < 3 * (n);                                       \
+            assert(JOIN(OHT, contains_key)(ht_p, i) == expected);                                  \
+            assert(JOIN(OHT, get_value)(ht_p, i, -1) == (expected ? i / 3 : -1));                  \
+        }                                                                                          \
+                                                                                                   \
+        uint32_t index;                                                                            \
+        int key, value;                                                                            \
+        int count = 0;                                                                             \
+        OHASHTABLE_FOR_EACH(ht_p, index, key, value)                                               \
+        {                                                                                          \
+            assert(key == 3 * count && value == count);                                            \
+            count++;                                                                               \
+        }                                                                                          \
+        assert(count == (n));                                                                      \
+                                                                                                   \
+        for (int i = 0; i < (n); i += 2) {                                                         \
+            assert(JOIN(OHT, delete)(ht_p, 3 * i));                                                \
+            assert(!JOIN(OHT, delete)(ht_p, 3 * i));                                               \
+        }                                                                                          \
+        assert(!JOIN(OHT, delete)(ht_p, 1));                                                       \
+        assert(ht_p->count == (uint32_t)((n) / 2));                                                \
+        for (int i = 0; i < (n); i++) {                                                            \
+            assert(JOIN(OHT, contains_key)(ht_p, 3 * i) == (i % 2 == 1));                          \
+        }                                                                                          \
+                                                                                                   \
+        /* updating keeps the order, and the value can be changed in place: */                     \
+        for (int i = 1; i < (n); i += 2) {                                                         \
+            JOIN(OHT, update)(ht_p, 3 * i, -i);                                                    \
+            int *value_p = JOIN(OHT, get_value_mut)(ht_p, 3 * i);                                  \
+            if (!value_p) {                                                                        \
+                assert(false);                                                                     \
+            }                                                                                      \
+            *value_p -= 1;                                                                         \
+        }                                                                                          \
+        assert(JOIN(OHT, get_value_mut)(ht_p, 1) == NULL);                                         \
+        count = 0;                                                                                 \
+        OHASHTABLE_FOR_EACH(ht_p, index, key, value)                                               \
+        {                                                                                          \
+            assert(key == 3 * (2 * count + 1) && value == -(2 * count + 1) - 1);                   \
+            count++;                                                                               \
+        }                                                                                          \
+        assert(count == (n) / 2);                                                                  \
+                                                                                                   \
+        /* filling up the entries compacts the deleted entries away: */                            \
+        const int n_left = (int)(ht_p->capacity - ht_p->count);                                    \
+        for (int i = 0; i < n_left; i++) {                                                         \
+            JOIN(OHT, update)(ht_p, -1 - i, i);                                                    \
+        }                                                                                          \
+        assert(JOIN(OHT, is_full)(ht_p) && ht_p->n_entries == ht_p->capacity);                     \
+        count = 0;                                                                                 \
+        OHASHTABLE_FOR_EACH(ht_p, index, key, value)                                               \
+        {                                                                                          \
+            if (count < (n) / 2) {                                                                 \
+                assert(key == 3 * (2 * count + 1));                                                \
+            }                                                                                      \
+            else {                                                                                 \
+                assert(key == -1 - (count - (n) / 2) && value == count - (n) / 2);                 \
+            }                                                                                      \
+            count++;                                                                               \
+        }                                                                                          \
+        assert(count == (int)ht_p->capacity);                                                      \
+        for (int i = 0; i < n_left; i++) {                                                         \
+            assert(JOIN(OHT, get_value)(ht_p, -1 - i, -1) == i);                                   \
+        }                                                                                          \
+                                                                                                   \
+        /* copying to a smaller, the same and a larger capacity: */                                \
+        assert(JOIN(OHT, delete)(ht_p, -1));                                                       \
+        for (uint32_t capacity = ht_p->count + 1; capacity <= 4 * ht_p->capacity; capacity *= 2) { \
+            struct OHT *copy_p = JOIN(OHT, create)(capacity);                                      \
+            if (!copy_p) {                                                                         \
+                assert(false);                                                                     \
+            }                                                                                      \
+            JOIN(OHT, copy)(copy_p, ht_p);                                                         \
+            assert(copy_p->count == ht_p->count && copy_p->n_entries == ht_p->count);              \
+            uint32_t copy_index = 0;                                                               \
+            OHASHTABLE_FOR_EACH(ht_p, index, key, value)                                           \
+            {                                                                                      \
+                assert(copy_p->entries[copy_index].key == key);                                    \
+                assert(JOIN(OHT, get_value)(copy_p, key, -1) == value);                            \
+                copy_index++;                                                                      \
+            }                                                                                      \
+            assert(!JOIN(OHT, contains_key)(copy_p, -1));                                          \
+            JOIN(OHT, destroy)(copy_p);                                                            \
+        }                                                                                          \
+                                                                                                   \
+        /* deleting the last entries frees their place: */                                         \
+        while (ht_p->n_entries > 0) {                                                              \
+            const uint32_t n_entries = ht_p->n_entries;                                            \
+            assert(JOIN(OHT, delete)(ht_p, ht_p->entries[n_entries - 1].key));                     \
+            assert(ht_p->n_entries < n_entries);                                                   \
+        }                                                                                          \
+        assert(JOIN(OHT, is_empty)(ht_p));                                                         \
+                                                                                                   \
+        JOIN(OHT, insert)(ht_p, 1, 1);                                                             \
+        JOIN(OHT, clear)(ht_p);                                                                    \
+        assert(JOIN(OHT, is_empty)(ht_p) && ht_p->n_entries == 0);                                 \
+        assert(!JOIN(OHT, contains_key)(ht_p, 1));                                                 \
+                                                                                                   \
+        JOIN(OHT, destroy)(ht_p);                                                                  \
+    } while (0)
+
+int main(void)
+{
+    insert_delete_and_compare(int_to_int_oht, 0);
+    insert_delete_and_compare(int_to_int_oht, 1);
+    insert_delete_and_compare(int_to_int_oht, 16);
+    insert_delete_and_compare(int_to_int_oht, 127);
+    insert_delete_and_compare(int_to_int_oht, 1000);
+    insert_delete_and_compare(int_to_int_oht, 32767);
+    insert_delete_and_compare(int_to_int_oht, 100000);
+
+    insert_delete_and_compare(int_to_int_collide_oht, 16);
+    insert_delete_and_compare(int_to_int_collide_oht, 1000);
+
+    assert(OHASHTABLE_INDEX_WIDTH(128) == 1);
+    assert(OHASHTABLE_INDEX_WIDTH(256) == 2);
+    assert(OHASHTABLE_INDEX_WIDTH(32768) == 2);
+    assert(OHASHTABLE_INDEX_WIDTH(65536) == 4);
+
+    assert(int_to_int_oht_create(0) == NULL);
+    assert(int_to_int_oht_create(UINT32_MAX / 2 + 2) == NULL);
+}
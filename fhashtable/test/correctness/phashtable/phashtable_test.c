@@ -0,0 +1,199 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 16
+    - N := 1e+3
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - contains_key + get_value + PHASHTABLE_FOR_EACH
+
+    Mutating operation types:
+    - get_value_mut
+
+    Memory operations [to also be tested with sanitizers]:
+    - freeze
+    - freeze_custom (with an allocator that fails after a limit)
+    - destroy
+
+    Underlying tables:
+    - default layout
+    - FHASHTABLE_LAYOUT_SOA
+
+    Keys with the same hash make freezing fail.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+// distinct keys must have distinct hashes, so the key itself is used:
+#define NAME               int_to_int_pht
+#define TABLE_NAME         int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint64_t)(uint32_t)(key))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "phashtable_template.h"
+
+#define NAME               int_to_int_soa_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define FHASHTABLE_LAYOUT_SOA
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_soa_pht
+#define TABLE_NAME         int_to_int_soa_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint64_t)(uint32_t)(key))
+#define TABLE_FOR_EACH     FHASHTABLE_SOA_FOR_EACH
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "phashtable_template.h"
+
+// all keys have the same hash:
+#define NAME               int_to_int_collide_pht
+#define TABLE_NAME         int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) ((uint32_t)(key) * 0U)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "phashtable_template.h"
+
+struct limited_allocator {
+    size_t n_allocations_left;
+};
+
+static void *limited_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)alignment;
+    struct limited_allocator *allocator_ptr = context_ptr;
+    if (allocator_ptr->n_allocations_left == 0) {
+        return NULL;
+    }
+    allocator_ptr->n_allocations_left--;
+    return malloc(size);
+}
+
+static void limited_deallocate(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+
+#define freeze_and_compare(TABLE, PHT, n)                                             \
+    do {                                                                              \
+        struct TABLE *ht_p = JOIN(TABLE, create)((n) + 1);                            \
+        if (!ht_p) {                                                                  \
+            assert(false);                                                            \
+        }                                                                             \
+        for (int i = 0; i < (n); i++) {                                               \
+            JOIN(TABLE, insert)(ht_p, 3 * i, i);                                      \
+        }                                                                             \
+        struct PHT *pht_p = JOIN(PHT, freeze)(ht_p);                                  \
+        if (!pht_p) {                                                                 \
+            assert(false);                                                            \
+        }                                                                             \
+        JOIN(TABLE, destroy)(ht_p);                                                   \
+                                                                                      \
+        assert(pht_p->count == (uint32_t)(n));                                        \
+        for (int i = 0; i < 3 * (n) + 3; i++) {                                       \
+            assert(JOIN(PHT, contains_key)(pht_p, i) == (i % 3 == 0 && i < 3 * (n))); \
+            const int expected = (i % 3 == 0 && i < 3 * (n)) ? i / 3 : -1;            \
+            assert(JOIN(PHT, get_value)(pht_p, i, -1) == expected);                   \
+        }                                                                             \
+                                                                                      \
+        for (int i = 0; i < (n); i++) {                                               \
+            int *value_p = JOIN(PHT, get_value_mut)(pht_p, 3 * i);                    \
+            if (!value_p) {                                                           \
+                assert(false);                                                        \
+            }                                                                         \
+            *value_p = -i;                                                            \
+        }                                                                             \
+        assert(JOIN(PHT, get_value_mut)(pht_p, 1) == NULL);                           \
+                                                                                      \
+        uint32_t index;                                                               \
+        int key, value;                                                               \
+        int count = 0;                                                                \
+        PHASHTABLE_FOR_EACH(pht_p, index, key, value)                                 \
+        {                                                                             \
+            assert(key % 3 == 0 && value == -key / 3);                                \
+            count++;                                                                  \
+        }                                                                             \
+        assert(count == (n));                                                         \
+                                                                                      \
+        JOIN(PHT, destroy)(pht_p);                                                    \
+    } while (0)
+
+int main(void)
+{
+    freeze_and_compare(int_to_int_table, int_to_int_pht, 0);
+    freeze_and_compare(int_to_int_table, int_to_int_pht, 1);
+    freeze_and_compare(int_to_int_table, int_to_int_pht, 16);
+    freeze_and_compare(int_to_int_table, int_to_int_pht, 1000);
+    freeze_and_compare(int_to_int_table, int_to_int_pht, 100000);
+
+    freeze_and_compare(int_to_int_soa_table, int_to_int_soa_pht, 0);
+    freeze_and_compare(int_to_int_soa_table, int_to_int_soa_pht, 1000);
+    freeze_and_compare(int_to_int_soa_table, int_to_int_soa_pht, 100000);
+
+    {
+        struct int_to_int_table *ht_p = int_to_int_table_create(16);
+        if (!ht_p) {
+            assert(false);
+        }
+        int_to_int_table_insert(ht_p, 1, 1);
+        int_to_int_table_insert(ht_p, 2, 2);
+
+        // the same hash:
+        assert(int_to_int_collide_pht_freeze(ht_p) == NULL);
+
+        // failing allocations:
+        for (size_t n_allocations = 0; n_allocations < 2; n_allocations++) {
+            struct limited_allocator allocator = {.n_allocations_left = n_allocations};
+            assert(int_to_int_pht_freeze_custom(ht_p, &allocator, limited_allocate, limited_deallocate) == NULL);
+        }
+        struct limited_allocator allocator = {.n_allocations_left = 2};
+        struct int_to_int_pht *pht_p =
+            int_to_int_pht_freeze_custom(ht_p, &allocator, limited_allocate, limited_deallocate);
+        if (!pht_p) {
+            assert(false);
+        }
+        assert(int_to_int_pht_get_value(pht_p, 2, 0) == 2);
+        int_to_int_pht_destroy_custom(pht_p, &allocator, limited_deallocate);
+
+        int_to_int_table_destroy(ht_p);
+    }
+
+    printf("phashtable test succeeded.\n");
+
+    return 0;
+}
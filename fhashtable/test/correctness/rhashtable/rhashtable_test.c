@@ -0,0 +1,272 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 1e+3
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - is_empty
+    - is_resizing
+    - contains_key + get_value + get_value_mut / search + rhashtable_for_each
+
+    Mutating operation types:
+    - insert
+    - update
+    - delete
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - create_custom (with an allocator that fails after a limit)
+    - destroy
+
+    Underlying tables:
+    - default layout
+    - FHASHTABLE_CONTROL_BYTES
+
+    Operations are compared against a plain array indexed by key.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_rht
+#define TABLE_NAME         int_to_int_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "rhashtable_template.h"
+
+#define NAME                    int_to_int_ctrl_table
+#define KEY_TYPE                int
+#define VALUE_TYPE              int
+#define KEY_IS_EQUAL(a, b)      ((a) == (b))
+#define HASH_FUNCTION(key)      fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define FHASHTABLE_CONTROL_BYTES
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               int_to_int_ctrl_rht
+#define TABLE_NAME         int_to_int_ctrl_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         int
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "rhashtable_template.h"
+
+struct limited_allocator {
+    size_t n_allocations_left;
+};
+
+static void *limited_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)alignment;
+    struct limited_allocator *allocator_ptr = context_ptr;
+    if (allocator_ptr->n_allocations_left == 0) {
+        return NULL;
+    }
+    allocator_ptr->n_allocations_left--;
+    return malloc(size);
+}
+
+static void limited_deallocate(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+
+void int_int_test(void)
+{
+    // N = 0
+    {
+        struct int_to_int_rht *ht_p = int_to_int_rht_create(0);
+        if (ht_p) {
+            assert(false);
+        }
+    }
+    // N = 1, grows on the second insertion
+    {
+        struct int_to_int_rht *ht_p = int_to_int_rht_create(1);
+        if (!ht_p) {
+            assert(false);
+        }
+        assert(int_to_int_rht_is_empty(ht_p));
+        assert(!int_to_int_rht_is_resizing(ht_p));
+        assert(!int_to_int_rht_contains_key(ht_p, 42));
+        assert(int_to_int_rht_get_value(ht_p, 42, -1) == -1);
+        assert(int_to_int_rht_get_value_mut(ht_p, 42) == NULL);
+
+        assert(int_to_int_rht_insert(ht_p, 42, 69));
+        assert(ht_p->curr_ptr->capacity == 1);
+        assert(int_to_int_rht_insert(ht_p, 69, 42));
+        assert(ht_p->curr_ptr->capacity == 2);
+        assert(ht_p->count == 2);
+
+        assert(int_to_int_rht_get_value(ht_p, 42, -1) == 69);
+        assert(int_to_int_rht_get_value(ht_p, 69, -1) == 42);
+        assert(*int_to_int_rht_search(ht_p, 42) == 69);
+
+        assert(int_to_int_rht_update(ht_p, 42, 1));
+        assert(int_to_int_rht_get_value(ht_p, 42, -1) == 1);
+        assert(ht_p->count == 2);
+
+        assert(int_to_int_rht_delete(ht_p, 42));
+        assert(!int_to_int_rht_delete(ht_p, 42));
+        assert(int_to_int_rht_delete(ht_p, 69));
+        assert(int_to_int_rht_is_empty(ht_p));
+
+        int_to_int_rht_destroy(ht_p);
+    }
+    // N = 1e+3, lookups and deletions while resizing
+    {
+        const int n = 1000;
+        struct int_to_int_rht *ht_p = int_to_int_rht_create(1);
+        if (!ht_p) {
+            assert(false);
+        }
+        bool has_seen_resize = false;
+        for (int i = 0; i < n; i++) {
+            assert(int_to_int_rht_insert(ht_p, i, -i));
+            if (int_to_int_rht_is_resizing(ht_p)) {
+                has_seen_resize = true;
+                assert(ht_p->prev_ptr->count + ht_p->curr_ptr->count == ht_p->count);
+            }
+            for (int j = 0; j <= i; j += 7) {
+                assert(int_to_int_rht_get_value(ht_p, j, 1) == -j);
+            }
+        }
+        assert(has_seen_resize);
+        assert(ht_p->count == (uint32_t)n);
+
+        for (int i = 0; i < n; i += 2) {
+            assert(int_to_int_rht_delete(ht_p, i));
+        }
+        assert(ht_p->count == (uint32_t)n / 2);
+        for (int i = 0; i < n; i++) {
+            assert(int_to_int_rht_contains_key(ht_p, i) == (i % 2 == 1));
+        }
+
+        int key, value;
+        uint32_t index;
+        uint32_t count = 0;
+        RHASHTABLE_FOR_EACH(ht_p, index, key, value)
+        {
+            assert(key % 2 == 1);
+            assert(value == -key);
+            count++;
+        }
+        assert(count == ht_p->count);
+
+        int_to_int_rht_clear(ht_p);
+        assert(int_to_int_rht_is_empty(ht_p));
+        assert(!int_to_int_rht_is_resizing(ht_p));
+        assert(!int_to_int_rht_contains_key(ht_p, 1));
+
+        int_to_int_rht_destroy(ht_p);
+    }
+    // allocation failure: grows while possible, then fills the last table
+    {
+        struct limited_allocator allocator = {.n_allocations_left = 3};
+        struct int_to_int_rht *ht_p =
+            int_to_int_rht_create_custom(4, &allocator, limited_allocate, limited_deallocate);
+        if (!ht_p) {
+            assert(false);
+        }
+        // capacity 4 -> 8 and no more:
+        int i = 0;
+        while (int_to_int_rht_insert(ht_p, i, i)) {
+            i++;
+        }
+        assert(i == 8);
+        assert(ht_p->curr_ptr->capacity == 8);
+        assert(!int_to_int_rht_update(ht_p, i, i));
+        assert(int_to_int_rht_update(ht_p, 0, 42));
+        for (int j = 0; j < i; j++) {
+            assert(int_to_int_rht_get_value(ht_p, j, -1) == (j == 0 ? 42 : j));
+        }
+        int_to_int_rht_destroy(ht_p);
+    }
+}
+
+#define compare_with_array(rht_name, n_ops, key_range)                                \
+    do {                                                                              \
+        struct rht_name *ht_p = JOIN(rht_name, create)(1);                            \
+        if (!ht_p) {                                                                  \
+            assert(false);                                                            \
+        }                                                                             \
+        int *values = malloc(sizeof(int) * (key_range));                              \
+        bool *exists = calloc((key_range), sizeof(bool));                             \
+        uint32_t count = 0;                                                           \
+                                                                                      \
+        srand(42);                                                                    \
+        for (int op = 0; op < (n_ops); op++) {                                        \
+            const int key = rand() % (key_range);                                     \
+            const int value = rand();                                                 \
+            switch (rand() % 4) {                                                     \
+            case 0:                                                                   \
+            case 1:                                                                   \
+                assert(JOIN(rht_name, update)(ht_p, key, value));                     \
+                count += !exists[key];                                                \
+                exists[key] = true;                                                   \
+                values[key] = value;                                                  \
+                break;                                                                \
+            case 2:                                                                   \
+                assert(JOIN(rht_name, delete)(ht_p, key) == exists[key]);             \
+                count -= exists[key];                                                 \
+                exists[key] = false;                                                  \
+                break;                                                                \
+            case 3:                                                                   \
+                assert(JOIN(rht_name, contains_key)(ht_p, key) == exists[key]);       \
+                if (exists[key]) {                                                    \
+                    assert(*JOIN(rht_name, get_value_mut)(ht_p, key) == values[key]); \
+                }                                                                     \
+                break;                                                                \
+            }                                                                         \
+            assert(ht_p->count == count);                                             \
+        }                                                                             \
+        for (int key = 0; key < (key_range); key++) {                                 \
+            const int expected_value = exists[key] ? values[key] : -1;                \
+            assert(JOIN(rht_name, get_value)(ht_p, key, -1) == expected_value);       \
+        }                                                                             \
+                                                                                      \
+        free(exists);                                                                 \
+        free(values);                                                                 \
+        JOIN(rht_name, destroy)(ht_p);                                                \
+    } while (0)
+
+void random_ops_test(void)
+{
+    // N = 1e+5
+    compare_with_array(int_to_int_rht, 100000, 50000);
+    compare_with_array(int_to_int_ctrl_rht, 100000, 50000);
+}
+
+int main(void)
+{
+    int_int_test();
+    random_ops_test();
+
+    printf("rhashtable test succeeded.\n");
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+/*
+    Test cases (N):
+    - N := 1
+    - N := 2
+    - N := 127
+    - N := 128
+    - N := 129
+    - N := 768
+    - N := 1e+6
+    - N := 1e+9
+    - N := UINT32_MAX
+    - N := UINT32_MAX + 2
+    - N := 1e+12
+    - N := UINT64_MAX / 2 + 1
+*/
+
+#include "round_up_pow2_64.h"
+#include "math.h"
+
+int main(void)
+{
+    {
+        assert(round_up_pow2_64(1) == 1);
+        assert(round_up_pow2_64_fallback(1) == 1);
+        assert(round_up_pow2_64(2) == 2);
+        assert(round_up_pow2_64_fallback(2) == 2);
+        assert(round_up_pow2_64(127) == 128);
+        assert(round_up_pow2_64_fallback(127) == 128);
+        assert(round_up_pow2_64(128) == 128);
+        assert(round_up_pow2_64_fallback(128) == 128);
+        assert(round_up_pow2_64(129) == 256);
+        assert(round_up_pow2_64_fallback(129) == 256);
+        assert(round_up_pow2_64(768) == 1024);
+        assert(round_up_pow2_64_fallback(768) == 1024);
+        assert(round_up_pow2_64(1e+6) == (uint64_t)pow(2, round(log2(1e+6))));
+        assert(round_up_pow2_64_fallback(1e+6) == (uint64_t)pow(2, round(log2(1e+6))));
+        assert(round_up_pow2_64(1e+9) == (uint64_t)pow(2, round(log2(1e+9))));
+        assert(round_up_pow2_64_fallback(1e+9) == (uint64_t)pow(2, round(log2(1e+9))));
+        assert(round_up_pow2_64(UINT32_MAX) == (uint64_t)pow(2, 32));
+        assert(round_up_pow2_64_fallback(UINT32_MAX) == (uint64_t)pow(2, 32));
+        assert(round_up_pow2_64((uint64_t)UINT32_MAX + 2) == (uint64_t)pow(2, 33));
+        assert(round_up_pow2_64_fallback((uint64_t)UINT32_MAX + 2) == (uint64_t)pow(2, 33));
+        assert(round_up_pow2_64(1e+12) == (uint64_t)pow(2, ceil(log2(1e+12))));
+        assert(round_up_pow2_64_fallback(1e+12) == (uint64_t)pow(2, ceil(log2(1e+12))));
+        assert(round_up_pow2_64(UINT64_MAX / 2 + 1) == (uint64_t)pow(2, 63));
+        assert(round_up_pow2_64_fallback(UINT64_MAX / 2 + 1) == (uint64_t)pow(2, 63));
+    }
+}
@@ -0,0 +1,273 @@
+/*
+    Test cases (capacity C, number of operations N):
+    - C := 1, N := 1e+3
+    - C := 16, N := 1e+3
+    - C := 1e+3, N := 1e+5
+
+    Operations compared against a set of the keys put, and not deleted or
+    evicted since:
+    - get
+    - peek
+    - put (evictions are recorded with the `on_evict` callback)
+    - delete
+    - contains_key + .count + is_empty + is_full
+    - S3FIFO_CACHE_FOR_EACH
+
+    Eviction policy:
+    - keys hit once survive a scan of keys seen once
+    - hits do not move entries between the queues
+    - a key put again after being evicted from the small queue goes into the
+      main queue
+    - deleted entries are reused before evicting other entries
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - create_custom (with an allocator that fails after a limit)
+    - clear
+    - destroy
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "fnvhash.h"
+
+#define NAME               int_to_index_table
+#define KEY_TYPE           int
+#define VALUE_TYPE         uint32_t
+#define KEY_IS_EQUAL(a, b) ((a) == (b))
+#define HASH_FUNCTION(key) fnvhash_32((uint8_t *)&(key), sizeof(int))
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME       index_queue
+#define VALUE_TYPE uint32_t
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fqueue_template.h"
+
+#define NAME       int_queue
+#define VALUE_TYPE int
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fqueue_template.h"
+
+#define NAME             int_to_int_s3fifo
+#define TABLE_NAME       int_to_index_table
+#define QUEUE_NAME       index_queue
+#define GHOST_QUEUE_NAME int_queue
+#define KEY_TYPE         int
+#define VALUE_TYPE       int
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "s3fifo_cache_template.h"
+
+struct limited_allocator {
+    size_t n_allocations_left;
+};
+
+static void *limited_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)alignment;
+    struct limited_allocator *allocator_ptr = context_ptr;
+    if (allocator_ptr->n_allocations_left == 0) {
+        return NULL;
+    }
+    allocator_ptr->n_allocations_left--;
+    return malloc(size);
+}
+
+static void limited_deallocate(void *context_ptr, void *mem)
+{
+    (void)context_ptr;
+    free(mem);
+}
+
+// the keys in the cache, and their values:
+struct model {
+    int count;
+    int n_evicted;
+    bool is_contained[2000];
+    int values[2000];
+};
+
+static void record_eviction(void *context_ptr, int key, int value)
+{
+    struct model *model_ptr = context_ptr;
+    assert(model_ptr->is_contained[key] && model_ptr->values[key] == value);
+    model_ptr->is_contained[key] = false;
+    model_ptr->count--;
+    model_ptr->n_evicted++;
+}
+
+static void operate_and_compare(const uint32_t capacity, const int n)
+{
+    static struct model model;
+    model = (struct model){0};
+
+    struct int_to_int_s3fifo *cache_p = int_to_int_s3fifo_create(capacity);
+    if (!cache_p) {
+        assert(false);
+    }
+    assert(int_to_int_s3fifo_is_empty(cache_p));
+
+    const int key_range = (int)capacity * 2;
+
+    srand(capacity);
+    for (int k = 0; k < n; k++) {
+        const int key = rand() % key_range;
+        const bool was_contained = model.is_contained[key];
+
+        switch (rand() % 4) {
+        case 0: {
+            int *value_p = int_to_int_s3fifo_get(cache_p, key);
+            assert((value_p != NULL) == was_contained);
+            assert(!value_p || *value_p == model.values[key]);
+        } break;
+        case 1: {
+            const int *value_p = int_to_int_s3fifo_peek(cache_p, key);
+            assert((value_p != NULL) == was_contained);
+            assert(!value_p || *value_p == model.values[key]);
+        } break;
+        case 2: {
+            const int n_evicted = model.n_evicted;
+            const bool is_full = int_to_int_s3fifo_is_full(cache_p);
+            const bool is_evicted = int_to_int_s3fifo_put(cache_p, key, k, record_eviction, &model);
+            assert(is_evicted == (model.n_evicted == n_evicted + 1));
+            assert(model.n_evicted - n_evicted <= 1);
+            assert(!is_evicted || !was_contained);
+            assert(!is_full || was_contained || is_evicted);
+            if (!was_contained) {
+                model.is_contained[key] = true;
+                model.count++;
+            }
+            model.values[key] = k;
+        } break;
+        case 3: {
+            assert(int_to_int_s3fifo_delete(cache_p, key) == was_contained);
+            if (was_contained) {
+                model.is_contained[key] = false;
+                model.count--;
+            }
+        } break;
+        }
+
+        assert(cache_p->count == (uint32_t)model.count);
+        assert(int_to_int_s3fifo_is_full(cache_p) == (model.count == (int)capacity));
+        assert(int_to_int_s3fifo_contains_key(cache_p, key) == model.is_contained[key]);
+    }
+
+    uint32_t index;
+    int key, value;
+    int count = 0;
+    S3FIFO_CACHE_FOR_EACH(cache_p, index, key, value)
+    {
+        assert(model.is_contained[key] && model.values[key] == value);
+        count++;
+    }
+    assert(count == model.count);
+
+    int_to_int_s3fifo_clear(cache_p);
+    assert(int_to_int_s3fifo_is_empty(cache_p));
+    for (key = 0; key < key_range; key++) {
+        assert(!int_to_int_s3fifo_contains_key(cache_p, key));
+    }
+    // the cleared cache can be filled again:
+    for (key = 0; key < (int)capacity; key++) {
+        assert(!int_to_int_s3fifo_put(cache_p, key, 0, NULL, NULL));
+    }
+    assert(int_to_int_s3fifo_is_full(cache_p));
+
+    int_to_int_s3fifo_destroy(cache_p);
+}
+
+int main(void)
+{
+    operate_and_compare(1, 1000);
+    operate_and_compare(16, 1000);
+    operate_and_compare(1000, 100000);
+
+    {
+        struct int_to_int_s3fifo *cache_p = int_to_int_s3fifo_create(100);
+        if (!cache_p) {
+            assert(false);
+        }
+        for (int key = 0; key < 50; key++) {
+            int_to_int_s3fifo_put(cache_p, key, key, NULL, NULL);
+        }
+
+        // hits only count, and do not move the entries:
+        const uint32_t small_count = cache_p->small_ptr->count;
+        const uint32_t main_count = cache_p->main_ptr->count;
+        for (int key = 0; key < 50; key++) {
+            assert(*int_to_int_s3fifo_get(cache_p, key) == key);
+        }
+        assert(cache_p->small_ptr->count == small_count && cache_p->main_ptr->count == main_count);
+
+        // the keys hit once survive a scan of keys seen once:
+        for (int key = 1000; key < 11000; key++) {
+            int_to_int_s3fifo_put(cache_p, key, key, NULL, NULL);
+        }
+        for (int key = 0; key < 50; key++) {
+            assert(*int_to_int_s3fifo_peek(cache_p, key) == key);
+        }
+        assert(int_to_int_s3fifo_is_full(cache_p));
+
+        int_to_int_s3fifo_destroy(cache_p);
+    }
+    {
+        struct int_to_int_s3fifo *cache_p = int_to_int_s3fifo_create(10);
+        if (!cache_p) {
+            assert(false);
+        }
+        for (int key = 0; key <= 10; key++) {
+            int_to_int_s3fifo_put(cache_p, key, key, NULL, NULL);
+        }
+        assert(!int_to_int_s3fifo_contains_key(cache_p, 0) && cache_p->main_ptr->count == 0);
+
+        // 0 is remembered as a ghost key, and is put into the main queue:
+        assert(int_to_int_s3fifo_put(cache_p, 0, 0, NULL, NULL));
+        assert(int_to_int_s3fifo_contains_key(cache_p, 0) && cache_p->main_ptr->count == 1);
+        assert(!int_to_int_s3fifo_contains_key(cache_p, 1));
+
+        // the entry of a deleted key is reused without evicting another entry:
+        assert(int_to_int_s3fifo_delete(cache_p, 2));
+        assert(!int_to_int_s3fifo_delete(cache_p, 2));
+        assert(!int_to_int_s3fifo_put(cache_p, 11, 11, NULL, NULL));
+        assert(int_to_int_s3fifo_is_full(cache_p));
+        assert(int_to_int_s3fifo_contains_key(cache_p, 11) && !int_to_int_s3fifo_contains_key(cache_p, 2));
+
+        int_to_int_s3fifo_destroy(cache_p);
+    }
+
+    assert(int_to_int_s3fifo_create(0) == NULL);
+    assert(int_to_int_s3fifo_create(UINT32_MAX / 4 + 1) == NULL);
+    {
+        // the cache, table and three queues are allocated:
+        struct limited_allocator allocator;
+        for (size_t n = 0; n < 5; n++) {
+            allocator.n_allocations_left = n;
+            assert(int_to_int_s3fifo_create_custom(16, &allocator, limited_allocate, limited_deallocate) == NULL);
+        }
+
+        allocator.n_allocations_left = 5;
+        struct int_to_int_s3fifo *cache_p =
+            int_to_int_s3fifo_create_custom(16, &allocator, limited_allocate, limited_deallocate);
+        if (!cache_p) {
+            assert(false);
+        }
+        // no allocations on the hot path:
+        for (int i = 0; i < 1000; i++) {
+            int_to_int_s3fifo_put(cache_p, i % 100, i, NULL, NULL);
+            int_to_int_s3fifo_get(cache_p, i % 7);
+        }
+        assert(allocator.n_allocations_left == 0);
+        int_to_int_s3fifo_destroy(cache_p);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+    Short string sizes:
+    - 16 bytes (15 bytes inline)
+    - 24 bytes (23 bytes inline)
+
+    Test cases (string lengths L):
+    - L := 0 .. 64 (inline, and out-of-line past the inline limit)
+
+    Operations:
+    - from + from_cstr
+    - is_inline + length + chars
+    - is_equal (also between out-of-line strings in different buffers, and
+      strings with `\0` bytes)
+    - hash (equal strings have equal hashes)
+
+    Short strings are also used as the keys of fhashtables, with N := 1e+4
+    keys of mixed lengths.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAME sstr16
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "sstr_template.h"
+
+#define NAME      sstr24
+#define SSTR_SIZE 24
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "sstr_template.h"
+
+#define NAME               sstr16_to_int_ht
+#define KEY_TYPE           struct sstr16
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) sstr16_is_equal(a, b)
+#define HASH_FUNCTION(key) sstr16_hash(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define NAME               sstr24_to_int_ht
+#define KEY_TYPE           struct sstr24
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) sstr24_is_equal(a, b)
+#define HASH_FUNCTION(key) sstr24_hash(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+#define N 10000
+
+// every key is the digits of a number, repeated up to a length of 0 to 47 bytes:
+static char key_bufs[N][64];
+static char key_copies[N][64];
+
+static void make_key(char *buf, const int i)
+{
+    char digits[16];
+    const int n_digits = snprintf(digits, sizeof(digits), "%d", i);
+    const uint32_t length = (uint32_t)(i % 48);
+    for (uint32_t j = 0; j < length; j++) {
+        buf[j] = digits[j % (uint32_t)n_digits];
+    }
+    buf[length] = '\0';
+}
+
+#define compare_lengths(SSTR, size)                                                              \
+    do {                                                                                         \
+        char a_buf[65], b_buf[65];                                                               \
+        assert(sizeof(struct SSTR) == (size));                                                   \
+        for (uint32_t length = 0; length <= 64; length++) {                                      \
+            memset(a_buf, 'a', length);                                                          \
+            memset(b_buf, 'a', length);                                                          \
+            a_buf[length] = b_buf[length] = '\0';                                                \
+            const struct SSTR a = JOIN(SSTR, from)(a_buf, length);                               \
+            const struct SSTR b = JOIN(SSTR, from_cstr)(b_buf);                                  \
+            assert(JOIN(SSTR, is_inline)(a) == (length < (size)));                               \
+            assert(JOIN(SSTR, length)(a) == length);                                             \
+            assert(memcmp(JOIN(SSTR, chars)(&a), a_buf, length) == 0);                           \
+            assert(JOIN(SSTR, is_equal)(a, b));                                                  \
+            assert(JOIN(SSTR, hash)(a) == JOIN(SSTR, hash)(b));                                  \
+            if (length > 0) {                                                                    \
+                b_buf[length - 1] = 'b';                                                         \
+                assert(!JOIN(SSTR, is_equal)(a, JOIN(SSTR, from)(b_buf, length)));               \
+                assert(!JOIN(SSTR, is_equal)(a, JOIN(SSTR, from)(a_buf, length - 1)));           \
+            }                                                                                    \
+        }                                                                                        \
+        /* strings with `\0` bytes: */                                                           \
+        assert(!JOIN(SSTR, is_equal)(JOIN(SSTR, from)("a\0b", 3), JOIN(SSTR, from)("a\0c", 3))); \
+        assert(!JOIN(SSTR, is_equal)(JOIN(SSTR, from)("a\0", 2), JOIN(SSTR, from)("a", 1)));     \
+        assert(JOIN(SSTR, is_equal)(JOIN(SSTR, from)("", 0), JOIN(SSTR, from)(NULL, 0)));        \
+    } while (0)
+
+#define insert_and_compare(SSTR, HT)                                                  \
+    do {                                                                              \
+        struct HT *ht_p = JOIN(HT, create)(N + N / 3);                                \
+        if (!ht_p) {                                                                  \
+            assert(false);                                                            \
+        }                                                                             \
+        for (int i = 0; i < N; i++) {                                                 \
+            JOIN(HT, update)(ht_p, JOIN(SSTR, from_cstr)(key_bufs[i]), i);            \
+        }                                                                             \
+        /* different numbers may give the same key, which keeps the last value: */    \
+        int n_distinct = 0;                                                           \
+        for (int i = 0; i < N; i++) {                                                 \
+            const struct SSTR key = JOIN(SSTR, from_cstr)(key_copies[i]);             \
+            const int value = JOIN(HT, get_value)(ht_p, key, -1);                     \
+            assert(value >= i && strcmp(key_bufs[value], key_copies[i]) == 0);        \
+            n_distinct += value == i;                                                 \
+        }                                                                             \
+        assert(ht_p->count == (uint32_t)n_distinct);                                  \
+        assert(!JOIN(HT, contains_key)(ht_p, JOIN(SSTR, from_cstr)("not a number"))); \
+        JOIN(HT, destroy)(ht_p);                                                      \
+    } while (0)
+
+int main(void)
+{
+    compare_lengths(sstr16, 16);
+    compare_lengths(sstr24, 24);
+
+    for (int i = 0; i < N; i++) {
+        make_key(key_bufs[i], i);
+        make_key(key_copies[i], i);
+    }
+    insert_and_compare(sstr16, sstr16_to_int_ht);
+    insert_and_compare(sstr24, sstr24_to_int_ht);
+}
@@ -0,0 +1,187 @@
+/*
+    Test cases (N strings):
+    - N := 0
+    - N := 1
+    - N := 16
+    - N := 1e+3
+    - N := 1e+5
+
+    Operations:
+    - intern + intern_cstr (the same handle for duplicates)
+    - find (without interning)
+    - chars (the `\0`-terminated bytes)
+    - .count + is_empty + is_full
+    - STRPOOL_FOR_EACH
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Edge cases:
+    - the empty string, and strings with `\0` bytes
+    - strings with the same hash
+    - interning into a full pool, and into a full arena (leaving the arena
+      unchanged)
+
+    The handles are also used as the keys of an fhashtable.
+*/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAME arena
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "arena_template.h"
+
+#define NAME       strpool
+#define ARENA_NAME arena
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "strpool_template.h"
+
+#define NAME               str_to_int_ht
+#define KEY_TYPE           struct strpool_str
+#define VALUE_TYPE         int
+#define KEY_IS_EQUAL(a, b) STRPOOL_STR_IS_EQUAL(a, b)
+#define HASH_FUNCTION(key) STRPOOL_STR_HASH(key)
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fhashtable_template.h"
+
+static unsigned char buf[1 << 22];
+
+static void intern_and_compare(const uint32_t n)
+{
+    struct arena arena;
+    arena_init(&arena, sizeof(buf), buf);
+
+    struct strpool *pool_p = strpool_create(n + n / 3 + 1, &arena);
+    if (!pool_p) {
+        assert(false);
+    }
+    assert(strpool_is_empty(pool_p));
+
+    char cstr[32];
+    for (uint32_t i = 0; i < n; i++) {
+        snprintf(cstr, sizeof(cstr), "str%u", i);
+        struct strpool_str str;
+        assert(!strpool_find(pool_p, cstr, (uint32_t)strlen(cstr), &str));
+        assert(strpool_intern_cstr(pool_p, cstr, &str));
+        assert(str.length == strlen(cstr) && strcmp(strpool_chars(pool_p, str), cstr) == 0);
+    }
+    assert(pool_p->count == n);
+
+    // interning again gives the same handles, and copies nothing:
+    const size_t arena_offset = arena.curr_offset;
+    for (uint32_t i = 0; i < n; i++) {
+        snprintf(cstr, sizeof(cstr), "str%u", i);
+        struct strpool_str str, found_str;
+        assert(strpool_find(pool_p, cstr, (uint32_t)strlen(cstr), &found_str));
+        assert(strpool_intern(pool_p, cstr, (uint32_t)strlen(cstr), &str));
+        assert(STRPOOL_STR_IS_EQUAL(str, found_str) && str.hash == found_str.hash);
+    }
+    assert(pool_p->count == n && arena.curr_offset == arena_offset);
+
+    // a prefix is a different string:
+    {
+        struct strpool_str str;
+        assert(!strpool_find(pool_p, "str1", 3, &str));
+    }
+
+    struct str_to_int_ht *ht_p = str_to_int_ht_create(n + n / 3 + 1);
+    if (!ht_p) {
+        assert(false);
+    }
+    uint32_t index;
+    struct strpool_str str;
+    uint32_t count = 0;
+    STRPOOL_FOR_EACH(pool_p, index, str)
+    {
+        str_to_int_ht_insert(ht_p, str, (int)str.length);
+        count++;
+    }
+    assert(count == n);
+    for (uint32_t i = 0; i < n; i++) {
+        snprintf(cstr, sizeof(cstr), "str%u", i);
+        assert(strpool_intern_cstr(pool_p, cstr, &str));
+        assert(str_to_int_ht_get_value(ht_p, str, -1) == (int)strlen(cstr));
+    }
+    str_to_int_ht_destroy(ht_p);
+
+    strpool_clear(pool_p);
+    assert(strpool_is_empty(pool_p));
+    assert(!strpool_find(pool_p, "str0", 4, &str));
+
+    strpool_destroy(pool_p);
+}
+
+int main(void)
+{
+    intern_and_compare(0);
+    intern_and_compare(1);
+    intern_and_compare(16);
+    intern_and_compare(1000);
+    intern_and_compare(100000);
+
+    {
+        struct arena arena;
+        arena_init(&arena, sizeof(buf), buf);
+
+        struct strpool *pool_p = strpool_create(4, &arena);
+        if (!pool_p) {
+            assert(false);
+        }
+
+        // the empty string, and strings with `\0` bytes:
+        struct strpool_str empty_str, a_str, ab_str, ac_str, str;
+        assert(strpool_intern(pool_p, "", 0, &empty_str));
+        assert(empty_str.length == 0 && strpool_chars(pool_p, empty_str)[0] == '\0');
+        assert(strpool_intern(pool_p, "a", 1, &a_str));
+        assert(strpool_intern(pool_p, "a\0b", 3, &ab_str));
+        assert(strpool_intern(pool_p, "a\0c", 3, &ac_str));
+        assert(!STRPOOL_STR_IS_EQUAL(a_str, ab_str) && !STRPOOL_STR_IS_EQUAL(ab_str, ac_str));
+        assert(memcmp(strpool_chars(pool_p, ac_str), "a\0c", 4) == 0);
+        assert(strpool_is_full(pool_p));
+
+        // a full pool only interns the strings it has:
+        assert(strpool_intern(pool_p, "a\0b", 3, &str) && STRPOOL_STR_IS_EQUAL(str, ab_str));
+        assert(!strpool_intern(pool_p, "d", 1, &str));
+        assert(!strpool_find(pool_p, "d", 1, &str));
+
+        strpool_destroy(pool_p);
+    }
+    {
+        struct arena arena;
+        unsigned char small_buf[64];
+        arena_init(&arena, sizeof(small_buf), small_buf);
+
+        struct strpool *pool_p = strpool_create(16, &arena);
+        if (!pool_p) {
+            assert(false);
+        }
+        struct strpool_str str;
+        char long_cstr[128];
+        memset(long_cstr, 'x', sizeof(long_cstr) - 1);
+        long_cstr[sizeof(long_cstr) - 1] = '\0';
+
+        // the arena is left unchanged when it does not have enough memory:
+        assert(strpool_intern_cstr(pool_p, "abc", &str));
+        const size_t arena_offset = arena.curr_offset;
+        assert(!strpool_intern_cstr(pool_p, long_cstr, &str));
+        assert(arena.curr_offset == arena_offset && pool_p->count == 1);
+        assert(strpool_intern_cstr(pool_p, "abcd", &str));
+        assert(strcmp(strpool_chars(pool_p, str), "abcd") == 0);
+
+        strpool_destroy(pool_p);
+    }
+
+    assert(strpool_create(0, NULL) == NULL);
+    assert(strpool_create(UINT32_MAX / 2 + 2, NULL) == NULL);
+}
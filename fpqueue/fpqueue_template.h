@@ -95,7 +95,8 @@ extern "C" {
  *          errors.
  *
  * @param[in] self              Priority queue pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FPQUEUE_LARGE_CAPACITY`).
  * @param[out] value_           Current value. Should be `VALUE_TYPE`.
  */
 #ifndef FPQUEUE_FOR_EACH
@@ -114,8 +115,9 @@ extern "C" {
  * @return                      The equivalent size.
  */
 #ifndef FPQUEUE_CALC_SIZEOF
-#define FPQUEUE_CALC_SIZEOF(fpqueue_name, capacity) \
-    (uint32_t)(offsetof(struct fpqueue_name, elements) + capacity * sizeof(((struct fpqueue_name *)0)->elements[0]))
+#define FPQUEUE_CALC_SIZEOF(fpqueue_name, capacity)             \
+    (FPQUEUE_SIZE_TYPE)(offsetof(struct fpqueue_name, elements) \
+                        + capacity * sizeof(((struct fpqueue_name *)0)->elements[0]))
 #endif
 
 /**
@@ -131,7 +133,7 @@ extern "C" {
 #ifndef FPQUEUE_CALC_SIZEOF_OVERFLOWS
 #define FPQUEUE_CALC_SIZEOF_OVERFLOWS(fpqueue_name, capacity) \
     (capacity                                                 \
-     > (UINT32_MAX - offsetof(struct fpqueue_name, elements)) / sizeof(((struct fpqueue_name *)0)->elements[0]))
+     > (FPQUEUE_SIZE_MAX - offsetof(struct fpqueue_name, elements)) / sizeof(((struct fpqueue_name *)0)->elements[0]))
 #endif
 
 /**
@@ -169,7 +171,28 @@ extern "C" {
 #define FUNCTION_LINKAGE
 #endif
 
+/**
+ * @def FPQUEUE_LARGE_CAPACITY
+ * @brief Use `size_t` for the count, capacity and indices instead of `uint32_t`.
+ *
+ * Lifts the limit of `UINT32_MAX` elements and the limit on the size of the
+ * priority queue struct in bytes, at the cost of larger header fields.
+ * Priorities stay `uint32_t`.
+ *
+ * Is undefined after header is included.
+ */
+#ifdef FPQUEUE_LARGE_CAPACITY
+#endif
+
 /// @cond DO_NOT_DOCUMENT
+#ifdef FPQUEUE_LARGE_CAPACITY
+#define FPQUEUE_SIZE_TYPE size_t
+#define FPQUEUE_SIZE_MAX  SIZE_MAX
+#else
+#define FPQUEUE_SIZE_TYPE uint32_t
+#define FPQUEUE_SIZE_MAX  UINT32_MAX
+#endif
+
 #define FPQUEUE_TYPE         struct FPQUEUE_NAME
 #define FPQUEUE_ELEMENT_TYPE struct JOIN(FPQUEUE_NAME, element)
 #define FPQUEUE_INIT         JOIN(FPQUEUE_NAME, init)
@@ -204,8 +227,8 @@ struct JOIN(FPQUEUE_NAME, element) {
  * @brief Generated priority queue struct type for a given `VALUE_TYPE`.
  */
 struct FPQUEUE_NAME {
-    uint32_t count;                  ///< Number of non-empty elements.
-    uint32_t capacity;               ///< Number of elements allocated for.
+    FPQUEUE_SIZE_TYPE count;         ///< Number of non-empty elements.
+    FPQUEUE_SIZE_TYPE capacity;      ///< Number of elements allocated for.
     FPQUEUE_ELEMENT_TYPE elements[]; ///< Array of elements.
 };
 
@@ -221,7 +244,7 @@ struct FPQUEUE_NAME {
  * @param[in] self              Priority queue pointer
  * @param[in] capacity          Capacity
  */
-FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, const uint32_t capacity);
+FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, const FPQUEUE_SIZE_TYPE capacity);
 
 /**
  * @brief Create an priority queue struct with a given capacity with a custom allocator
@@ -236,7 +259,7 @@ FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, cons
  *   @li                        If allocate returns NULL.
  */
 FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME,
-                                    create_custom)(const uint32_t capacity, void *context_ptr,
+                                    create_custom)(const FPQUEUE_SIZE_TYPE capacity, void *context_ptr,
                                                    void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
 
 /**
@@ -249,7 +272,7 @@ FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME,
  *   @li                        If capacity is 0 or the equivalent size overflows.
  *   @li                        If malloc fails.
  */
-FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create)(const uint32_t capacity);
+FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create)(const FPQUEUE_SIZE_TYPE capacity);
 
 /**
  * @brief Destroy an priority queue struct and free the underlying memory with a custom allocator.
@@ -372,14 +395,14 @@ FUNCTION_LINKAGE void JOIN(FPQUEUE_NAME, copy)(FPQUEUE_TYPE *restrict dest_ptr,
 /// @cond DO_NOT_DOCUMENT
 
 /* push a node down the heap. for restoring the heap property after insertion */
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const uint32_t index);
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const FPQUEUE_SIZE_TYPE index);
 
 /* push a node up the heap. for restoring the heap property after deletion */
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index);
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, FPQUEUE_SIZE_TYPE index);
 
 /// @endcond
 
-FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, const uint32_t capacity)
+FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, const FPQUEUE_SIZE_TYPE capacity)
 {
     assert(self);
 
@@ -390,14 +413,14 @@ FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, cons
 }
 
 FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME,
-                                    create_custom)(const uint32_t capacity, void *context_ptr,
+                                    create_custom)(const FPQUEUE_SIZE_TYPE capacity, void *context_ptr,
                                                    void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
 {
     if (capacity == 0 || FPQUEUE_CALC_SIZEOF_OVERFLOWS(FPQUEUE_NAME, capacity)) {
         return NULL;
     }
 
-    const uint32_t size = FPQUEUE_CALC_SIZEOF(FPQUEUE_NAME, capacity);
+    const FPQUEUE_SIZE_TYPE size = FPQUEUE_CALC_SIZEOF(FPQUEUE_NAME, capacity);
 
     FPQUEUE_TYPE *self = (FPQUEUE_TYPE *)allocate(context_ptr, alignof(FPQUEUE_TYPE), size);
 
@@ -420,7 +443,7 @@ static inline void *JOIN(internal, JOIN(FPQUEUE_NAME, allocate))(void *context_p
 }
 /// @endcond
 
-FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create)(const uint32_t capacity)
+FUNCTION_LINKAGE FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create)(const FPQUEUE_SIZE_TYPE capacity)
 {
     return JOIN(FPQUEUE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(FPQUEUE_NAME, allocate)));
 }
@@ -496,7 +519,7 @@ FUNCTION_LINKAGE void JOIN(FPQUEUE_NAME, push)(FPQUEUE_TYPE *self, VALUE_TYPE va
     assert(self != NULL);
     assert(FPQUEUE_IS_FULL(self) == false);
 
-    const uint32_t index = self->count;
+    const FPQUEUE_SIZE_TYPE index = self->count;
 
     self->elements[index] = (FPQUEUE_ELEMENT_TYPE){.priority = priority, .value = value};
 
@@ -519,7 +542,7 @@ FUNCTION_LINKAGE void JOIN(FPQUEUE_NAME, copy)(FPQUEUE_TYPE *restrict dest_ptr,
     assert(src_ptr->count <= dest_ptr->capacity);
     assert(FPQUEUE_IS_EMPTY(dest_ptr));
 
-    for (uint32_t i = 0; i < src_ptr->count; i++) {
+    for (FPQUEUE_SIZE_TYPE i = 0; i < src_ptr->count; i++) {
         dest_ptr->elements[i] = src_ptr->elements[i];
     }
     dest_ptr->count = src_ptr->count;
@@ -527,12 +550,12 @@ FUNCTION_LINKAGE void JOIN(FPQUEUE_NAME, copy)(FPQUEUE_TYPE *restrict dest_ptr,
 
 /// @cond DO_NOT_DOCUMENT
 
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index)
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, FPQUEUE_SIZE_TYPE index)
 {
     assert(self != NULL);
     assert(index < self->count);
 
-    uint32_t parent;
+    FPQUEUE_SIZE_TYPE parent;
     while (index > 0) {
         parent = FPQUEUE_PARENT(index);
 
@@ -550,15 +573,15 @@ static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self
     }
 }
 
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const uint32_t index)
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const FPQUEUE_SIZE_TYPE index)
 {
     assert(self != NULL);
     assert(self->count == 0 || index < self->count);
 
-    const uint32_t l = FPQUEUE_LEFT_CHILD(index);
-    const uint32_t r = FPQUEUE_RIGHT_CHILD(index);
+    const FPQUEUE_SIZE_TYPE l = FPQUEUE_LEFT_CHILD(index);
+    const FPQUEUE_SIZE_TYPE r = FPQUEUE_RIGHT_CHILD(index);
 
-    uint32_t largest = index;
+    FPQUEUE_SIZE_TYPE largest = index;
     if (l < self->count && self->elements[l].priority > self->elements[index].priority) {
         largest = l;
     }
@@ -586,6 +609,7 @@ static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *se
 
 #undef NAME
 #undef VALUE_TYPE
+#undef FPQUEUE_LARGE_CAPACITY
 #undef FUNCTION_LINKAGE
 #undef FUNCTION_DEFINITIONS
 #undef TYPE_DEFINITIONS
@@ -596,7 +620,10 @@ static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *se
 #undef FPQUEUE_INIT
 #undef FPQUEUE_IS_EMPTY
 #undef FPQUEUE_IS_FULL
+#undef FPQUEUE_SIZE_TYPE
+#undef FPQUEUE_SIZE_MAX
 #undef FPQUEUE_CALC_SIZEOF
+#undef FPQUEUE_CALC_SIZEOF_OVERFLOWS
 #undef FHASHTABLE_UPHEAP
 #undef FHASHTABLE_DOWNHEAP
 
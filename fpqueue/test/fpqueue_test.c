@@ -26,6 +26,10 @@
     - create
     - destroy
     - copy
+
+    FPQUEUE_LARGE_CAPACITY:
+    - N := 1e+3
+    - N := UINT32_MAX + 1 (only the requested allocation size is checked)
 */
 
 #define NAME       i64_pque
@@ -35,6 +39,24 @@
 #define FUNCTION_LINKAGE static inline
 #include "fpqueue_template.h"
 
+#define NAME       i64_large_pque
+#define VALUE_TYPE int64_t
+#define FPQUEUE_LARGE_CAPACITY
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fpqueue_template.h"
+
+static size_t requested_size;
+
+static void *record_size_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    requested_size = size;
+    return NULL;
+}
+
 static inline bool check_count_invariance(const struct i64_pque *que_p, const size_t push_op_count,
                                           const size_t pop_op_count)
 {
@@ -308,4 +330,45 @@ int main(void)
 
         i64_pque_destroy(que_p);
     }
+    // FPQUEUE_LARGE_CAPACITY: N = 1e+3, push * 1e+3 -> pop_max * 1e+3
+    {
+        struct i64_large_pque *que_p = i64_large_pque_create(1000);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 1000; i++) {
+            // priorities in a scrambled order:
+            const uint32_t priority = (i * 7919) % 1000;
+            i64_large_pque_push(que_p, priority, priority);
+        }
+        assert(i64_large_pque_is_full(que_p));
+
+        size_t index;
+        int64_t value;
+        FPQUEUE_FOR_EACH(que_p, index, value)
+        {
+            assert(value == que_p->elements[index].priority);
+            if (index > 0) {
+                assert(que_p->elements[FPQUEUE_PARENT(index)].priority >= que_p->elements[index].priority);
+            }
+        }
+        for (int64_t i = 999; i >= 0; i--) {
+            assert(i64_large_pque_pop_max(que_p) == i);
+        }
+        assert(i64_large_pque_is_empty(que_p));
+
+        i64_large_pque_destroy(que_p);
+    }
+    // FPQUEUE_LARGE_CAPACITY: N = UINT32_MAX + 1
+    {
+        requested_size = 0;
+        assert(i64_pque_create_custom(UINT32_MAX / 2, NULL, record_size_allocate) == NULL);
+        assert(requested_size == 0);
+
+        if (SIZE_MAX > UINT32_MAX) {
+            const size_t capacity = (size_t)UINT32_MAX + 1;
+            assert(i64_large_pque_create_custom(capacity, NULL, record_size_allocate) == NULL);
+            assert(requested_size >= capacity * sizeof(struct i64_large_pque_element));
+        }
+    }
 }
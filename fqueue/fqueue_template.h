@@ -68,7 +68,8 @@ extern "C" {
  * @warning Modifying the queue under the iteration may result in errors.
  *
  * @param[in] self              Queue pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FQUEUE_LARGE_CAPACITY`).
  * @param[out] value            Current value. Should be `VALUE_TYPE`.
  */
 #ifndef FQUEUE_FOR_EACH
@@ -85,7 +86,8 @@ extern "C" {
  * @warning Modifying the queue under the iteration may result in errors.
  *
  * @param[in] self              Queue pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FQUEUE_LARGE_CAPACITY`).
  * @param[out] value            Current value. Should be `VALUE_TYPE`.
  */
 #ifndef FQUEUE_FOR_EACH_REVERSE
@@ -107,7 +109,7 @@ extern "C" {
  */
 #ifndef FQUEUE_CALC_SIZEOF
 #define FQUEUE_CALC_SIZEOF(fqueue_name, capacity) \
-    (uint32_t)(offsetof(struct fqueue_name, values) + capacity * sizeof(((struct fqueue_name *)0)->values[0]))
+    (FQUEUE_SIZE_TYPE)(offsetof(struct fqueue_name, values) + capacity * sizeof(((struct fqueue_name *)0)->values[0]))
 #endif
 
 /**
@@ -122,7 +124,7 @@ extern "C" {
  */
 #ifndef FQUEUE_CALC_SIZEOF_OVERFLOWS
 #define FQUEUE_CALC_SIZEOF_OVERFLOWS(fqueue_name, capacity) \
-    (capacity > (UINT32_MAX - offsetof(struct fqueue_name, values)) / sizeof(((struct fqueue_name *)0)->values[0]))
+    (capacity > (FQUEUE_SIZE_MAX - offsetof(struct fqueue_name, values)) / sizeof(((struct fqueue_name *)0)->values[0]))
 #endif
 
 /**
@@ -160,7 +162,29 @@ extern "C" {
 #define FUNCTION_LINKAGE
 #endif
 
+/**
+ * @def FQUEUE_LARGE_CAPACITY
+ * @brief Use `size_t` for the indices, count and capacity instead of `uint32_t`.
+ *
+ * Lifts the limit of `UINT32_MAX / 2 + 1` values and the limit on the size of
+ * the queue struct in bytes, at the cost of larger header fields.
+ *
+ * Is undefined after header is included.
+ */
+#ifdef FQUEUE_LARGE_CAPACITY
+#endif
+
 /// @cond DO_NOT_DOCUMENT
+#ifdef FQUEUE_LARGE_CAPACITY
+#define FQUEUE_SIZE_TYPE        size_t
+#define FQUEUE_SIZE_MAX         SIZE_MAX
+#define FQUEUE_ROUND_UP_POW2(x) ((size_t)round_up_pow2_64(x))
+#else
+#define FQUEUE_SIZE_TYPE        uint32_t
+#define FQUEUE_SIZE_MAX         UINT32_MAX
+#define FQUEUE_ROUND_UP_POW2(x) round_up_pow2_32(x)
+#endif
+
 #define FQUEUE_TYPE     struct FQUEUE_NAME
 #define FQUEUE_INIT     JOIN(FQUEUE_NAME, init)
 #define FQUEUE_IS_EMPTY JOIN(FQUEUE_NAME, is_empty)
@@ -183,11 +207,11 @@ struct FQUEUE_NAME;
  * @brief Generated queue struct type for a `VALUE_TYPE`.
  */
 struct FQUEUE_NAME {
-    uint32_t begin_index; ///< Index used to track the front of the queue.
-    uint32_t end_index;   ///< Index used to track the back of the queue.
-    uint32_t count;       ///< Number of values.
-    uint32_t capacity;    ///< Maximum number of values allocated for.
-    VALUE_TYPE values[];  ///< Array of values.
+    FQUEUE_SIZE_TYPE begin_index; ///< Index used to track the front of the queue.
+    FQUEUE_SIZE_TYPE end_index;   ///< Index used to track the back of the queue.
+    FQUEUE_SIZE_TYPE count;       ///< Number of values.
+    FQUEUE_SIZE_TYPE capacity;    ///< Maximum number of values allocated for.
+    VALUE_TYPE values[];          ///< Array of values.
 };
 
 #endif
@@ -202,7 +226,7 @@ struct FQUEUE_NAME {
  * @param[in] self              Queue pointer
  * @param[in] pow2_capacity     Power of 2 capacity
  */
-FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const uint32_t pow2_capacity);
+FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const FQUEUE_SIZE_TYPE pow2_capacity);
 
 /**
  * @brief Create an queue struct with a given capacity with custom allocator.
@@ -214,10 +238,11 @@ FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const u
  * @return                      A pointer to the queue.
  * @retval NULL
  *   @li                        If allocate returns null.
- *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size overflows.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FQUEUE_LARGE_CAPACITY`) or the equivalent size overflows.
  */
 FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME,
-                                   create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                   create_custom)(const FQUEUE_SIZE_TYPE min_capacity, void *context_ptr,
                                                   void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
 
 /**
@@ -228,9 +253,10 @@ FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME,
  * @return                      A pointer to the queue.
  * @retval NULL
  *   @li                        If malloc fails.
- *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 or the equivalent size overflows.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1 (SIZE_MAX / 2 + 1 with
+ *                              `FQUEUE_LARGE_CAPACITY`) or the equivalent size overflows.
  */
-FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, create)(const uint32_t min_capacity);
+FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, create)(const FQUEUE_SIZE_TYPE min_capacity);
 
 /**
  * @brief Destroy an queue struct and free the underlying memory with custom allocator.
@@ -282,7 +308,7 @@ FUNCTION_LINKAGE bool JOIN(FQUEUE_NAME, is_full)(const FQUEUE_TYPE *self);
  *
  * @return                      The value at `index`.
  */
-FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, at)(const FQUEUE_TYPE *self, const uint32_t index);
+FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, at)(const FQUEUE_TYPE *self, const FQUEUE_SIZE_TYPE index);
 
 /**
  * @brief Get the value from the front of a non-empty queue.
@@ -358,9 +384,13 @@ FUNCTION_LINKAGE void JOIN(FQUEUE_NAME, copy)(FQUEUE_TYPE *restrict dest_ptr, co
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef FQUEUE_LARGE_CAPACITY
+#include "round_up_pow2_64.h" // round_up_pow2_64
+#else
 #include "round_up_pow2_32.h" // round_up_pow2_32
+#endif
 
-FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const uint32_t pow2_capacity)
+FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const FQUEUE_SIZE_TYPE pow2_capacity)
 {
     assert(self);
     assert(IS_POW2(pow2_capacity));
@@ -373,20 +403,20 @@ FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, init)(FQUEUE_TYPE *self, const u
 }
 
 FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME,
-                                   create_custom)(const uint32_t min_capacity, void *context_ptr,
+                                   create_custom)(const FQUEUE_SIZE_TYPE min_capacity, void *context_ptr,
                                                   void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
 {
-    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+    if (min_capacity == 0 || min_capacity > FQUEUE_SIZE_MAX / 2 + 1) {
         return NULL;
     }
 
-    const uint32_t capacity = round_up_pow2_32(min_capacity);
+    const FQUEUE_SIZE_TYPE capacity = FQUEUE_ROUND_UP_POW2(min_capacity);
 
     if (FQUEUE_CALC_SIZEOF_OVERFLOWS(FQUEUE_NAME, capacity)) {
         return NULL;
     }
 
-    const uint32_t size = FQUEUE_CALC_SIZEOF(FQUEUE_NAME, capacity);
+    const FQUEUE_SIZE_TYPE size = FQUEUE_CALC_SIZEOF(FQUEUE_NAME, capacity);
 
     FQUEUE_TYPE *self = (FQUEUE_TYPE *)allocate(context_ptr, alignof(FQUEUE_TYPE), size);
 
@@ -409,7 +439,7 @@ static inline void *JOIN(internal, JOIN(FQUEUE_NAME, allocate))(void *context_pt
 }
 /// @endcond
 
-FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, create)(const uint32_t capacity)
+FUNCTION_LINKAGE FQUEUE_TYPE *JOIN(FQUEUE_NAME, create)(const FQUEUE_SIZE_TYPE capacity)
 {
     return JOIN(FQUEUE_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(FQUEUE_NAME, allocate)));
 }
@@ -451,12 +481,12 @@ FUNCTION_LINKAGE bool JOIN(FQUEUE_NAME, is_full)(const FQUEUE_TYPE *self)
     return self->count == self->capacity;
 }
 
-FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, at)(const FQUEUE_TYPE *self, const uint32_t index)
+FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, at)(const FQUEUE_TYPE *self, const FQUEUE_SIZE_TYPE index)
 {
     assert(self != NULL);
     assert(index < self->count);
 
-    const uint32_t index_mask = (self->capacity - 1);
+    const FQUEUE_SIZE_TYPE index_mask = (self->capacity - 1);
 
     return self->values[(self->begin_index + index) & index_mask];
 }
@@ -474,7 +504,7 @@ FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, get_back)(const FQUEUE_TYPE *self)
     assert(self != NULL);
     assert(!FQUEUE_IS_EMPTY(self));
 
-    const uint32_t index_mask = (self->capacity - 1);
+    const FQUEUE_SIZE_TYPE index_mask = (self->capacity - 1);
 
     return self->values[(self->end_index - 1) & index_mask];
 }
@@ -489,7 +519,7 @@ FUNCTION_LINKAGE bool JOIN(FQUEUE_NAME, enqueue)(FQUEUE_TYPE *self, const VALUE_
     assert(self != NULL);
     assert(!FQUEUE_IS_FULL(self));
 
-    const uint32_t index_mask = (self->capacity - 1);
+    const FQUEUE_SIZE_TYPE index_mask = (self->capacity - 1);
 
     self->values[self->end_index] = value;
     self->end_index++;
@@ -504,7 +534,7 @@ FUNCTION_LINKAGE VALUE_TYPE JOIN(FQUEUE_NAME, dequeue)(FQUEUE_TYPE *self)
     assert(self != NULL);
     assert(!FQUEUE_IS_EMPTY(self));
 
-    const uint32_t index_mask = (self->capacity - 1);
+    const FQUEUE_SIZE_TYPE index_mask = (self->capacity - 1);
 
     const VALUE_TYPE value = self->values[self->begin_index];
     self->begin_index++;
@@ -529,10 +559,10 @@ FUNCTION_LINKAGE void JOIN(FQUEUE_NAME, copy)(FQUEUE_TYPE *restrict dest_ptr, co
     assert(src_ptr->count <= dest_ptr->capacity);
     assert(FQUEUE_IS_EMPTY(dest_ptr));
 
-    const uint32_t src_begin_index = src_ptr->begin_index;
-    const uint32_t src_index_mask = src_ptr->capacity - 1;
+    const FQUEUE_SIZE_TYPE src_begin_index = src_ptr->begin_index;
+    const FQUEUE_SIZE_TYPE src_index_mask = src_ptr->capacity - 1;
 
-    for (uint32_t i = 0; i < src_ptr->count; i++) {
+    for (FQUEUE_SIZE_TYPE i = 0; i < src_ptr->count; i++) {
         dest_ptr->values[i] = src_ptr->values[(src_begin_index + i) & src_index_mask];
     }
 
@@ -549,13 +579,18 @@ FUNCTION_LINKAGE void JOIN(FQUEUE_NAME, copy)(FQUEUE_TYPE *restrict dest_ptr, co
 
 #undef NAME
 #undef VALUE_TYPE
+#undef FQUEUE_LARGE_CAPACITY
 #undef FUNCTION_LINKAGE
 #undef FUNCTION_DEFINITIONS
 #undef TYPE_DEFINITIONS
 
 #undef FQUEUE_NAME
 #undef FQUEUE_TYPE
+#undef FQUEUE_SIZE_TYPE
+#undef FQUEUE_SIZE_MAX
+#undef FQUEUE_ROUND_UP_POW2
 #undef FQUEUE_CALC_SIZEOF
+#undef FQUEUE_CALC_SIZEOF_OVERFLOWS
 #undef FQUEUE_INIT
 #undef FQUEUE_IS_EMPTY
 #undef FQUEUE_IS_FULL
@@ -26,6 +26,10 @@
     - create
     - destroy
     - copy
+
+    FQUEUE_LARGE_CAPACITY:
+    - N := 10
+    - N := UINT32_MAX + 2 (only the requested allocation size is checked)
 */
 
 #define NAME       i64_que
@@ -35,6 +39,24 @@
 #define FUNCTION_LINKAGE static inline
 #include "fqueue_template.h"
 
+#define NAME       i64_large_que
+#define VALUE_TYPE int64_t
+#define FQUEUE_LARGE_CAPACITY
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fqueue_template.h"
+
+static size_t requested_size;
+
+static void *record_size_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    requested_size = size;
+    return NULL;
+}
+
 static inline bool check_count_invariance(const struct i64_que *que_p, const size_t enqueue_op_count,
                                           const size_t dequeue_op_count)
 {
@@ -365,4 +387,52 @@ int main(void)
 
         i64_que_destroy(que_p);
     }
+    // FQUEUE_LARGE_CAPACITY: N = 10, enqueue * 10 -> dequeue * 5 -> enqueue * 5 (wraps around)
+    {
+        struct i64_large_que *que_p = i64_large_que_create(10);
+        if (!que_p) {
+            assert(false);
+        }
+        assert(que_p->capacity == 16);
+        for (int64_t i = 0; i < 10; i++) {
+            i64_large_que_enqueue(que_p, 420 + i);
+        }
+        for (int64_t i = 0; i < 5; i++) {
+            assert(i64_large_que_dequeue(que_p) == 420 + i);
+        }
+        for (int64_t i = 10; i < 15; i++) {
+            i64_large_que_enqueue(que_p, 420 + i);
+        }
+        assert(que_p->count == 10);
+        assert(i64_large_que_get_front(que_p) == 425 && i64_large_que_get_back(que_p) == 434);
+
+        struct i64_large_que *que_copy_p = i64_large_que_create(10);
+        if (!que_copy_p) {
+            assert(false);
+        }
+        i64_large_que_copy(que_copy_p, que_p);
+
+        size_t index;
+        int64_t value;
+        FQUEUE_FOR_EACH(que_copy_p, index, value)
+        {
+            assert(value == 425 + (int64_t)index);
+            assert(i64_large_que_at(que_p, index) == value);
+        }
+
+        i64_large_que_destroy(que_copy_p);
+        i64_large_que_destroy(que_p);
+    }
+    // FQUEUE_LARGE_CAPACITY: N = UINT32_MAX + 2
+    {
+        requested_size = 0;
+        assert(i64_que_create_custom(UINT32_MAX / 2 + 1, NULL, record_size_allocate) == NULL);
+        assert(requested_size == 0);
+
+        if (SIZE_MAX > UINT32_MAX) {
+            const size_t min_capacity = (size_t)UINT32_MAX + 2;
+            assert(i64_large_que_create_custom(min_capacity, NULL, record_size_allocate) == NULL);
+            assert(requested_size >= 2 * ((size_t)UINT32_MAX + 1) * sizeof(int64_t));
+        }
+    }
 }
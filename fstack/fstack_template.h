@@ -57,7 +57,8 @@ extern "C" {
  * @warning Modifying the stack under the iteration may result in errors.
  *
  * @param[in] self              Stack pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FSTACK_LARGE_CAPACITY`).
  * @param[out] value            Current value. Should be `VALUE_TYPE`.
  */
 #ifndef FSTACK_FOR_EACH
@@ -72,7 +73,8 @@ extern "C" {
  * @warning Modifying the stack under the iteration may result in errors.
  *
  * @param[in] self              Stack pointer.
- * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t` (`size_t` with
+ *                              `FSTACK_LARGE_CAPACITY`).
  * @param[out] value            Current value. Should be `VALUE_TYPE`.
  */
 #ifndef FSTACK_FOR_EACH_REVERSE
@@ -92,7 +94,7 @@ extern "C" {
  */
 #ifndef FSTACK_CALC_SIZEOF
 #define FSTACK_CALC_SIZEOF(fstack_name, capacity) \
-    (uint32_t)(offsetof(struct fstack_name, values) + capacity * sizeof(((struct fstack_name *)0)->values[0]))
+    (FSTACK_SIZE_TYPE)(offsetof(struct fstack_name, values) + capacity * sizeof(((struct fstack_name *)0)->values[0]))
 #endif
 
 /**
@@ -107,7 +109,7 @@ extern "C" {
  */
 #ifndef FSTACK_CALC_SIZEOF_OVERFLOWS
 #define FSTACK_CALC_SIZEOF_OVERFLOWS(fstack_name, capacity) \
-    (capacity > (UINT32_MAX - offsetof(struct fstack_name, values)) / sizeof(((struct fstack_name *)0)->values[0]))
+    (capacity > (FSTACK_SIZE_MAX - offsetof(struct fstack_name, values)) / sizeof(((struct fstack_name *)0)->values[0]))
 #endif
 
 /**
@@ -145,7 +147,27 @@ extern "C" {
 #define FUNCTION_LINKAGE
 #endif
 
+/**
+ * @def FSTACK_LARGE_CAPACITY
+ * @brief Use `size_t` for the count, capacity and indices instead of `uint32_t`.
+ *
+ * Lifts the limit of `UINT32_MAX` values and the limit on the size of the
+ * stack struct in bytes, at the cost of larger header fields.
+ *
+ * Is undefined after header is included.
+ */
+#ifdef FSTACK_LARGE_CAPACITY
+#endif
+
 /// @cond DO_NOT_DOCUMENT
+#ifdef FSTACK_LARGE_CAPACITY
+#define FSTACK_SIZE_TYPE size_t
+#define FSTACK_SIZE_MAX  SIZE_MAX
+#else
+#define FSTACK_SIZE_TYPE uint32_t
+#define FSTACK_SIZE_MAX  UINT32_MAX
+#endif
+
 #define FSTACK_TYPE     struct FSTACK_NAME
 #define FSTACK_IS_EMPTY JOIN(FSTACK_NAME, is_empty)
 #define FSTACK_IS_FULL  JOIN(FSTACK_NAME, is_full)
@@ -168,9 +190,9 @@ struct FSTACK_NAME;
  * @brief Generated stack struct type for a given `VALUE_TYPE`.
  */
 struct FSTACK_NAME {
-    uint32_t count;      ///< number of values.
-    uint32_t capacity;   ///< maximum number of values allocated for.
-    VALUE_TYPE values[]; ///< array of values.
+    FSTACK_SIZE_TYPE count;    ///< number of values.
+    FSTACK_SIZE_TYPE capacity; ///< maximum number of values allocated for.
+    VALUE_TYPE values[];       ///< array of values.
 };
 
 #endif
@@ -185,7 +207,7 @@ struct FSTACK_NAME {
  * @param[in] self              Stack pointer
  * @param[in] capacity          Capacity
  */
-FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const uint32_t capacity);
+FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const FSTACK_SIZE_TYPE capacity);
 
 /**
  * @brief Create an stack struct with a given capacity with custom allocator.
@@ -200,7 +222,7 @@ FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const u
  *   @li                        If allocate returns NULL.
  */
 FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME,
-                                   create_custom)(const uint32_t capacity, void *context_ptr,
+                                   create_custom)(const FSTACK_SIZE_TYPE capacity, void *context_ptr,
                                                   void *(*allocate)(void *context_ptr, size_t alignment, size_t size));
 
 /**
@@ -213,7 +235,7 @@ FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME,
  *   @li                        If capacity is 0 or the equivalent size overflows
  *   @li                        If malloc fails.
  */
-FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, create)(const uint32_t capacity);
+FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, create)(const FSTACK_SIZE_TYPE capacity);
 
 /**
  * @brief Destroy an stack struct and free the underlying memory with custom allocator
@@ -263,7 +285,7 @@ FUNCTION_LINKAGE bool JOIN(FSTACK_NAME, is_full)(const FSTACK_TYPE *self);
  *
  * @return                      The value at `index`.
  */
-FUNCTION_LINKAGE VALUE_TYPE JOIN(FSTACK_NAME, at)(const FSTACK_TYPE *self, const uint32_t index);
+FUNCTION_LINKAGE VALUE_TYPE JOIN(FSTACK_NAME, at)(const FSTACK_TYPE *self, const FSTACK_SIZE_TYPE index);
 
 /**
  * @brief Get the value from the top of a non-empty stack.
@@ -339,7 +361,7 @@ FUNCTION_LINKAGE void JOIN(FSTACK_NAME, copy)(FSTACK_TYPE *restrict dest_ptr, co
 #include <stdlib.h>
 #include <string.h>
 
-FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const uint32_t capacity)
+FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const FSTACK_SIZE_TYPE capacity)
 {
     assert(self);
 
@@ -350,14 +372,14 @@ FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, init)(FSTACK_TYPE *self, const u
 }
 
 FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME,
-                                   create_custom)(const uint32_t capacity, void *context_ptr,
+                                   create_custom)(const FSTACK_SIZE_TYPE capacity, void *context_ptr,
                                                   void *(*allocate)(void *context_ptr, size_t alignment, size_t size))
 {
     if (capacity == 0 || FSTACK_CALC_SIZEOF_OVERFLOWS(FSTACK_NAME, capacity)) {
         return NULL;
     }
 
-    const uint32_t size = FSTACK_CALC_SIZEOF(FSTACK_NAME, capacity);
+    const FSTACK_SIZE_TYPE size = FSTACK_CALC_SIZEOF(FSTACK_NAME, capacity);
 
     FSTACK_TYPE *self = (FSTACK_TYPE *)allocate(context_ptr, alignof(FSTACK_TYPE), size);
 
@@ -380,7 +402,7 @@ static inline void *JOIN(internal, JOIN(FSTACK_NAME, allocate))(void *context_pt
 }
 /// @endcond
 
-FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, create)(const uint32_t capacity)
+FUNCTION_LINKAGE FSTACK_TYPE *JOIN(FSTACK_NAME, create)(const FSTACK_SIZE_TYPE capacity)
 {
     return JOIN(FSTACK_NAME, create_custom)(capacity, NULL, JOIN(internal, JOIN(FSTACK_NAME, allocate)));
 }
@@ -422,7 +444,7 @@ FUNCTION_LINKAGE bool JOIN(FSTACK_NAME, is_full)(const FSTACK_TYPE *self)
     return self->count == self->capacity;
 }
 
-FUNCTION_LINKAGE VALUE_TYPE JOIN(FSTACK_NAME, at)(const FSTACK_TYPE *self, const uint32_t index)
+FUNCTION_LINKAGE VALUE_TYPE JOIN(FSTACK_NAME, at)(const FSTACK_TYPE *self, const FSTACK_SIZE_TYPE index)
 {
     assert(self != NULL);
     assert(index < self->count);
@@ -480,7 +502,7 @@ FUNCTION_LINKAGE void JOIN(FSTACK_NAME, copy)(FSTACK_TYPE *restrict dest_ptr, co
     assert(src_ptr->count <= dest_ptr->capacity);
     assert(FSTACK_IS_EMPTY(dest_ptr));
 
-    for (uint32_t i = 0; i < src_ptr->count; i++) {
+    for (FSTACK_SIZE_TYPE i = 0; i < src_ptr->count; i++) {
         dest_ptr->values[i] = src_ptr->values[i];
     }
     dest_ptr->count = src_ptr->count;
@@ -493,6 +515,7 @@ FUNCTION_LINKAGE void JOIN(FSTACK_NAME, copy)(FSTACK_TYPE *restrict dest_ptr, co
 // macro undefs: {{{
 #undef NAME
 #undef VALUE_TYPE
+#undef FSTACK_LARGE_CAPACITY
 #undef FUNCTION_LINKAGE
 #undef FUNCTION_DEFINITIONS
 #undef TYPE_DEFINITIONS
@@ -502,6 +525,10 @@ FUNCTION_LINKAGE void JOIN(FSTACK_NAME, copy)(FSTACK_TYPE *restrict dest_ptr, co
 #undef FSTACK_IS_EMPTY
 #undef FSTACK_IS_FULL
 #undef FSTACK_INIT
+#undef FSTACK_SIZE_TYPE
+#undef FSTACK_SIZE_MAX
+#undef FSTACK_CALC_SIZEOF
+#undef FSTACK_CALC_SIZEOF_OVERFLOWS
 
 // }}}
 
@@ -26,6 +26,10 @@
     - create
     - destroy
     - copy
+
+    FSTACK_LARGE_CAPACITY:
+    - N := 10
+    - N := UINT32_MAX + 1 (only the requested allocation size is checked)
 */
 
 #define NAME       i64_stk
@@ -35,6 +39,24 @@
 #define FUNCTION_LINKAGE static inline
 #include "fstack_template.h"
 
+#define NAME       i64_large_stk
+#define VALUE_TYPE int64_t
+#define FSTACK_LARGE_CAPACITY
+#define TYPE_DEFINITIONS
+#define FUNCTION_DEFINITIONS
+#define FUNCTION_LINKAGE static inline
+#include "fstack_template.h"
+
+static size_t requested_size;
+
+static void *record_size_allocate(void *context_ptr, size_t alignment, size_t size)
+{
+    (void)context_ptr;
+    (void)alignment;
+    requested_size = size;
+    return NULL;
+}
+
 static inline bool check_count_invariance(const struct i64_stk *stk_p, const size_t push_op_count,
                                           const size_t pop_op_count)
 {
@@ -362,4 +384,50 @@ int main(void)
 
         i64_stk_destroy(stk_p);
     }
+    // FSTACK_LARGE_CAPACITY: N = 10, push * 10 -> pop * 5
+    {
+        struct i64_large_stk *stk_p = i64_large_stk_create(10);
+        if (!stk_p) {
+            assert(false);
+        }
+        for (int64_t i = 0; i < 10; i++) {
+            i64_large_stk_push(stk_p, 420 + i);
+        }
+        for (int64_t i = 0; i < 5; i++) {
+            assert(i64_large_stk_pop(stk_p) == 429 - i);
+        }
+        assert(stk_p->count == 5);
+        assert(i64_large_stk_get_top(stk_p) == 424 && i64_large_stk_get_bottom(stk_p) == 420);
+        assert(i64_large_stk_at(stk_p, 4) == 420);
+
+        struct i64_large_stk *stk_copy_p = i64_large_stk_create(5);
+        if (!stk_copy_p) {
+            assert(false);
+        }
+        i64_large_stk_copy(stk_copy_p, stk_p);
+        assert(i64_large_stk_is_full(stk_copy_p));
+
+        size_t index;
+        int64_t value;
+        int64_t expected_value = 424;
+        FSTACK_FOR_EACH(stk_copy_p, index, value)
+        {
+            assert(value == expected_value--);
+        }
+
+        i64_large_stk_destroy(stk_copy_p);
+        i64_large_stk_destroy(stk_p);
+    }
+    // FSTACK_LARGE_CAPACITY: N = UINT32_MAX + 1
+    {
+        requested_size = 0;
+        assert(i64_stk_create_custom(UINT32_MAX / sizeof(int64_t), NULL, record_size_allocate) == NULL);
+        assert(requested_size == 0);
+
+        if (SIZE_MAX > UINT32_MAX) {
+            const size_t capacity = (size_t)UINT32_MAX + 1;
+            assert(i64_large_stk_create_custom(capacity, NULL, record_size_allocate) == NULL);
+            assert(requested_size >= capacity * sizeof(int64_t));
+        }
+    }
 }